@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+set -e
+
+# Convert a binary commit log (RV32I_Core_tb +commit_log+<path>) to Spike's
+# --log-commits text, to diff against `spike -l --log-commits` or another
+# simulator's trace.
+#   ./CommitLog.sh <log[.gz]> [out.txt]      (default: stdout)
+# The converter is rebuilt when tb/tools/commitlog2spike.cpp or
+# tb/common/commit_log.h change.
+if [ -z "$1" ]; then
+    echo "❌ Missing commit log: $0 <log[.gz]> [out.txt]"
+    exit 1
+fi
+
+BIN=obj_dir_tools/commitlog2spike
+SRC=(tb/tools/commitlog2spike.cpp tb/common/commit_log.h)
+if [ ! -x "$BIN" ] || [ -n "$(find "${SRC[@]}" -newer "$BIN")" ]; then
+    mkdir -p obj_dir_tools
+    g++ -std=c++17 -O2 -o "$BIN" tb/tools/commitlog2spike.cpp -lz >&2
+fi
+
+./"$BIN" "$@"
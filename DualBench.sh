@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+set -e
+
+# IPC of RV32I_Dual on the SimBench kernels (src/SimBench_*.mem), each run
+# to its halt in lockstep with the ISS, under three issue configurations:
+#   single       DUAL_ISSUE=0, lane 0 only (the baseline)
+#   dual-nofwd   DUAL_ISSUE=1 BUNDLE_FWD=0, dependent pairs split
+#   dual         DUAL_ISSUE=1 BUNDLE_FWD=1, lane 1 may use lane 0's ALU result
+# Each configuration is verilated once (fast profile) and runs every kernel;
+# the kernels are loaded at run time (+imem). Results are printed and
+# collected as JSON in $OUT.
+OUT="${OUT:-DualBench.json}"
+
+# kernel -> x12 at the halt
+KERNELS=(dhry crc memcpy sort fsm)
+declare -A EXPECT=(
+    [dhry]=114561
+    [crc]=2474688835
+    [memcpy]=3005214381
+    [sort]=2678645158
+    [fsm]=1141233878
+)
+VFLAGS_BASE="-GDMEM_WORDS=1024 ${VFLAGS:-}"
+
+LINES=$(mktemp)
+trap 'rm -f "$LINES"' EXIT
+
+# bench <config> [verilator flags...]
+bench() {
+    config="$1"
+    shift
+
+    echo "📦 ${config}"
+    first=1
+    for kernel in "${KERNELS[@]}"; do
+        args=(+imem+./src/SimBench_${kernel}.mem +dmem_words+1024 +expect+${EXPECT[$kernel]}
+              +kernel+${kernel} +profile+${config} +json+${LINES})
+        printf '%-8s' "$kernel"
+        if [ "$first" -eq 1 ]; then
+            VFLAGS="${VFLAGS_BASE} $*" ./Verilatte.sh RV32I_Dual fast "${args[@]}" | grep '^📊 .*IPC'
+            first=0
+        else
+            ./obj_dir_fast/VRV32I_Dual "${args[@]}" | grep '^📊 .*IPC'
+        fi
+    done
+    echo "========================================"
+}
+
+echo "🏁 IPC of RV32I_Dual"
+echo "========================================"
+
+bench single     -GDUAL_ISSUE=0
+bench dual-nofwd -GDUAL_ISSUE=1 -GBUNDLE_FWD=0
+bench dual       -GDUAL_ISSUE=1 -GBUNDLE_FWD=1
+
+{
+    printf '{\n  "date": "%s",\n  "host": "%s",\n  "verilator": "%s",\n  "results": [\n' \
+        "$(date -u +%Y-%m-%dT%H:%M:%SZ)" "$(uname -n)" "$(verilator --version | head -n 1)"
+    sed 's/^/    /; $!s/$/,/' "$LINES"
+    printf '  ]\n}\n'
+} > "$OUT"
+
+echo "✅ Results written to $OUT"
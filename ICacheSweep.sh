@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+set -e
+
+# Rebuild ICache for each configuration and print its miss-rate table.
+# Each row: SETS WAYS LINE_WORDS REPL (0 = LRU, 1 = PLRU, 2 = random)
+# Override the refill latency with LATENCY=N and the profile with PROFILE=debug.
+CONFIGS=(
+    "16 1 4 0"
+    "8 2 4 0"
+    "8 2 4 1"
+    "8 2 4 2"
+    "4 4 4 0"
+    "4 4 4 1"
+    "4 4 4 2"
+    "16 2 2 0"
+    "4 2 8 0"
+    "16 2 4 0"
+)
+LATENCY="${LATENCY:-8}"
+PROFILE="${PROFILE:-fast}"
+
+echo "🏁 Sweeping ${#CONFIGS[@]} I-cache configurations (miss latency ${LATENCY})"
+echo "========================================"
+
+for config in "${CONFIGS[@]}"; do
+    read -r sets ways line repl <<< "$config"
+    VFLAGS="-GSETS=${sets} -GWAYS=${ways} -GLINE_WORDS=${line} -GREPL=${repl} -GMISS_LATENCY=${LATENCY}" \
+        ./Verilatte.sh ICache "$PROFILE" \
+        +sets+${sets} +ways+${ways} +line+${line} +repl+${repl} +lat+${LATENCY} \
+        | sed -n '/^🧮/,/^✅/p'
+    echo "========================================"
+done
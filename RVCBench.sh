@@ -0,0 +1,31 @@
+#!/usr/bin/env bash
+set -e
+
+# Run the same program as RV32I and as RV32IC on the core built with
+# COMPRESSED=1 and compare code size, cycles and CPI. Both images must end
+# with the same x12. Each image runs without and with a small I-cache
+# (4 sets x 1 way x 4 words = 64 B), where code size turns into misses.
+# Override the profile with PROFILE=debug.
+IMAGES=(
+    "./src/RVC_Bench_rv32i.mem"
+    "./src/RVC_Bench_rv32ic.mem"
+)
+CACHES=(
+    "-GICACHE=0"
+    "-GICACHE=1 -GIC_SETS=4 -GIC_WAYS=1 -GIC_LINE_WORDS=4"
+)
+EXPECT=3739942377
+PROFILE="${PROFILE:-fast}"
+
+echo "🏁 RV32I vs RV32IC on RV32I_Core (COMPRESSED=1)"
+echo "========================================"
+
+for cache in "${CACHES[@]}"; do
+    for image in "${IMAGES[@]}"; do
+        echo "📦 ${image} ${cache}"
+        VFLAGS="-GCOMPRESSED=1 -GIMEM_INIT=\"${image}\" ${cache}" \
+            ./Verilatte.sh RV32I_Core "$PROFILE" +bench +expect+${EXPECT} \
+            | sed -n '/^📏/,/^✅/p'
+        echo "========================================"
+    done
+done
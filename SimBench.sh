@@ -0,0 +1,71 @@
+#!/usr/bin/env bash
+set -e
+
+# Simulation throughput of RV32I_Core on the SimBench kernels
+# (src/SimBench_*.mem). Each kernel runs for CYCLES cycles, restarted
+# whenever it halts, under four builds:
+#   debug-trace    debug profile, dumping a VCD every cycle (TRACE_CYCLES)
+#   debug-notrace  same build, the dump window never opens
+#   fast-1t        fast profile, single-threaded model
+#   fast-Nt        fast profile, THREADS_MT model threads
+# Each build is verilated once and runs every kernel; the kernels are loaded
+# at run time (+imem). Results are printed and collected as JSON in $OUT.
+CYCLES="${CYCLES:-5000000}"
+TRACE_CYCLES="${TRACE_CYCLES:-100000}"
+THREADS_MT="${THREADS_MT:-4}"
+OUT="${OUT:-SimBench.json}"
+
+# kernel -> x12 at the halt
+KERNELS=(dhry crc memcpy sort fsm)
+declare -A EXPECT=(
+    [dhry]=114561
+    [crc]=2474688835
+    [memcpy]=3005214381
+    [sort]=2678645158
+    [fsm]=1141233878
+)
+export VFLAGS="-GDMEM_WORDS=1024 ${VFLAGS:-}"
+
+LINES=$(mktemp)
+trap 'rm -f "$LINES"' EXIT
+
+# bench <config> <profile> <threads> <cycles> [sim args...]
+bench() {
+    config="$1" profile="$2" threads="$3" cycles="$4"
+    shift 4
+    case "$profile" in
+        debug) mdir=obj_dir ;;
+        *)     mdir=obj_dir_${profile} ;;
+    esac
+
+    echo "📦 ${config}"
+    first=1
+    for kernel in "${KERNELS[@]}"; do
+        args=(+kips+${cycles} +imem+./src/SimBench_${kernel}.mem +expect+${EXPECT[$kernel]}
+              +kernel+${kernel} +profile+${config} +json+${LINES} "$@")
+        if [ "$first" -eq 1 ]; then
+            THREADS=$threads ./Verilatte.sh RV32I_Core "$profile" "${args[@]}" | grep '^⏱️'
+            first=0
+        else
+            ./${mdir}/VRV32I_Core "${args[@]}" | grep '^⏱️'
+        fi
+    done
+    echo "========================================"
+}
+
+echo "🏁 Simulation throughput of RV32I_Core ($CYCLES cycles per kernel)"
+echo "========================================"
+
+bench debug-trace   debug 1 "$TRACE_CYCLES"
+bench debug-notrace debug 1 "$CYCLES" +trace+start_cycle+$((CYCLES + 1))
+bench fast-1t       fast  1 "$CYCLES"
+bench fast-${THREADS_MT}t fast  "$THREADS_MT" "$CYCLES"
+
+{
+    printf '{\n  "date": "%s",\n  "host": "%s",\n  "verilator": "%s",\n  "results": [\n' \
+        "$(date -u +%Y-%m-%dT%H:%M:%SZ)" "$(uname -n)" "$(verilator --version | head -n 1)"
+    sed 's/^/    /; $!s/$/,/' "$LINES"
+    printf '  ]\n}\n'
+} > "$OUT"
+
+echo "✅ Results written to $OUT"
@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+set -e
+
+# Area of one module: synthesize it with Yosys and print its cell counts.
+# Compare the memory implementations with:
+#   ./Synth.sh DataMem                         asynchronous read (LUT RAM)
+#   ./Synth.sh DataMem SYNC_READ=1             synchronous read (block RAM)
+#   ./Synth.sh InstrMem WORDS=1024 SYNC_READ=1
+# Parameters are NAME=VALUE. TARGET picks the flow: xilinx (default),
+# ice40, ecp5 or generic. Only src/<module>.sv is read, so the module must
+# not instantiate others.
+if [ -z "$1" ]; then
+    echo "Usage: $0 <module> [PARAM=VALUE ...]"
+    exit 1
+fi
+TOP="$1"
+shift
+TARGET="${TARGET:-xilinx}"
+
+if [ ! -f "src/${TOP}.sv" ]; then
+    echo "❌ src/${TOP}.sv not found"
+    exit 1
+fi
+
+CHPARAM=""
+for p in "$@"; do
+    CHPARAM="${CHPARAM}chparam -set ${p%%=*} ${p#*=} ${TOP}; "
+done
+
+case "$TARGET" in
+    generic) SYNTH="synth -top ${TOP}" ;;
+    *)       SYNTH="synth_${TARGET} -top ${TOP}" ;;
+esac
+
+echo "🔧 ${TOP} $* (${TARGET})"
+yosys -q -p "read_verilog -sv src/${TOP}.sv; ${CHPARAM}${SYNTH}; tee -o /dev/stdout stat"
@@ -2,17 +2,87 @@
 set -e
 
 if [ -z "$1" ]; then
-    echo "❌ Missing test component: $0 <test_component>"
+    echo "❌ Missing test component: $0 <test_component> [debug|fst|fast|pgo] [sim args...]"
     exit 1
 fi
 
 TEST="$1"
+PROFILE="${2:-debug}"
+[ $# -ge 2 ] && shift 2 || shift 1
 
-echo "🔧 Verilating $TEST..."
-verilator -I./src -f verilator.f ./src/${TEST}.sv tb/${TEST}_tb.cpp
+# Worker threads for the fast/pgo models (override with THREADS=N)
+THREADS="${THREADS:-2}"
+OPT_FAST="-O3 -march=native"
+# Extra Verilator flags, e.g. VFLAGS="-GBPRED=1" to override top-level parameters
+VFLAGS="${VFLAGS:-}"
 
-echo "🛠️  Compiling C++ simulation..."
-make -C obj_dir -f V${TEST}.mk V${TEST}
+case "$PROFILE" in
+    debug)
+        echo "🔧 Verilating $TEST..."
+        verilator -I./src -f verilator.f ${VFLAGS} ./src/${TEST}.sv tb/${TEST}_tb.cpp
 
-echo "🚀 Running simulation..."
-./obj_dir/V${TEST}
+        echo "🛠️  Compiling C++ simulation..."
+        make -C obj_dir -f V${TEST}.mk V${TEST}
+
+        echo "🚀 Running simulation..."
+        ./obj_dir/V${TEST} "$@"
+        ;;
+
+    fst)
+        # Debug build with compressed FST waveforms instead of VCD
+        MDIR=obj_dir_fst
+        echo "🔧 Verilating $TEST (FST tracing)..."
+        verilator -I./src -f verilator.f ${VFLAGS} --trace-fst --Mdir ${MDIR} \
+            ./src/${TEST}.sv tb/${TEST}_tb.cpp
+
+        echo "🛠️  Compiling C++ simulation..."
+        make -C ${MDIR} -f V${TEST}.mk V${TEST}
+
+        echo "🚀 Running simulation..."
+        ./${MDIR}/V${TEST} "$@"
+        ;;
+
+    fast)
+        MDIR=obj_dir_fast
+        echo "🔧 Verilating $TEST (fast, $THREADS threads)..."
+        verilator -I./src -f verilator_fast.f ${VFLAGS} --threads ${THREADS} --Mdir ${MDIR} \
+            ./src/${TEST}.sv tb/${TEST}_tb.cpp
+
+        echo "🛠️  Compiling C++ simulation..."
+        make -C ${MDIR} -f V${TEST}.mk V${TEST} OPT_FAST="${OPT_FAST}"
+
+        echo "🚀 Running simulation..."
+        ./${MDIR}/V${TEST} "$@"
+        ;;
+
+    pgo)
+        # Two-pass build: Verilator thread-schedule PGO (--prof-pgo -> profile.vlt)
+        # combined with GCC -fprofile-generate/-fprofile-use on the model.
+        MDIR=obj_dir_pgo
+        rm -rf ${MDIR}
+
+        echo "🔧 Verilating $TEST (pgo pass 1: instrumented)..."
+        verilator -I./src -f verilator_fast.f ${VFLAGS} --threads ${THREADS} --Mdir ${MDIR} --prof-pgo \
+            -CFLAGS -fprofile-generate -LDFLAGS -fprofile-generate \
+            ./src/${TEST}.sv tb/${TEST}_tb.cpp
+        make -C ${MDIR} -f V${TEST}.mk V${TEST} OPT_FAST="${OPT_FAST}"
+
+        echo "📈 Collecting profile..."
+        ./${MDIR}/V${TEST} +verilator+prof+vlt+file+${MDIR}/profile.vlt "$@"
+
+        echo "🔧 Verilating $TEST (pgo pass 2: optimised)..."
+        rm -f ${MDIR}/*.o ${MDIR}/V${TEST}
+        verilator -I./src -f verilator_fast.f ${VFLAGS} --threads ${THREADS} --Mdir ${MDIR} \
+            -CFLAGS "-fprofile-use -fprofile-correction -Wno-missing-profile" \
+            ./src/${TEST}.sv tb/${TEST}_tb.cpp ${MDIR}/profile.vlt
+        make -C ${MDIR} -f V${TEST}.mk V${TEST} OPT_FAST="${OPT_FAST}"
+
+        echo "🚀 Running simulation..."
+        ./${MDIR}/V${TEST} "$@"
+        ;;
+
+    *)
+        echo "❌ Unknown profile '$PROFILE' (expected debug, fst, fast or pgo)"
+        exit 1
+        ;;
+esac
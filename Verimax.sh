@@ -1,11 +1,72 @@
 #!/usr/bin/env bash
 set -e
 
+# Build and run the testbench of every module in src/, several at a time.
+#   ./Verimax.sh [modules to skip...]
+# Each module keeps its own Verilated build in obj_dir_all/<module>. It is only
+# re-verilated when the sources, its testbench, tb/common, verilator.f or
+# VFLAGS change, so a rerun just runs the simulations.
+#   JOBS=N      modules built/run at once (default: nproc)
+#   SEED=N      base seed for the randomized testbenches (+seed+N)
+#   SHARDS=N    threads per randomized testbench (+shards+N)
+#   VFLAGS=...  extra Verilator flags, as for Verilatte.sh
+# A module can also run in other configurations (CONFIGS below), each one a
+# separate entry "<module>:<config>" with its own build in
+# obj_dir_all/<module>_<config>.
+
 # Read arguments into an array of modules to skip
-# This syntax requires bash, hence the shebang change
 skip_modules=("$@")
 
-echo "🏁 Starting batch verification of all SV modules"
+export OUT=obj_dir_all
+export VFLAGS="${VFLAGS:-}"
+export SIM_ARGS="${SEED:++seed+$SEED} ${SHARDS:++shards+$SHARDS}"
+JOBS="${JOBS:-$(nproc)}"
+
+# Extra configurations, run as well as the module's default build
+CONFIGS=(
+    CSRFile:traps       # trap CSRs, MRET and irq pending/vectoring
+)
+
+# Verilator flags and plusargs of "<module>:<config>" (none for a plain module)
+config_args() {
+    case "$1" in
+        CSRFile:traps) cfg_vflags="-GTRAPS=1"; cfg_args="+traps" ;;
+        *)             cfg_vflags="";          cfg_args="" ;;
+    esac
+}
+export -f config_args
+
+# Build (if stale) and run one module or configuration; prints a single result line
+verify_module() {
+    entry="$1"
+    module="${entry%%:*}"
+    mdir="$OUT/${entry/:/_}"
+    mkdir -p "$mdir"
+    config_args "$entry"
+    flags="$VFLAGS $cfg_vflags"
+
+    stamp=$( (cat src/*.sv "tb/${module}_tb.cpp" tb/common/* verilator.f; echo "$flags") | sha1sum | cut -d' ' -f1)
+    if [ ! -x "$mdir/V$module" ] || [ "$(cat "$mdir/stamp" 2>/dev/null)" != "$stamp" ]; then
+        if ! { verilator -I./src -f verilator.f ${flags} --Mdir "$mdir" "./src/$module.sv" "tb/${module}_tb.cpp" &&
+               make -C "$mdir" -f "V$module.mk" "V$module"; } > "$mdir/build.log" 2>&1; then
+            printf '❌ %s: build failed (%s/build.log)\n' "$entry" "$mdir"
+            return 1
+        fi
+        echo "$stamp" > "$mdir/stamp"
+    fi
+
+    # Harness testbenches end with one summary line; older ones with "✅ All ..."
+    if "./$mdir/V$module" ${SIM_ARGS} ${cfg_args} > "$mdir/run.log" 2>&1; then
+        summary=$(grep '✅' "$mdir/run.log" | tail -n 1)
+        printf '%s\n' "${summary:-✅ $entry: passed}"
+    else
+        printf '❌ %s: failed (%s/run.log)\n%s\n' "$entry" "$mdir" "$(grep -v '✅' "$mdir/run.log" | tail -n 5)"
+        return 1
+    fi
+}
+export -f verify_module
+
+echo "🏁 Starting batch verification of all SV modules ($JOBS jobs)"
 echo "========================================"
 # Display skipped modules, handling the case where none are skipped
 if [ ${#skip_modules[@]} -eq 0 ]; then
@@ -13,30 +74,48 @@ if [ ${#skip_modules[@]} -eq 0 ]; then
 else
     echo "Skipping modules: ${skip_modules[*]}"
 fi
-echo "========================================\n"
-
+echo "========================================"
 
+modules=()
 for file in src/*.sv; do
     module=$(basename "$file" .sv)
-    
+
     should_skip=0 # Flag to indicate if the current module should be skipped
     for skip_module in "${skip_modules[@]}"; do
         if [ "$module" = "$skip_module" ]; then
-            echo "⏭️ Skipping module: $module (as requested)"
             should_skip=1
             break # Exit the inner loop as we found a match
         fi
     done
 
-    if [ "$should_skip" -eq 1 ]; then
-        echo "========================================"
-        continue
+    if [ "$should_skip" -eq 0 ] && [ ! -f "tb/${module}_tb.cpp" ]; then
+        echo "⏭️ Skipping module: $module (no testbench)"
+        should_skip=1
+    fi
+    if [ "$should_skip" -eq 0 ]; then
+        modules+=("$module")
     fi
+done
 
-    echo "🔍 Processing module: $module"
-    echo "------------------------------"
-    ./Verilatte.sh "$module"
-    echo "========================================"
+# Configurations of the modules that run
+for config in "${CONFIGS[@]}"; do
+    for module in "${modules[@]}"; do
+        if [ "$module" = "${config%%:*}" ]; then
+            modules+=("$config")
+            break
+        fi
+    done
 done
 
-echo "✅ All non-skipped modules verified"
\ No newline at end of file
+mkdir -p VCD "$OUT"
+SECONDS=0
+status=0
+printf '%s\n' "${modules[@]}" | xargs -P "$JOBS" -I{} bash -c 'verify_module "$1"' _ {} || status=$?
+
+echo "========================================"
+if [ "$status" -eq 0 ]; then
+    echo "✅ All ${#modules[@]} non-skipped modules and configurations verified in ${SECONDS}s"
+else
+    echo "❌ Some modules failed (logs in $OUT/<module>/)"
+    exit 1
+fi
@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+set -e
+
+# Run the same kernel written for RV32I and with Zba/Zbb/Zbs
+# (src/ZbBench_*.mem) on RV32I_Core and compare instruction counts and
+# cycles. Both images must end with the same x12. The core is verilated once
+# and the images are loaded at run time (+imem). Override the profile with
+# PROFILE=debug.
+IMAGES=(rv32i zb)
+EXPECT=978484349
+PROFILE="${PROFILE:-fast}"
+export VFLAGS="-GDMEM_WORDS=1024 ${VFLAGS:-}"
+
+case "$PROFILE" in
+    debug) mdir=obj_dir ;;
+    *)     mdir=obj_dir_${PROFILE} ;;
+esac
+
+echo "🏁 RV32I vs Zba/Zbb/Zbs on RV32I_Core"
+echo "========================================"
+
+declare -A INSTRET
+first=1
+for image in "${IMAGES[@]}"; do
+    echo "📦 ./src/ZbBench_${image}.mem"
+    args=(+bench +imem+./src/ZbBench_${image}.mem +expect+${EXPECT})
+    if [ "$first" -eq 1 ]; then
+        out=$(./Verilatte.sh RV32I_Core "$PROFILE" "${args[@]}")
+        first=0
+    else
+        out=$(./${mdir}/VRV32I_Core "${args[@]}")
+    fi
+    echo "$out" | sed -n '/^📏/,/^✅/p'
+    INSTRET[$image]=$(echo "$out" | sed -n 's/^📊 cycles: [0-9]*  instret: \([0-9]*\).*/\1/p')
+    echo "========================================"
+done
+
+echo "📉 Zb retires $(awk "BEGIN { printf \"%.1f%%\", 100 * (1 - ${INSTRET[zb]} / ${INSTRET[rv32i]}) }") fewer instructions"
@@ -1,27 +1,72 @@
 module ALU (
     input logic [31:0] src1, src2,
 
-    // 4 bits for 16 ALU functions
-    input logic [3:0] alu_ctrl,
+    // 6 bits: RV32I, then Zba/Zbb/Zbs
+    input logic [5:0] alu_ctrl,
 
     output logic [31:0] result
 );
 
-    typedef enum logic [3:0] {
-        ADD  = 4'b0000,
-        SUB  = 4'b0001,
-        XOR  = 4'b0010,
-        OR   = 4'b0011,
-        AND  = 4'b0100,
-        SLL  = 4'b0101,
-        SRL  = 4'b0110,
-        SRA  = 4'b0111,
-        SLT  = 4'b1000,
-        SLTU = 4'b1001,
-        JALR = 4'b1010,
-        THRU = 4'b1111
+    typedef enum logic [5:0] {
+        ADD  = 6'b000000,
+        SUB  = 6'b000001,
+        XOR  = 6'b000010,
+        OR   = 6'b000011,
+        AND  = 6'b000100,
+        SLL  = 6'b000101,
+        SRL  = 6'b000110,
+        SRA  = 6'b000111,
+        SLT  = 6'b001000,
+        SLTU = 6'b001001,
+        JALR = 6'b001010,
+        THRU = 6'b001111,
+
+        // Zba
+        SH1ADD = 6'b010000,
+        SH2ADD = 6'b010001,
+        SH3ADD = 6'b010010,
+        // Zbb (unary ops read src1 only)
+        ANDN  = 6'b010011,
+        ORN   = 6'b010100,
+        XNOR  = 6'b010101,
+        CLZ   = 6'b010110,
+        CTZ   = 6'b010111,
+        CPOP  = 6'b011000,
+        MIN   = 6'b011001,
+        MAX   = 6'b011010,
+        MINU  = 6'b011011,
+        MAXU  = 6'b011100,
+        SEXTB = 6'b011101,
+        SEXTH = 6'b011110,
+        ZEXTH = 6'b011111,
+        REV8  = 6'b100000,
+        ORCB  = 6'b100001,
+        ROL   = 6'b100010,
+        ROR   = 6'b100011,
+        // Zbs: bit index in src2[4:0]
+        BCLR  = 6'b100100,
+        BSET  = 6'b100101,
+        BINV  = 6'b100110,
+        BEXT  = 6'b100111
     } alu_codes; 
-    
+
+    // Leading/trailing zeros, 32 for zero
+    function automatic logic [31:0] clz(input logic [31:0] x);
+        clz = 32'd32;
+        for (int i = 0; i < 32; i++)
+            if (x[i]) clz = 32'(31 - i);
+    endfunction
+
+    function automatic logic [31:0] ctz(input logic [31:0] x);
+        ctz = 32'd32;
+        for (int i = 31; i >= 0; i--)
+            if (x[i]) ctz = 32'(i);
+    endfunction
+
+    logic [5:0]  rot;       // 32 - shamt: shifting by 32 gives 0
+    logic [31:0] bit_sel;
+    assign rot     = 6'd32 - {1'b0, src2[4:0]};
+    assign bit_sel = 32'b1 << src2[4:0];
 
     always_comb begin
         case (alu_ctrl)
@@ -37,6 +82,33 @@ module ALU (
             SLTU: result = {31'b0, src1 < src2};
             JALR: result = (src1 + src2) & ~1;
             THRU: result = src2;
+
+            SH1ADD: result = (src1 << 1) + src2;
+            SH2ADD: result = (src1 << 2) + src2;
+            SH3ADD: result = (src1 << 3) + src2;
+
+            ANDN : result = src1 & ~src2;
+            ORN  : result = src1 | ~src2;
+            XNOR : result = ~(src1 ^ src2);
+            CLZ  : result = clz(src1);
+            CTZ  : result = ctz(src1);
+            CPOP : result = 32'($countones(src1));
+            MIN  : result = $signed(src1) < $signed(src2) ? src1 : src2;
+            MAX  : result = $signed(src1) < $signed(src2) ? src2 : src1;
+            MINU : result = src1 < src2 ? src1 : src2;
+            MAXU : result = src1 < src2 ? src2 : src1;
+            SEXTB: result = {{24{src1[7]}}, src1[7:0]};
+            SEXTH: result = {{16{src1[15]}}, src1[15:0]};
+            ZEXTH: result = {16'b0, src1[15:0]};
+            REV8 : result = {src1[7:0], src1[15:8], src1[23:16], src1[31:24]};
+            ORCB : result = {{8{|src1[31:24]}}, {8{|src1[23:16]}}, {8{|src1[15:8]}}, {8{|src1[7:0]}}};
+            ROL  : result = (src1 << src2[4:0]) | (src1 >> rot);
+            ROR  : result = (src1 >> src2[4:0]) | (src1 << rot);
+
+            BCLR : result = src1 & ~bit_sel;
+            BSET : result = src1 | bit_sel;
+            BINV : result = src1 ^ bit_sel;
+            BEXT : result = {31'b0, src1[src2[4:0]]};
             default: result = 32'd0;
         endcase
     end
@@ -0,0 +1,195 @@
+// Dynamic branch predictor: BTB + 2-bit counter BHT (gshare or bimodal) + RAS.
+//
+// The fetch stage looks up `pc` and gets the predicted next-fetch target.
+// The stage that resolves control flow reports each valid instruction on the
+// upd_* port, along with whether the host mispredicted it.
+//
+// Calls and returns are recognised with the link-register hints from the
+// RISC-V spec (x1/x5 = link):
+//   rd link, rs1 not link          -> push
+//   rd not link, rs1 link          -> pop
+//   rd link, rs1 link, rd != rs1   -> pop, then push
+//   rd link, rs1 link, rd == rs1   -> push
+// The RAS and global history are updated at resolve, not speculatively.
+// The history a branch was predicted with leaves on pred_ghr; the host
+// carries it down the pipe with the instruction and returns it on upd_ghr,
+// so the BHT trains the counter it predicted with even when older branches
+// resolve (and shift the history) in between.
+//
+// With COMPRESSED = 1 the PCs are halfword aligned: the BTB and BHT are
+// indexed from pc[1] up, so two instructions in one word do not alias, and
+// a call pushes its own fall-through PC (upd_seq_pc: pc + 2 after a
+// compressed call).
+//
+// BTB_ENTRIES, BHT_ENTRIES and RAS_DEPTH must be powers of two, at least 2.
+
+module BranchPredictor #(
+    parameter BTB_ENTRIES = 16,
+    parameter BHT_ENTRIES = 64,
+    parameter GHR_BITS    = 6,     // gshare history length; 0 = bimodal
+    parameter RAS_DEPTH   = 4,
+    parameter COMPRESSED  = 0      // 1: halfword PCs (RV32C)
+) (
+    input  logic        clk, rst,
+
+    // Prediction (fetch)
+    input  logic [31:0] pc,
+    output logic        pred_taken,
+    output logic [31:0] pred_target,
+    output logic [(GHR_BITS > 0 ? GHR_BITS : 1)-1:0] pred_ghr,     // history used; travels with the instruction
+
+    // Update (resolve)
+    input  logic        upd_valid,
+    input  logic [31:0] upd_pc,
+    input  logic [31:0] upd_seq_pc,     // the PC after it: the return address of a call
+    /* verilator lint_off UNUSEDSIGNAL */
+    input  logic [31:0] upd_instr,
+    /* verilator lint_on UNUSEDSIGNAL */
+    input  logic        upd_taken,
+    input  logic [31:0] upd_target,
+    input  logic [(GHR_BITS > 0 ? GHR_BITS : 1)-1:0] upd_ghr,      // pred_ghr from this instruction's fetch
+    input  logic        upd_mispredict,
+
+    // Accuracy counters
+    output logic [31:0] stat_branches,
+    output logic [31:0] stat_branch_miss,
+    output logic [31:0] stat_jumps,
+    output logic [31:0] stat_jump_miss
+);
+    localparam BTB_IDX  = $clog2(BTB_ENTRIES);
+    localparam BHT_IDX  = $clog2(BHT_ENTRIES);
+    localparam RAS_IDX  = $clog2(RAS_DEPTH);
+    localparam PC_LO    = COMPRESSED ? 1 : 2;     // lowest PC bit that tells instructions apart
+    localparam TAG_BITS = 32 - PC_LO - BTB_IDX;
+    localparam GHR_W    = (GHR_BITS > 0) ? GHR_BITS : 1;
+
+    typedef enum logic [1:0] {
+        T_BRANCH = 2'd0,
+        T_JUMP   = 2'd1,    // JAL, JALR (including calls)
+        T_RET    = 2'd2
+    } btb_kinds;
+
+    localparam OP_B    = 7'b1100011;
+    localparam OP_JAL  = 7'b1101111;
+    localparam OP_JALR = 7'b1100111;
+
+    logic                btb_valid  [0:BTB_ENTRIES-1];
+    logic [TAG_BITS-1:0] btb_tag    [0:BTB_ENTRIES-1];
+    logic [31:0]         btb_target [0:BTB_ENTRIES-1];
+    logic [1:0]          btb_kind   [0:BTB_ENTRIES-1];
+    logic [1:0]          bht        [0:BHT_ENTRIES-1];
+    logic [31:0]         ras        [0:RAS_DEPTH-1];
+    logic [RAS_IDX-1:0]  ras_top;
+    logic [RAS_IDX:0]    ras_count;
+    logic [GHR_W-1:0]    ghr;
+
+    // gshare: PC bits XOR global history. With GHR_BITS = 0 the history
+    // stays zero and this is a plain bimodal table.
+    function automatic logic [BHT_IDX-1:0] bht_index(input logic [31:0] addr, input logic [GHR_W-1:0] hist);
+        bht_index = addr[BHT_IDX+PC_LO-1:PC_LO] ^ BHT_IDX'(hist);
+    endfunction
+
+    // ==================================
+    // PREDICT
+    // ==================================
+    logic [BTB_IDX-1:0] p_idx;
+    logic               p_hit;
+
+    always_comb begin
+        p_idx       = pc[BTB_IDX+PC_LO-1:PC_LO];
+        p_hit       = btb_valid[p_idx] && btb_tag[p_idx] == pc[31:BTB_IDX+PC_LO];
+        pred_taken  = 1'b0;
+        pred_target = btb_target[p_idx];
+        pred_ghr    = ghr;
+
+        if (p_hit) begin
+            case (btb_kind[p_idx])
+                T_BRANCH: pred_taken = bht[bht_index(pc, ghr)][1];
+                T_JUMP:   pred_taken = 1'b1;
+                T_RET: begin
+                    pred_taken = 1'b1;
+                    if (ras_count != 0)
+                        pred_target = ras[ras_top];
+                end
+                default:  pred_taken = 1'b0;
+            endcase
+        end
+    end
+
+    // ==================================
+    // UPDATE
+    // ==================================
+    logic [BTB_IDX-1:0] u_idx;
+    logic [BHT_IDX-1:0] u_bht_idx;
+    logic u_branch, u_jal, u_jalr, rd_link, rs1_link, u_push, u_pop;
+
+    always_comb begin
+        u_idx     = upd_pc[BTB_IDX+PC_LO-1:PC_LO];
+        u_bht_idx = bht_index(upd_pc, upd_ghr);
+        u_branch  = upd_instr[6:0] == OP_B;
+        u_jal     = upd_instr[6:0] == OP_JAL;
+        u_jalr    = upd_instr[6:0] == OP_JALR;
+        rd_link   = upd_instr[11:7] == 5'd1 || upd_instr[11:7] == 5'd5;
+        rs1_link  = upd_instr[19:15] == 5'd1 || upd_instr[19:15] == 5'd5;
+        u_push    = (u_jal || u_jalr) && rd_link;
+        u_pop     = u_jalr && rs1_link && (!rd_link || upd_instr[11:7] != upd_instr[19:15]);
+    end
+
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            for (int i = 0; i < BTB_ENTRIES; i++)
+                btb_valid[i] <= 1'b0;
+            for (int i = 0; i < BHT_ENTRIES; i++)
+                bht[i] <= 2'b01;                // weakly not-taken
+            ras_top          <= '0;
+            ras_count        <= '0;
+            ghr              <= '0;
+            stat_branches    <= 32'b0;
+            stat_branch_miss <= 32'b0;
+            stat_jumps       <= 32'b0;
+            stat_jump_miss   <= 32'b0;
+        end else if (upd_valid) begin
+            // BTB: taken branches and every jump
+            if ((u_branch && upd_taken) || u_jal || u_jalr) begin
+                btb_valid[u_idx]  <= 1'b1;
+                btb_tag[u_idx]    <= upd_pc[31:BTB_IDX+PC_LO];
+                btb_target[u_idx] <= upd_target;
+                btb_kind[u_idx]   <= u_pop ? T_RET : (u_branch ? T_BRANCH : T_JUMP);
+            end
+
+            // BHT + history
+            if (u_branch) begin
+                if (upd_taken && bht[u_bht_idx] != 2'b11)
+                    bht[u_bht_idx] <= bht[u_bht_idx] + 2'b01;
+                else if (!upd_taken && bht[u_bht_idx] != 2'b00)
+                    bht[u_bht_idx] <= bht[u_bht_idx] - 2'b01;
+                if (GHR_BITS > 0)
+                    ghr <= GHR_W'({ghr, upd_taken});
+            end
+
+            // RAS
+            if (u_push && (!u_pop || ras_count == 0)) begin
+                ras_top                        <= ras_top + 1'b1;
+                ras[RAS_IDX'(ras_top + 1'b1)]  <= upd_seq_pc;
+                if (ras_count != (RAS_IDX + 1)'(RAS_DEPTH))
+                    ras_count <= ras_count + 1'b1;
+            end else if (u_push) begin
+                ras[ras_top] <= upd_seq_pc;
+            end else if (u_pop && ras_count != 0) begin
+                ras_top   <= ras_top - 1'b1;
+                ras_count <= ras_count - 1'b1;
+            end
+
+            // Accuracy
+            if (u_branch) begin
+                stat_branches <= stat_branches + 1;
+                if (upd_mispredict) stat_branch_miss <= stat_branch_miss + 1;
+            end
+            if (u_jal || u_jalr) begin
+                stat_jumps <= stat_jumps + 1;
+                if (upd_mispredict) stat_jump_miss <= stat_jump_miss + 1;
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,65 @@
+// Core-local interruptor: the machine software and timer interrupts of one
+// hart, at the SiFive CLINT offsets.
+//
+// Offset          | Register                          | Access
+// ----------------|-----------------------------------|------------
+// 0x0000          | msip (bit 0)                      | read/write
+// 0x4000 / 0x4004 | mtimecmp / mtimecmph              | read/write
+// 0xBFF8 / 0xBFFC | mtime / mtimeh                    | read-only
+//
+// mtime is the `time` CSR's counter (CSRFile), so there is one time base;
+// writes to it are ignored. mtimecmp resets to all ones: no timer
+// interrupt until software sets it. MTIP is mtime >= mtimecmp. Accesses
+// are whole words (lw/sw); other offsets read 0 and ignore writes.
+
+module CLINT (
+    input  logic        clk, rst,
+
+    // Register access: sel for a load or store in the CLINT window
+    input  logic        sel,
+    input  logic        wen,
+    input  logic [15:0] offset,
+    input  logic [31:0] wdata,
+    output logic [31:0] rdata,
+
+    input  logic [63:0] mtime,
+    output logic        msip,
+    output logic        mtip
+);
+
+    localparam logic [15:0] MSIP      = 16'h0000;
+    localparam logic [15:0] MTIMECMP  = 16'h4000;
+    localparam logic [15:0] MTIMECMPH = 16'h4004;
+    localparam logic [15:0] MTIME     = 16'hBFF8;
+    localparam logic [15:0] MTIMEH    = 16'hBFFC;
+
+    logic [63:0] mtimecmp;
+
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            msip     <= 1'b0;
+            mtimecmp <= '1;
+        end else if (sel && wen) begin
+            case (offset)
+                MSIP:      msip            <= wdata[0];
+                MTIMECMP:  mtimecmp[31:0]  <= wdata;
+                MTIMECMPH: mtimecmp[63:32] <= wdata;
+                default: ;
+            endcase
+        end
+    end
+
+    always_comb begin
+        case (offset)
+            MSIP:      rdata = {31'b0, msip};
+            MTIMECMP:  rdata = mtimecmp[31:0];
+            MTIMECMPH: rdata = mtimecmp[63:32];
+            MTIME:     rdata = mtime[31:0];
+            MTIMEH:    rdata = mtime[63:32];
+            default:   rdata = 32'b0;
+        endcase
+    end
+
+    assign mtip = mtime >= mtimecmp;
+
+endmodule
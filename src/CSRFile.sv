@@ -0,0 +1,313 @@
+// Zicntr / Zihpm performance counters behind a Zicsr access port.
+//
+// Address         | Name                              | Access
+// ----------------|-----------------------------------|------------
+// 0xC00 / 0xC80   | cycle / cycleh                    | read-only
+// 0xC01 / 0xC81   | time / timeh                      | read-only
+// 0xC02 / 0xC82   | instret / instreth                | read-only
+// 0xC03+ / 0xC83+ | hpmcounter3.. / hpmcounter3h..    | read-only
+// 0xB00 / 0xB80   | mcycle / mcycleh                  | read/write
+// 0xB02 / 0xB82   | minstret / minstreth              | read/write
+// 0xB03+ / 0xB83+ | mhpmcounter3.. / mhpmcounter3h..  | read/write
+// 0x320           | mcountinhibit                     | read/write
+// 0x323+          | mhpmevent3..                      | read/write
+// 0xF11 - 0xF13   | mvendorid / marchid / mimpid (0)  | read-only
+// 0xF14           | mhartid (HART_ID)                 | read-only
+//
+// With TRAPS = 1 the machine trap CSRs are added (illegal otherwise):
+// 0x300           | mstatus (MIE, MPIE; MPP reads 3)  | read/write
+// 0x301           | misa (RV32IMB)                    | writes ignored
+// 0x304           | mie (MSIE, MTIE, MEIE)            | read/write
+// 0x305           | mtvec (direct or vectored)        | read/write
+// 0x310           | mstatush (0)                      | writes ignored
+// 0x340           | mscratch                          | read/write
+// 0x341           | mepc                              | read/write
+// 0x342           | mcause                            | read/write
+// 0x343           | mtval                             | read/write
+// 0x344           | mip (MSIP, MTIP, MEIP)            | writes ignored
+//
+// mhpmevent selects what a hpmcounter counts:
+//   0 = off, 1 = taken branch, 2 = load, 3 = store, 4 = jump (JAL/JALR), 5 = illegal op
+// hpmcounterN resets to event N-2, so hpmcounter3..7 count events 1..5.
+//
+// The core decides when to trap; trap_enter saves epc/cause/tval and clears
+// MIE, mret restores it. irq_pending is an enabled interrupt with MIE set,
+// prioritised MEI > MSI > MTI as in the privileged spec.
+
+module CSRFile #(
+    parameter NUM_HPM  = 5,    // hpmcounter3 .. hpmcounter(2+NUM_HPM), at most 29
+    parameter TIME_DIV = 1,    // clock cycles per `time` tick
+    parameter HART_ID  = 0,    // mhartid
+    parameter RETIRE_W = 1,    // instructions that can retire per cycle
+    parameter TRAPS    = 0     // 1: machine trap CSRs
+) (
+    input  logic        clk, rst,
+
+    // CSR instruction (CSRRW/CSRRS/CSRRC and immediate forms)
+    input  logic        csr_en,
+    input  logic [2:0]  csr_op,         // func3
+    input  logic [11:0] csr_addr,
+    input  logic [4:0]  csr_zimm,       // rs1 field: register index or uimm
+    input  logic [31:0] csr_src,        // rs1 value
+    output logic [31:0] csr_rdata,
+    output logic        csr_illegal,
+
+    // Counter inputs
+    input  logic [RETIRE_W-1:0] retire, // one bit per instruction retiring this cycle
+    input  logic [4:0]  events,         // {illegal, jump, store, load, taken branch}
+
+    // Traps (TRAPS = 1)
+    input  logic [2:0]  irq,            // {MEIP, MTIP, MSIP}, level-sensitive
+    input  logic        trap_enter,
+    input  logic [31:0] trap_cause,     // mcause, bit 31 = interrupt
+    input  logic [31:0] trap_epc,
+    input  logic [31:0] trap_tval,
+    input  logic        mret,
+    output logic        irq_pending,    // take an interrupt
+    output logic [31:0] irq_cause,
+    output logic        irq_wake,       // an interrupt enabled in mie is pending (WFI)
+    output logic [31:0] trap_vector,    // handler for trap_cause
+    output logic [31:0] trap_mepc,
+    output logic        handler_set,    // mtvec != 0
+
+    output logic [63:0] debug_cycle,
+    output logic [63:0] debug_time,
+    output logic [63:0] debug_instret,
+    output logic [NUM_HPM*64-1:0] debug_hpmcounter
+);
+
+    localparam NUM_EVENTS = 5;
+
+    typedef enum logic [6:0] {
+        CNT_LO   = 7'b1100000,  // 0xC00-0xC1F
+        CNT_HI   = 7'b1100100,  // 0xC80-0xC9F
+        MCNT_LO  = 7'b1011000,  // 0xB00-0xB1F
+        MCNT_HI  = 7'b1011100,  // 0xB80-0xB9F
+        MCOUNTER = 7'b0011001,  // 0x320-0x33F
+        MSETUP   = 7'b0011000,  // 0x300-0x31F
+        MHANDLE  = 7'b0011010,  // 0x340-0x35F
+        MINFO    = 7'b1111000   // 0xF00-0xF1F
+    } csr_block;
+
+    logic [63:0] mcycle, mtime, minstret;
+    logic [63:0] mhpmcounter [0:NUM_HPM-1];
+    logic [4:0]  mhpmevent   [0:NUM_HPM-1];
+    logic [31:0] mcountinhibit;
+    logic [31:0] time_div_cnt;
+
+    // Trap state; MPP is always M
+    logic        mstatus_mie, mstatus_mpie;
+    logic [2:0]  mie;                   // {MEIE, MTIE, MSIE}
+    logic [31:0] mtvec, mscratch, mepc, mcause, mtval;
+    logic [31:0] mstatus, mie_csr, mip_csr;
+    localparam logic [31:0] MISA = 32'h40001102;   // MXL 32, B, I, M
+
+    assign mstatus = {19'b0, 2'b11, 3'b0, mstatus_mpie, 3'b0, mstatus_mie, 3'b0};
+    assign mie_csr = {20'b0, mie[2], 3'b0, mie[1], 3'b0, mie[0], 3'b0};
+    assign mip_csr = {20'b0, irq[2], 3'b0, irq[1], 3'b0, irq[0], 3'b0};
+
+    // ==================================
+    // CSR READ
+    // ==================================
+    logic [31:0] old_val, src, wval;
+    logic        valid, writable, do_write;
+    logic        hpm_hit;
+    int          idx, hpm_idx;
+
+    always_comb begin
+        idx      = int'(csr_addr[4:0]);
+        hpm_idx  = idx - 3;
+        hpm_hit  = (idx >= 3) && (hpm_idx < NUM_HPM);
+        old_val  = 32'b0;
+        valid    = 1'b1;
+        writable = 1'b0;
+
+        case (csr_addr[11:5])
+            CNT_LO, CNT_HI: begin
+                if (idx == 0)       old_val = csr_addr[7] ? mcycle[63:32]   : mcycle[31:0];
+                else if (idx == 1)  old_val = csr_addr[7] ? mtime[63:32]    : mtime[31:0];
+                else if (idx == 2)  old_val = csr_addr[7] ? minstret[63:32] : minstret[31:0];
+                else if (hpm_hit)   old_val = csr_addr[7] ? mhpmcounter[hpm_idx][63:32] : mhpmcounter[hpm_idx][31:0];
+                else                valid   = 1'b0;
+            end
+
+            MCNT_LO, MCNT_HI: begin
+                writable = 1'b1;
+                if (idx == 0)       old_val = csr_addr[7] ? mcycle[63:32]   : mcycle[31:0];
+                else if (idx == 2)  old_val = csr_addr[7] ? minstret[63:32] : minstret[31:0];
+                else if (hpm_hit)   old_val = csr_addr[7] ? mhpmcounter[hpm_idx][63:32] : mhpmcounter[hpm_idx][31:0];
+                else                valid   = 1'b0;
+            end
+
+            MCOUNTER: begin
+                writable = 1'b1;
+                if (idx == 0)       old_val = mcountinhibit;
+                else if (hpm_hit)   old_val = {27'b0, mhpmevent[hpm_idx]};
+                else                valid   = 1'b0;
+            end
+
+            MINFO: begin
+                if (idx == 20)                old_val = HART_ID;
+                else if (idx < 17 || idx > 19) valid  = 1'b0;
+            end
+
+            MSETUP: begin
+                writable = 1'b1;
+                valid    = TRAPS != 0;
+                if (idx == 0)       old_val = mstatus;
+                else if (idx == 1)  old_val = MISA;
+                else if (idx == 4)  old_val = mie_csr;
+                else if (idx == 5)  old_val = mtvec;
+                else if (idx != 16) valid   = 1'b0;     // mstatush reads 0
+            end
+
+            MHANDLE: begin
+                writable = 1'b1;
+                valid    = TRAPS != 0;
+                if (idx == 0)      old_val = mscratch;
+                else if (idx == 1) old_val = mepc;
+                else if (idx == 2) old_val = mcause;
+                else if (idx == 3) old_val = mtval;
+                else if (idx == 4) old_val = mip_csr;
+                else               valid   = 1'b0;
+            end
+
+            default: valid = 1'b0;
+        endcase
+
+        // CSRRS/CSRRC with rs1 = x0 (or uimm = 0) read without writing
+        src = csr_op[2] ? {27'b0, csr_zimm} : csr_src;
+        case (csr_op[1:0])
+            2'b01:   wval = src;
+            2'b10:   wval = old_val | src;
+            2'b11:   wval = old_val & ~src;
+            default: wval = old_val;
+        endcase
+        do_write = csr_en && (csr_op[1:0] == 2'b01 || csr_zimm != 5'd0);
+
+        csr_illegal = csr_en && (!valid || (do_write && !writable));
+        csr_rdata   = csr_illegal ? 32'b0 : old_val;
+    end
+
+    // ==================================
+    // COUNTERS AND CSR WRITE
+    // ==================================
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            mcycle        <= 64'b0;
+            mtime         <= 64'b0;
+            minstret      <= 64'b0;
+            mcountinhibit <= 32'b0;
+            time_div_cnt  <= 32'b0;
+            mstatus_mie   <= 1'b0;
+            mstatus_mpie  <= 1'b0;
+            mie           <= 3'b0;
+            mtvec         <= 32'b0;
+            mscratch      <= 32'b0;
+            mepc          <= 32'b0;
+            mcause        <= 32'b0;
+            mtval         <= 32'b0;
+            for (int i = 0; i < NUM_HPM; i++) begin
+                mhpmcounter[i] <= 64'b0;
+                mhpmevent[i]   <= (i < NUM_EVENTS) ? 5'(i + 1) : 5'd0;
+            end
+        end else begin
+            if (time_div_cnt == TIME_DIV - 1) begin
+                time_div_cnt <= 32'b0;
+                mtime        <= mtime + 1;
+            end else
+                time_div_cnt <= time_div_cnt + 1;
+
+            if (!mcountinhibit[0])
+                mcycle <= mcycle + 1;
+            if (!mcountinhibit[2])
+                minstret <= minstret + 64'($countones(retire));
+            for (int i = 0; i < NUM_HPM; i++) begin
+                if (!mcountinhibit[i + 3] && mhpmevent[i] != 5'd0 &&
+                    int'(mhpmevent[i]) <= NUM_EVENTS && events[mhpmevent[i] - 5'd1])
+                    mhpmcounter[i] <= mhpmcounter[i] + 1;
+            end
+
+            // An explicit write takes priority over the increment
+            if (do_write && !csr_illegal) begin
+                case (csr_addr[11:5])
+                    MCNT_LO: begin
+                        if (idx == 0)      mcycle[31:0]   <= wval;
+                        else if (idx == 2) minstret[31:0] <= wval;
+                        else               mhpmcounter[hpm_idx][31:0] <= wval;
+                    end
+                    MCNT_HI: begin
+                        if (idx == 0)      mcycle[63:32]   <= wval;
+                        else if (idx == 2) minstret[63:32] <= wval;
+                        else               mhpmcounter[hpm_idx][63:32] <= wval;
+                    end
+                    MCOUNTER: begin
+                        if (idx == 0) mcountinhibit <= wval & 32'hFFFFFFFD;  // no time inhibit
+                        else          mhpmevent[hpm_idx] <= wval[4:0];
+                    end
+                    MSETUP: begin
+                        if (idx == 0) begin
+                            mstatus_mie  <= wval[3];
+                            mstatus_mpie <= wval[7];
+                        end
+                        else if (idx == 4) mie   <= {wval[11], wval[7], wval[3]};
+                        else if (idx == 5) mtvec <= {wval[31:2], 1'b0, wval[0]};  // modes 2/3 reserved
+                    end
+                    MHANDLE: begin
+                        if (idx == 0)      mscratch <= wval;
+                        else if (idx == 1) mepc     <= {wval[31:1], 1'b0};
+                        else if (idx == 2) mcause   <= wval;
+                        else if (idx == 3) mtval    <= wval;
+                    end
+                    default: ;
+                endcase
+            end
+
+            // The core never traps on a cycle that writes a CSR
+            if (TRAPS != 0 && trap_enter) begin
+                mepc         <= {trap_epc[31:1], 1'b0};
+                mcause       <= trap_cause;
+                mtval        <= trap_tval;
+                mstatus_mpie <= mstatus_mie;
+                mstatus_mie  <= 1'b0;
+            end else if (TRAPS != 0 && mret) begin
+                mstatus_mie  <= mstatus_mpie;
+                mstatus_mpie <= 1'b1;
+            end
+        end
+    end
+
+    // ==================================
+    // INTERRUPTS
+    // ==================================
+    logic [2:0] irq_enabled;
+    assign irq_enabled = TRAPS != 0 ? irq & mie : 3'b0;
+    assign irq_wake    = irq_enabled != 3'b0;
+    assign irq_pending = irq_wake && mstatus_mie;
+
+    always_comb begin
+        if (irq_enabled[2])      irq_cause = 32'h8000000B;   // machine external
+        else if (irq_enabled[0]) irq_cause = 32'h80000003;   // machine software
+        else                     irq_cause = 32'h80000007;   // machine timer
+    end
+
+    // Vectored mode sends interrupts to BASE + 4 * cause
+    assign trap_vector = (mtvec[0] && trap_cause[31]) ? {mtvec[31:2], 2'b00} + {trap_cause[29:0], 2'b00}
+                                                      : {mtvec[31:2], 2'b00};
+    assign trap_mepc   = mepc;
+    assign handler_set = mtvec != 32'b0;
+
+    // ==================================
+    // Assigning debug outputs
+    // ==================================
+    assign debug_cycle   = mcycle;
+    assign debug_time    = mtime;
+    assign debug_instret = minstret;
+
+    generate
+        for (genvar i = 0; i < NUM_HPM; i++) begin : g_debug_hpm
+            assign debug_hpmcounter[i*64 +: 64] = mhpmcounter[i];
+        end
+    endgenerate
+
+endmodule
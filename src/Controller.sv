@@ -1,12 +1,18 @@
-module Controller(
+module Controller #(
+    parameter TRAPS = 0                // 1: decode MRET and WFI (illegal otherwise)
+) (
     /* verilator lint_off UNUSEDSIGNAL */
     input logic [6:0] opcode, func7,   // opcode[1:0] always 11 in base ISA
     /* verilator lint_off UNUSEDSIGNAL */
     input logic [2:0] func3, 
-    output logic [3:0] alu_ctrl, 
+    input logic [4:0] rs2,             // picks the Zbb unary op (clz, sext.b, ...)
+    input logic [4:0] rs1, rd,         // must be x0 in ECALL/EBREAK/MRET/WFI
+    output logic [5:0] alu_ctrl, 
     output logic [2:0] branch_cond, byte_mask,
     output logic [1:0] wb_sel,
-    output logic reg_wen, alu_pc_sel, alu_imm_sel, mem_wen, illegal_op
+    output logic reg_wen, alu_pc_sel, alu_imm_sel, mem_wen, csr_en, muldiv_en, illegal_op,
+    output logic sys_exit,          // ECALL/EBREAK: the program is done
+    output logic mret, wfi
 );
 
     // Instruction types
@@ -19,7 +25,9 @@ module Controller(
         INSTR_L     = 7'b0000011,
         INSTR_S     = 7'b0100011,
         INSTR_LUI   = 7'b0110111,
-        INSTR_AUIPC = 7'b0010111
+        INSTR_AUIPC = 7'b0010111,
+        INSTR_SYS   = 7'b1110011,
+        INSTR_FENCE = 7'b0001111
     } op_instr;
 
     // ALU func3 codes:
@@ -34,6 +42,19 @@ module Controller(
         AND   = 3'b111
     } alu_instr;
 
+    // M extension: R-type with this func7, operation in func3
+    localparam FUNC7_MULDIV = 7'b0000001;
+
+    // Zba/Zbb/Zbs: func7 (imm[11:5] on OP-IMM) of each group
+    localparam FUNC7_SHADD  = 7'b0010000;   // sh1add/sh2add/sh3add
+    localparam FUNC7_NEG    = 7'b0100000;   // andn/orn/xnor (with sub/sra)
+    localparam FUNC7_MINMAX = 7'b0000101;   // min/minu/max/maxu
+    localparam FUNC7_ZEXTH  = 7'b0000100;   // zext.h (rs2 = 0)
+    localparam FUNC7_ROT    = 7'b0110000;   // rol/ror(i); clz/ctz/cpop/sext.b/sext.h by rs2
+    localparam FUNC7_BCLR   = 7'b0100100;   // bclr(i)/bext(i)
+    localparam FUNC7_BINV   = 7'b0110100;   // binv(i); rev8 (rs2 = 11000)
+    localparam FUNC7_BSET   = 7'b0010100;   // bset(i); orc.b (rs2 = 00111)
+
     // Branch func3 codes:
     typedef enum logic [2:0] {
         BEQ = 3'b000,
@@ -54,19 +75,44 @@ module Controller(
     } load_instr;
 
     //------CONTROLLER CODES---------//
-    typedef enum logic [3:0] {
-        ADD_CTRL  = 4'b0000,
-        SUB_CTRL  = 4'b0001,
-        XOR_CTRL  = 4'b0010,
-        OR_CTRL   = 4'b0011,
-        AND_CTRL  = 4'b0100,
-        SLL_CTRL  = 4'b0101,
-        SRL_CTRL  = 4'b0110,
-        SRA_CTRL  = 4'b0111,
-        SLT_CTRL  = 4'b1000,
-        SLTU_CTRL = 4'b1001,
-        JALR_CTRL = 4'b1010,
-        THRU_CTRL = 4'b1111
+    typedef enum logic [5:0] {
+        ADD_CTRL  = 6'b000000,
+        SUB_CTRL  = 6'b000001,
+        XOR_CTRL  = 6'b000010,
+        OR_CTRL   = 6'b000011,
+        AND_CTRL  = 6'b000100,
+        SLL_CTRL  = 6'b000101,
+        SRL_CTRL  = 6'b000110,
+        SRA_CTRL  = 6'b000111,
+        SLT_CTRL  = 6'b001000,
+        SLTU_CTRL = 6'b001001,
+        JALR_CTRL = 6'b001010,
+        THRU_CTRL = 6'b001111,
+
+        SH1ADD_CTRL = 6'b010000,
+        SH2ADD_CTRL = 6'b010001,
+        SH3ADD_CTRL = 6'b010010,
+        ANDN_CTRL   = 6'b010011,
+        ORN_CTRL    = 6'b010100,
+        XNOR_CTRL   = 6'b010101,
+        CLZ_CTRL    = 6'b010110,
+        CTZ_CTRL    = 6'b010111,
+        CPOP_CTRL   = 6'b011000,
+        MIN_CTRL    = 6'b011001,
+        MAX_CTRL    = 6'b011010,
+        MINU_CTRL   = 6'b011011,
+        MAXU_CTRL   = 6'b011100,
+        SEXTB_CTRL  = 6'b011101,
+        SEXTH_CTRL  = 6'b011110,
+        ZEXTH_CTRL  = 6'b011111,
+        REV8_CTRL   = 6'b100000,
+        ORCB_CTRL   = 6'b100001,
+        ROL_CTRL    = 6'b100010,
+        ROR_CTRL    = 6'b100011,
+        BCLR_CTRL   = 6'b100100,
+        BSET_CTRL   = 6'b100101,
+        BINV_CTRL   = 6'b100110,
+        BEXT_CTRL   = 6'b100111
     } alu_codes; 
 
     typedef enum logic [2:0] {
@@ -83,7 +129,8 @@ module Controller(
     typedef enum logic [1:0] {
         RES_WB = 2'd0,
         MEM_WB = 2'd1,
-        PC_WB  = 2'd2
+        PC_WB  = 2'd2,
+        CSR_WB = 2'd3
     } wb_codes;
 
     always_comb begin
@@ -96,12 +143,20 @@ module Controller(
         mem_wen     = 1'b0;
         byte_mask   = LW;
         wb_sel      = RES_WB;
+        csr_en      = 1'b0;
+        muldiv_en   = 1'b0;
         illegal_op  = 0;
+        sys_exit    = 0;
+        mret        = 0;
+        wfi         = 0;
         
         case (opcode)
             INSTR_I, INSTR_R: begin
                 reg_wen     = 1'b1;
                 alu_imm_sel = opcode[5] ? 1'b0 : 1'b1;
+                // MUL/MULH/MULHSU/MULHU (func3[2] = 0) and DIV/DIVU/REM/REMU
+                // (func3[2] = 1) bypass the ALU; func3 selects the operation.
+                muldiv_en   = opcode[5] && func7 == FUNC7_MULDIV;
 
                 case (func3)
                     ADD  :  alu_ctrl = (opcode[5] && (func7 == 7'b0100000)) ? SUB_CTRL : ADD_CTRL;
@@ -113,6 +168,79 @@ module Controller(
                     OR   :  alu_ctrl = OR_CTRL;
                     AND  :  alu_ctrl = AND_CTRL;
                 endcase
+
+                // Zba/Zbb/Zbs. Other func7 values keep the base operation.
+                if (opcode[5]) begin
+                    case (func7)
+                        FUNC7_SHADD: case (func3)
+                            3'b010: alu_ctrl = SH1ADD_CTRL;
+                            3'b100: alu_ctrl = SH2ADD_CTRL;
+                            3'b110: alu_ctrl = SH3ADD_CTRL;
+                            default: ;
+                        endcase
+                        FUNC7_NEG: case (func3)
+                            3'b111: alu_ctrl = ANDN_CTRL;
+                            3'b110: alu_ctrl = ORN_CTRL;
+                            3'b100: alu_ctrl = XNOR_CTRL;
+                            default: ;
+                        endcase
+                        FUNC7_MINMAX: case (func3)
+                            3'b100: alu_ctrl = MIN_CTRL;
+                            3'b101: alu_ctrl = MINU_CTRL;
+                            3'b110: alu_ctrl = MAX_CTRL;
+                            3'b111: alu_ctrl = MAXU_CTRL;
+                            default: ;
+                        endcase
+                        FUNC7_ZEXTH: if (func3 == 3'b100) begin
+                            alu_ctrl   = ZEXTH_CTRL;
+                            illegal_op = rs2 != 5'd0;
+                        end
+                        FUNC7_ROT: case (func3)
+                            3'b001: alu_ctrl = ROL_CTRL;
+                            3'b101: alu_ctrl = ROR_CTRL;
+                            default: ;
+                        endcase
+                        FUNC7_BCLR: case (func3)
+                            3'b001: alu_ctrl = BCLR_CTRL;
+                            3'b101: alu_ctrl = BEXT_CTRL;
+                            default: ;
+                        endcase
+                        FUNC7_BINV: if (func3 == 3'b001) alu_ctrl = BINV_CTRL;
+                        FUNC7_BSET: if (func3 == 3'b001) alu_ctrl = BSET_CTRL;
+                        default: ;
+                    endcase
+                end else if (func3 == 3'b001) begin
+                    case (func7)
+                        FUNC7_ROT: case (rs2)
+                            5'b00000: alu_ctrl = CLZ_CTRL;
+                            5'b00001: alu_ctrl = CTZ_CTRL;
+                            5'b00010: alu_ctrl = CPOP_CTRL;
+                            5'b00100: alu_ctrl = SEXTB_CTRL;
+                            5'b00101: alu_ctrl = SEXTH_CTRL;
+                            default:  illegal_op = 1;
+                        endcase
+                        FUNC7_BCLR: alu_ctrl = BCLR_CTRL;
+                        FUNC7_BINV: alu_ctrl = BINV_CTRL;
+                        FUNC7_BSET: alu_ctrl = BSET_CTRL;
+                        default: ;
+                    endcase
+                end else if (func3 == 3'b101) begin
+                    case (func7)
+                        FUNC7_ROT:  alu_ctrl = ROR_CTRL;
+                        FUNC7_BCLR: alu_ctrl = BEXT_CTRL;
+                        FUNC7_BINV: begin
+                            alu_ctrl   = REV8_CTRL;
+                            illegal_op = rs2 != 5'b11000;
+                        end
+                        FUNC7_BSET: begin
+                            alu_ctrl   = ORCB_CTRL;
+                            illegal_op = rs2 != 5'b00111;
+                        end
+                        default: ;
+                    endcase
+                end
+                if (illegal_op)
+                    reg_wen = 1'b0;
             end
 
             INSTR_B: begin
@@ -180,9 +308,38 @@ module Controller(
             end
 
             INSTR_AUIPC: begin
+                reg_wen     = 1'b1;
+                alu_pc_sel  = 1'b1;
                 alu_imm_sel = 1'b1;
                 alu_ctrl    = ADD_CTRL;
-                branch_cond = JMP_CTRL;
+                branch_cond = NOB_CTRL;
+                wb_sel      = RES_WB;
+            end
+
+            INSTR_SYS: begin
+                // Zicsr: CSRRW/CSRRS/CSRRC(I). ECALL (rs2 0) and EBREAK
+                // (rs2 1) end the simulation or trap; MRET and WFI need TRAPS.
+                // The privileged encodings have rs1 = rd = x0; everything
+                // else (URET, SRET, garbage fields) is illegal.
+                if (func3 != 3'b000 && func3 != 3'b100) begin
+                    reg_wen = 1'b1;
+                    csr_en  = 1'b1;
+                    wb_sel  = CSR_WB;
+                end else if (func3 != 3'b000 || rs1 != 5'b0 || rd != 5'b0)
+                    illegal_op = 1;
+                else if (func7 == 7'b0 && (rs2 == 5'b00000 || rs2 == 5'b00001))
+                    sys_exit = 1;
+                else if (TRAPS != 0 && func7 == 7'b0011000 && rs2 == 5'b00010)
+                    mret = 1;
+                else if (TRAPS != 0 && func7 == 7'b0001000 && rs2 == 5'b00101)
+                    wfi = 1;
+                else
+                    illegal_op = 1;
+            end
+
+            INSTR_FENCE: begin
+                // FENCE / FENCE.I: memory is already in program order, so this
+                // is a NOP here. The cores use it to flush the D-cache.
             end
 
             default: begin  // Invalid opcode
@@ -194,7 +351,12 @@ module Controller(
                 mem_wen     = 1'b0;
                 byte_mask   = LW;
                 wb_sel      = RES_WB;
+                csr_en      = 1'b0;
+                muldiv_en   = 1'b0;
                 illegal_op  = 1;
+                sys_exit    = 1'b0;
+                mret        = 1'b0;
+                wfi         = 1'b0;
             end
         endcase
     end
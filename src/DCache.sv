@@ -0,0 +1,258 @@
+// Write-back, write-allocate data cache in front of a word-wide backing
+// memory (DataMem read and written as LW).
+//
+// The core side keeps DataMem's interface: combinational reads with the
+// same byte_mask / sign-extension rules, and stores on the clock edge.
+// `ready` says the request completes this cycle; the core holds the
+// access while it is low.
+//   - Miss, clean victim: MISS_LATENCY cycles, then one refill word per cycle
+//   - Miss, dirty victim: the victim is written back first, one word per
+//     cycle (writes are posted, so there is no latency), then the refill
+//   - flush: write back every dirty line and invalidate the cache; `ready`
+//     pulses once when done
+// Replacement is LRU (per-way age counters). Accesses must be naturally
+// aligned. SETS and LINE_WORDS must be powers of two, at least 2; WAYS a
+// power of two.
+
+module DCache #(
+    parameter SETS         = 8,
+    parameter WAYS         = 2,
+    parameter LINE_WORDS   = 4,
+    parameter MISS_LATENCY = 8     // cycles before the first refill word
+) (
+    input  logic        clk, rst,
+
+    // Core (DataMem semantics)
+    input  logic        req,            // load or store this cycle
+    input  logic        wen,
+    input  logic [31:0] address, wdata,
+    input  logic [2:0]  byte_mask,
+    output logic [31:0] rdata,
+    input  logic        flush,
+    output logic        ready,
+
+    // Backing memory (word access)
+    output logic [31:0] mem_addr,
+    output logic [31:0] mem_wdata,
+    output logic        mem_wen,
+    input  logic [31:0] mem_rdata,
+
+    // Counters
+    output logic [31:0] stat_hits,
+    output logic [31:0] stat_misses,
+    output logic [31:0] stat_writebacks
+);
+    localparam WORD_BITS = $clog2(LINE_WORDS);
+    localparam SET_BITS  = $clog2(SETS);
+    localparam OFF_BITS  = WORD_BITS + 2;
+    localparam TAG_BITS  = 32 - OFF_BITS - SET_BITS;
+    localparam WAY_W     = (WAYS > 1) ? $clog2(WAYS) : 1;
+
+    typedef enum logic [2:0] {
+        LB  = 3'b000,
+        LH  = 3'b001,
+        LW  = 3'b010,
+        LBU = 3'b100,
+        LHU = 3'b101
+    } byte_masks;
+
+    typedef enum logic [2:0] {
+        IDLE      = 3'd0,
+        WRITEBACK = 3'd1,
+        REFILL    = 3'd2,
+        FLUSH     = 3'd3,
+        FLUSHED   = 3'd4
+    } cache_states;
+
+    logic                valid [0:SETS-1][0:WAYS-1];
+    logic                dirty [0:SETS-1][0:WAYS-1];
+    logic [TAG_BITS-1:0] tags  [0:SETS-1][0:WAYS-1];
+    logic [31:0]         data  [0:SETS-1][0:WAYS-1][0:LINE_WORDS-1];
+    logic [WAY_W-1:0]    age   [0:SETS-1][0:WAYS-1];   // 0 = most recent
+
+    // Miss / flush walk
+    cache_states          state;
+    logic [SET_BITS-1:0]  fill_set;
+    logic [TAG_BITS-1:0]  fill_tag;
+    logic [WAY_W-1:0]     fill_way;
+    logic [WORD_BITS-1:0] fill_word;
+    logic [31:0]          lat_cnt;
+
+    // ==================================
+    // LOOKUP
+    // ==================================
+    logic [SET_BITS-1:0]  set;
+    logic [TAG_BITS-1:0]  tag;
+    logic [WORD_BITS-1:0] word;
+    logic [WAY_W-1:0]     hit_way, victim;
+    logic                 hit;
+    logic [31:0]          line_word, shifted, wdata_shifted, merged;
+    logic [3:0]           be;
+
+    always_comb begin
+        set     = address[OFF_BITS +: SET_BITS];
+        tag     = address[31 -: TAG_BITS];
+        word    = address[2 +: WORD_BITS];
+        hit     = 1'b0;
+        hit_way = '0;
+        for (int w = 0; w < WAYS; w++) begin
+            if (valid[set][w] && tags[set][w] == tag) begin
+                hit     = 1'b1;
+                hit_way = WAY_W'(w);
+            end
+        end
+
+        // LRU victim, or the first invalid way
+        victim = '0;
+        for (int w = 0; w < WAYS; w++)
+            if (age[set][w] == WAY_W'(WAYS - 1))
+                victim = WAY_W'(w);
+        for (int w = WAYS - 1; w >= 0; w--)
+            if (!valid[set][w])
+                victim = WAY_W'(w);
+
+        // Read
+        line_word = data[set][hit_way][word];
+        shifted   = line_word >> {address[1:0], 3'b000};
+        case (byte_mask)
+            LH:      rdata = {{16{shifted[15]}}, shifted[15:0]};   // sign-extend
+            LHU:     rdata = {16'd0, shifted[15:0]};
+            LB:      rdata = {{24{shifted[7]}}, shifted[7:0]};     // sign-extend
+            LBU:     rdata = {24'd0, shifted[7:0]};
+            default: rdata = line_word;
+        endcase
+
+        // Write merge
+        case (byte_mask)
+            LH, LHU: be = 4'b0011 << address[1:0];
+            LB, LBU: be = 4'b0001 << address[1:0];
+            default: be = 4'b1111;
+        endcase
+        wdata_shifted = wdata << {address[1:0], 3'b000};
+        for (int b = 0; b < 4; b++)
+            merged[b*8 +: 8] = be[b] ? wdata_shifted[b*8 +: 8] : line_word[b*8 +: 8];
+    end
+
+    assign ready = (state == IDLE && !flush && (!req || hit)) || state == FLUSHED;
+
+    // ==================================
+    // BACKING MEMORY
+    // ==================================
+    always_comb begin
+        mem_wdata = data[fill_set][fill_way][fill_word];
+        mem_wen   = state == WRITEBACK ||
+                    (state == FLUSH && valid[fill_set][fill_way] && dirty[fill_set][fill_way]);
+        if (state == REFILL)
+            mem_addr = {fill_tag, fill_set, fill_word, 2'b00};
+        else
+            mem_addr = {tags[fill_set][fill_way], fill_set, fill_word, 2'b00};
+    end
+
+    // ==================================
+    // UPDATE, MISS AND FLUSH
+    // ==================================
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            for (int s = 0; s < SETS; s++) begin
+                for (int w = 0; w < WAYS; w++) begin
+                    valid[s][w] <= 1'b0;
+                    dirty[s][w] <= 1'b0;
+                    age[s][w]   <= WAY_W'(w);
+                end
+            end
+            state           <= IDLE;
+            fill_set        <= '0;
+            fill_tag        <= '0;
+            fill_way        <= '0;
+            fill_word       <= '0;
+            lat_cnt         <= 32'b0;
+            stat_hits       <= 32'b0;
+            stat_misses     <= 32'b0;
+            stat_writebacks <= 32'b0;
+        end else begin
+            case (state)
+                IDLE: begin
+                    if (flush) begin
+                        fill_set  <= '0;
+                        fill_way  <= '0;
+                        fill_word <= '0;
+                        state     <= FLUSH;
+                    end else if (req && hit) begin
+                        stat_hits <= stat_hits + 1;
+                        for (int w = 0; w < WAYS; w++)
+                            if (age[set][w] < age[set][hit_way])
+                                age[set][w] <= age[set][w] + 1'b1;
+                        age[set][hit_way] <= '0;
+                        if (wen) begin
+                            data[set][hit_way][word] <= merged;
+                            dirty[set][hit_way]      <= 1'b1;
+                        end
+                    end else if (req) begin
+                        fill_set    <= set;
+                        fill_tag    <= tag;
+                        fill_way    <= victim;
+                        fill_word   <= '0;
+                        lat_cnt     <= MISS_LATENCY;
+                        stat_misses <= stat_misses + 1;
+                        if (valid[set][victim] && dirty[set][victim]) begin
+                            state           <= WRITEBACK;
+                            stat_writebacks <= stat_writebacks + 1;
+                        end else begin
+                            valid[set][victim] <= 1'b0;
+                            state              <= REFILL;
+                        end
+                    end
+                end
+
+                WRITEBACK: begin
+                    fill_word <= fill_word + 1'b1;
+                    if (fill_word == WORD_BITS'(LINE_WORDS - 1)) begin
+                        valid[fill_set][fill_way] <= 1'b0;
+                        dirty[fill_set][fill_way] <= 1'b0;
+                        state <= REFILL;
+                    end
+                end
+
+                REFILL: begin
+                    if (lat_cnt != 0)
+                        lat_cnt <= lat_cnt - 1;
+                    else begin
+                        data[fill_set][fill_way][fill_word] <= mem_rdata;
+                        fill_word <= fill_word + 1'b1;
+                        if (fill_word == WORD_BITS'(LINE_WORDS - 1)) begin
+                            valid[fill_set][fill_way] <= 1'b1;
+                            tags[fill_set][fill_way]  <= fill_tag;
+                            state <= IDLE;
+                        end
+                    end
+                end
+
+                FLUSH: begin
+                    // One cycle per clean line, LINE_WORDS cycles per dirty line
+                    if (valid[fill_set][fill_way] && dirty[fill_set][fill_way] &&
+                        fill_word != WORD_BITS'(LINE_WORDS - 1)) begin
+                        fill_word <= fill_word + 1'b1;
+                    end else begin
+                        if (valid[fill_set][fill_way] && dirty[fill_set][fill_way])
+                            stat_writebacks <= stat_writebacks + 1;
+                        valid[fill_set][fill_way] <= 1'b0;
+                        dirty[fill_set][fill_way] <= 1'b0;
+                        fill_word <= '0;
+                        if (fill_way == WAY_W'(WAYS - 1)) begin
+                            fill_way <= '0;
+                            fill_set <= fill_set + 1'b1;
+                            if (fill_set == SET_BITS'(SETS - 1))
+                                state <= FLUSHED;
+                        end else
+                            fill_way <= fill_way + 1'b1;
+                    end
+                end
+
+                FLUSHED: state <= IDLE;
+
+                default: state <= IDLE;
+            endcase
+        end
+    end
+
+endmodule
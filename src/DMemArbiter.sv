@@ -0,0 +1,76 @@
+// Round-robin arbiter that puts N cores on one DataMem port.
+//
+// Each requester holds req (and its access) until gnt; at most one gnt is
+// high per cycle. The search for the next grant starts after the requester
+// granted last, so every waiting requester is served within N grants. The
+// granted access goes straight to the memory (reads are combinational,
+// writes land on the clock edge), and rdata goes to every requester: only
+// the granted one uses it.
+//
+// stat_wait counts, per requester, the cycles spent waiting (req && !gnt),
+// i.e. what the sharing cost each core.
+
+module DMemArbiter #(
+    parameter N = 2
+) (
+    input  logic          clk, rst,
+
+    // Requesters (DataMem semantics, plus req/gnt)
+    input  logic [N-1:0]    req,
+    input  logic [N-1:0]    wen,
+    input  logic [N*32-1:0] addr,
+    input  logic [N*32-1:0] wdata,
+    input  logic [N*3-1:0]  byte_mask,
+    output logic [N-1:0]    gnt,
+    output logic [31:0]     rdata,
+
+    // Shared memory
+    output logic        mem_wen,
+    output logic [31:0] mem_addr,
+    output logic [31:0] mem_wdata,
+    output logic [2:0]  mem_byte_mask,
+    input  logic [31:0] mem_rdata,
+
+    // Counters
+    output logic [N*32-1:0] stat_wait
+);
+    localparam IDX_W = (N > 1) ? $clog2(N) : 1;
+
+    logic [IDX_W-1:0] last;     // requester granted last
+    logic [IDX_W-1:0] sel;
+    logic             any;
+
+    // First requester after `last`, wrapping around
+    always_comb begin
+        sel = last;
+        any = 1'b0;
+        for (int k = 1; k <= N; k++) begin
+            if (!any && req[(int'(last) + k) % N]) begin
+                sel = IDX_W'((int'(last) + k) % N);
+                any = 1'b1;
+            end
+        end
+    end
+
+    always_comb begin
+        gnt = '0;
+        if (any) gnt[sel] = 1'b1;
+    end
+
+    assign mem_wen       = any && wen[sel];
+    assign mem_addr      = addr[sel*32 +: 32];
+    assign mem_wdata     = wdata[sel*32 +: 32];
+    assign mem_byte_mask = byte_mask[sel*3 +: 3];
+    assign rdata         = mem_rdata;
+
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            last      <= IDX_W'(N - 1);     // requester 0 first
+            stat_wait <= '0;
+        end else begin
+            if (any) last <= sel;
+            for (int i = 0; i < N; i++)
+                if (req[i] && !gnt[i]) stat_wait[i*32 +: 32] <= stat_wait[i*32 +: 32] + 1;
+        end
+    end
+endmodule
@@ -1,6 +1,9 @@
 module DataMem#(
     parameter WORDS = 128,
-    parameter mem_init = ""
+    parameter mem_init = "",
+    parameter SYNC_READ = 0     // 1: registered read (block RAM): rdata is the word at the
+                                //    address of the previous clock edge, formatted by the
+                                //    current byte_mask. The core waits a cycle per load.
 ) (
     input  logic        clk, wen,
     input  logic [31:0] address, wdata,
@@ -17,68 +20,99 @@ module DataMem#(
         LHU = 3'b101
     } byte_masks;
 
-    reg [7:0] mem [0:(WORDS * 4) - 1];
+    localparam IDX_W = (WORDS > 1) ? $clog2(WORDS) : 1;
+
+    // 32-bit words, little-endian: the byte at address 4*i + b is
+    // mem[i][8*b +: 8]. A misaligned halfword or word that crosses into the
+    // next word reads and writes both words, so any byte address works as
+    // it did on the byte array. Bytes past the end read 0 and are dropped.
+    // Public so the testbench program loaders can write it directly
+    logic [31:0] mem [0:WORDS - 1] /*verilator public_flat_rw*/;
+
+    // .mem images stay one byte per entry, lowest address first, and are
+    // packed into words here
+    logic [7:0] init_bytes [0:(WORDS * 4) - 1];
 
     // Initialization
     initial begin
+        for (int i = 0; i < (WORDS * 4); i++)
+            init_bytes[i] = 8'b0;
         if (mem_init != "")
-            $readmemh(mem_init, mem);
-        else
-            for (int i = 0; i < (WORDS * 4); i++)
-                mem[i] = 8'b0;
+            $readmemh(mem_init, init_bytes);
+        for (int i = 0; i < WORDS; i++)
+            mem[i] = {init_bytes[4*i + 3], init_bytes[4*i + 2], init_bytes[4*i + 1], init_bytes[4*i + 0]};
+    end
+
+    // The addressed word and the one after it, for accesses that cross
+    logic [IDX_W-1:0] index, index_next;
+    logic             in_range, in_range_next;
+    assign index         = address[IDX_W + 1:2];
+    assign index_next    = index + 1'b1;
+    assign in_range      = address < WORDS * 4;
+    assign in_range_next = address < (WORDS - 1) * 4;
+
+    // Byte lanes a store writes across the two words (4 and up: the next
+    // word), and its data moved onto them
+    logic [7:0]  byte_en;
+    logic [63:0] wdata_lanes;
+
+    always_comb begin
+        case (byte_mask)
+            LB, LBU: byte_en = 8'b0000_0001 << address[1:0];
+            LH, LHU: byte_en = 8'b0000_0011 << address[1:0];
+            default: byte_en = 8'b0000_1111 << address[1:0];
+        endcase
+        wdata_lanes = {32'b0, wdata} << {address[1:0], 3'b000};
     end
 
-    // Write (synchronous)
+    // Write (synchronous): one enable per byte lane
     always @(posedge clk) begin
-        if (wen && address < WORDS * 4) begin
-            case (byte_mask)
-                LW: begin
-                    mem[address + 0] <= wdata[7:0];
-                    mem[address + 1] <= wdata[15:8];
-                    mem[address + 2] <= wdata[23:16];
-                    mem[address + 3] <= wdata[31:24];
-                end
-                LH, LHU: begin
-                    mem[address + 0] <= wdata[7:0];
-                    mem[address + 1] <= wdata[15:8];
-                end
-                LB, LBU: begin
-                    mem[address + 0] <= wdata[7:0];
-                end
-                default: begin
-                    mem[address + 0] <= wdata[7:0];
-                    mem[address + 1] <= wdata[15:8];
-                    mem[address + 2] <= wdata[23:16];
-                    mem[address + 3] <= wdata[31:24];
-                end
-            endcase
+        if (wen && in_range) begin
+            for (int b = 0; b < 4; b++)
+                if (byte_en[b])
+                    mem[index][8*b +: 8] <= wdata_lanes[8*b +: 8];
+            if (in_range_next)
+                for (int b = 0; b < 4; b++)
+                    if (byte_en[4 + b])
+                        mem[index_next][8*b +: 8] <= wdata_lanes[32 + 8*b +: 8];
         end
     end
 
-    // Read (asynchronous)
+    // The words read, and whether their addresses were in range: straight
+    // from the array (asynchronous), or registered for a synchronous read
+    logic [31:0] rword, rword_next;
+    logic        rvalid, rvalid_next;
+
+    generate
+        if (SYNC_READ) begin : g_syncRead
+            always_ff @(posedge clk) begin
+                rword       <= mem[index];
+                rvalid      <= in_range;
+                rword_next  <= mem[index_next];
+                rvalid_next <= in_range_next;
+            end
+        end else begin : g_asyncRead
+            assign rword       = mem[index];
+            assign rvalid      = in_range;
+            assign rword_next  = mem[index_next];
+            assign rvalid_next = in_range_next;
+        end
+    endgenerate
+
+    // Pick the bytes out of the two words and extend them
+    logic [31:0] rdata_lanes;
+    assign rdata_lanes = 32'({rvalid_next ? rword_next : 32'b0, rword} >> {address[1:0], 3'b000});
+
     always_comb begin
-        if (address >= WORDS * 4) begin
+        if (!rvalid) begin
             rdata = 32'hDEADBEEF;
         end else begin
             case (byte_mask)
-                LW: begin
-                    rdata = {mem[address + 3], mem[address + 2], mem[address + 1], mem[address]};
-                end
-                LH: begin
-                    rdata = {{16{mem[address + 1][7]}}, mem[address + 1], mem[address]};  // sign-extend
-                end
-                LHU: begin
-                    rdata = {16'd0, mem[address + 1], mem[address]};
-                end
-                LB: begin
-                    rdata = {{24{mem[address][7]}}, mem[address]};  // sign-extend
-                end
-                LBU: begin
-                    rdata = {24'd0, mem[address]};
-                end
-                default: begin
-                    rdata = {mem[address + 3], mem[address + 2], mem[address + 1], mem[address]};
-                end
+                LH:      rdata = {{16{rdata_lanes[15]}}, rdata_lanes[15:0]};  // sign-extend
+                LHU:     rdata = {16'd0, rdata_lanes[15:0]};
+                LB:      rdata = {{24{rdata_lanes[7]}}, rdata_lanes[7:0]};    // sign-extend
+                LBU:     rdata = {24'd0, rdata_lanes[7:0]};
+                default: rdata = rdata_lanes;
             endcase
         end
     end
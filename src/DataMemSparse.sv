@@ -0,0 +1,67 @@
+// DataMem with its storage in C++ (tb/common/sparse_mem.h) instead of a
+// Verilog array: a page table over the whole 32-bit address space, with
+// 4 KiB pages allocated on first write. Same ports and byte_mask semantics
+// as DataMem, except there is no end of memory: untouched addresses read 0
+// instead of 0xDEADBEEF. MEM_ID picks the C++ instance.
+
+module DataMemSparse #(
+    parameter MEM_ID   = 0,
+    parameter mem_init = ""
+) (
+    input  logic        clk, wen,
+    input  logic [31:0] address, wdata,
+    input  logic [2:0]  byte_mask,
+
+    output logic [31:0] rdata
+);
+
+    import "DPI-C" function int  sparse_mem_read(input int id, input int addr, input int version);
+    import "DPI-C" function void sparse_mem_write(input int id, input int addr, input int data, input int bytes);
+    import "DPI-C" function void sparse_mem_load(input int id, input string path);
+
+    typedef enum logic [2:0] {
+        LB  = 3'b000,
+        LH  = 3'b001,
+        LW  = 3'b010,
+        LBU = 3'b100,
+        LHU = 3'b101
+    } byte_masks;
+
+    // Bumped on every write. The read takes it as an argument so that a
+    // load from an address that was just written is evaluated again.
+    int version = 0;
+
+    // Initialization
+    initial begin
+        if (mem_init != "")
+            sparse_mem_load(MEM_ID, mem_init);
+    end
+
+    // Write (synchronous)
+    always @(posedge clk) begin
+        if (wen) begin
+            case (byte_mask)
+                LH, LHU: sparse_mem_write(MEM_ID, address, wdata, 2);
+                LB, LBU: sparse_mem_write(MEM_ID, address, wdata, 1);
+                default: sparse_mem_write(MEM_ID, address, wdata, 4);
+            endcase
+            version <= version + 1;
+        end
+    end
+
+    // Read (asynchronous)
+    logic [31:0] word;
+
+    always_comb begin
+        word = sparse_mem_read(MEM_ID, address, version);
+
+        case (byte_mask)
+            LW:      rdata = word;
+            LH:      rdata = {{16{word[15]}}, word[15:0]};  // sign-extend
+            LHU:     rdata = {16'd0, word[15:0]};
+            LB:      rdata = {{24{word[7]}}, word[7:0]};    // sign-extend
+            LBU:     rdata = {24'd0, word[7:0]};
+            default: rdata = word;
+        endcase
+    end
+endmodule
@@ -0,0 +1,144 @@
+// Iterative divider for the M extension. `op` is func3[1:0]:
+//   00 DIV   01 DIVU   10 REM   11 REMU
+//
+// Restoring division, one quotient bit per cycle, on the operand
+// magnitudes. It only iterates over the significant bits of the dividend
+// (the leading zeros are skipped up front), so a DIV of an n-bit dividend
+// stalls for 1 + n cycles. These finish at once, with `ready` in the
+// request cycle:
+//   - divide by zero:  quotient all ones, remainder = dividend
+//   - signed overflow (-2^31 / -1): quotient -2^31, remainder 0
+//   - |dividend| < |divisor|: quotient 0, remainder = dividend
+//
+// Like DCache, `ready` says the request completes this cycle and is high
+// when there is no request. A finished result is held while `hold` is set
+// (the core is stalled on something else).
+
+module Divider (
+    input  logic        clk, rst,
+    input  logic        req,
+    input  logic [1:0]  op,
+    input  logic [31:0] src1, src2,     // dividend, divisor
+    input  logic        hold,
+    output logic [31:0] result,
+    output logic        ready
+);
+
+    typedef enum logic [1:0] {
+        IDLE = 2'd0,
+        BUSY = 2'd1,
+        DONE = 2'd2
+    } div_states;
+
+    div_states   state;
+    logic [31:0] quo, rem, divisor;
+    logic [5:0]  count;
+    logic        neg_quo, neg_rem, want_rem;
+
+    // ==================================
+    // REQUEST
+    // ==================================
+    logic        is_signed, neg1, neg2, div_zero, overflow, small, early;
+    logic [31:0] abs1, abs2, early_result;
+    logic [5:0]  bits;
+
+    always_comb begin
+        is_signed = !op[0];
+        neg1      = is_signed && src1[31];
+        neg2      = is_signed && src2[31];
+        abs1      = neg1 ? -src1 : src1;
+        abs2      = neg2 ? -src2 : src2;
+
+        div_zero  = src2 == 32'b0;
+        overflow  = is_signed && src1 == 32'h80000000 && src2 == 32'hFFFFFFFF;
+        small     = abs1 < abs2;
+        early     = div_zero || overflow || small;
+
+        if (div_zero)
+            early_result = op[1] ? src1 : 32'hFFFFFFFF;
+        else if (overflow)
+            early_result = op[1] ? 32'b0 : 32'h80000000;
+        else
+            early_result = op[1] ? src1 : 32'b0;
+
+        // Significant bits of the dividend
+        bits = 6'd0;
+        for (int i = 0; i < 32; i++)
+            if (abs1[i])
+                bits = 6'(i + 1);
+    end
+
+    // ==================================
+    // ITERATION
+    // ==================================
+    logic [32:0] rem_shift, diff;
+
+    always_comb begin
+        rem_shift = {rem, quo[31]};
+        diff      = rem_shift - {1'b0, divisor};
+    end
+
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            state    <= IDLE;
+            quo      <= 32'b0;
+            rem      <= 32'b0;
+            divisor  <= 32'b0;
+            count    <= 6'd0;
+            neg_quo  <= 1'b0;
+            neg_rem  <= 1'b0;
+            want_rem <= 1'b0;
+        end else begin
+            case (state)
+                IDLE: begin
+                    if (req && !early) begin
+                        quo      <= abs1 << (6'd32 - bits);
+                        rem      <= 32'b0;
+                        divisor  <= abs2;
+                        count    <= bits;
+                        neg_quo  <= neg1 ^ neg2;
+                        neg_rem  <= neg1;
+                        want_rem <= op[1];
+                        state    <= BUSY;
+                    end
+                end
+
+                BUSY: begin
+                    if (!diff[32]) begin
+                        rem <= diff[31:0];
+                        quo <= {quo[30:0], 1'b1};
+                    end else begin
+                        rem <= rem_shift[31:0];
+                        quo <= {quo[30:0], 1'b0};
+                    end
+                    count <= count - 1'b1;
+                    if (count == 6'd1)
+                        state <= DONE;
+                end
+
+                DONE: begin
+                    if (!hold)
+                        state <= IDLE;
+                end
+
+                default: state <= IDLE;
+            endcase
+        end
+    end
+
+    // ==================================
+    // RESULT
+    // ==================================
+    always_comb begin
+        if (state == DONE) begin
+            if (want_rem)
+                result = neg_rem ? -rem : rem;
+            else
+                result = neg_quo ? -quo : quo;
+        end else
+            result = early_result;
+    end
+
+    assign ready = (state == IDLE && (!req || early)) || state == DONE;
+
+endmodule
@@ -0,0 +1,63 @@
+// Halfword fetch alignment for RV32C: turns a 2-byte aligned PC into the
+// 32-bit window holding the instruction at that PC, reading an aligned,
+// little-endian word memory one word per cycle.
+//
+//   pc[1] == 0          the aligned word (a 32-bit instruction, or a
+//                       compressed one in its low half)
+//   pc[1] == 1, 16-bit  the upper half of the aligned word
+//   pc[1] == 1, 32-bit  straddles two words: the upper half is latched and
+//                       the next word is fetched the following cycle, so
+//                       the instruction costs one extra cycle
+//
+// `valid` is low while the window is incomplete (or the memory is not
+// ready); the core holds its PC and pulses `advance` when the instruction
+// completes.
+
+module FetchAlign (
+    input  logic        clk, rst,
+    input  logic [31:0] pc,
+    input  logic        advance,
+
+    // Word memory (InstrMem or ICache)
+    output logic [31:0] fetch_addr,
+    input  logic [31:0] fetch_word,
+    input  logic        fetch_valid,
+
+    output logic [31:0] window,
+    output logic        valid
+);
+    logic [15:0] lo_half;       // low parcel of a straddling instruction
+    logic        have_lo;
+    logic        straddle;
+
+    always_comb begin
+        straddle = pc[1] && fetch_word[17:16] == 2'b11;
+
+        if (have_lo) begin
+            fetch_addr = {pc[31:2], 2'b00} + 32'd4;
+            window     = {fetch_word[15:0], lo_half};
+            valid      = fetch_valid;
+        end else if (pc[1]) begin
+            fetch_addr = {pc[31:2], 2'b00};
+            window     = {16'b0, fetch_word[31:16]};
+            valid      = fetch_valid && !straddle;
+        end else begin
+            fetch_addr = {pc[31:2], 2'b00};
+            window     = fetch_word;
+            valid      = fetch_valid;
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            lo_half <= 16'b0;
+            have_lo <= 1'b0;
+        end else if (advance) begin
+            have_lo <= 1'b0;
+        end else if (!have_lo && fetch_valid && straddle) begin
+            lo_half <= fetch_word[31:16];
+            have_lo <= 1'b1;
+        end
+    end
+
+endmodule
@@ -0,0 +1,209 @@
+// Set-associative instruction cache between the fetch PC and a slower
+// backing memory.
+//
+// Lookup is combinational: `hit` says `instr` is valid this cycle. On a
+// miss the cache waits MISS_LATENCY cycles, then refills the line from
+// `mem_addr`/`mem_rdata` one word per cycle, and hits on the cycle after
+// the last word. The fetch stage holds its PC while `hit` is low.
+//
+// Replacement (an invalid way is always filled first):
+//   REPL = 0  true LRU (per-way age counters)
+//   REPL = 1  tree pseudo-LRU
+//   REPL = 2  random (16-bit LFSR, advances every cycle)
+//
+// SETS and LINE_WORDS must be powers of two, at least 2; WAYS a power of two.
+
+module ICache #(
+    parameter SETS         = 8,
+    parameter WAYS         = 2,
+    parameter LINE_WORDS   = 4,
+    parameter REPL         = 0,
+    parameter MISS_LATENCY = 8     // cycles before the first refill word
+) (
+    input  logic        clk, rst,
+
+    // Fetch
+    input  logic        req,
+    input  logic [31:0] pc,
+    output logic [31:0] instr,
+    output logic        hit,
+
+    // Backing memory (combinational word read)
+    output logic [31:0] mem_addr,
+    input  logic [31:0] mem_rdata,
+
+    // Counters
+    output logic [31:0] stat_hits,
+    output logic [31:0] stat_misses,
+    output logic [31:0] stat_refills
+);
+    localparam WORD_BITS = $clog2(LINE_WORDS);
+    localparam SET_BITS  = $clog2(SETS);
+    localparam OFF_BITS  = WORD_BITS + 2;
+    localparam TAG_BITS  = 32 - OFF_BITS - SET_BITS;
+    localparam WAY_BITS  = $clog2(WAYS);
+    localparam WAY_W     = (WAYS > 1) ? WAY_BITS : 1;
+    localparam PLRU_W    = (WAYS > 1) ? WAYS - 1 : 1;
+
+    localparam REPL_LRU    = 0;
+    localparam REPL_PLRU   = 1;
+    localparam REPL_RANDOM = 2;
+
+    typedef enum logic {
+        IDLE   = 1'b0,
+        REFILL = 1'b1
+    } cache_states;
+
+    logic                valid [0:SETS-1][0:WAYS-1];
+    logic [TAG_BITS-1:0] tags  [0:SETS-1][0:WAYS-1];
+    logic [31:0]         data  [0:SETS-1][0:WAYS-1][0:LINE_WORDS-1];
+    logic [WAY_W-1:0]    age   [0:SETS-1][0:WAYS-1];   // LRU: 0 = most recent
+    logic [PLRU_W-1:0]   plru  [0:SETS-1];             // PLRU: 1 = victim is right
+    logic [15:0]         lfsr;
+
+    // Refill
+    cache_states          state;
+    logic [SET_BITS-1:0]  fill_set;
+    logic [TAG_BITS-1:0]  fill_tag;
+    logic [WAY_W-1:0]     fill_way;
+    logic [WORD_BITS-1:0] fill_word;
+    logic [31:0]          lat_cnt;
+
+    // ==================================
+    // LOOKUP
+    // ==================================
+    logic [SET_BITS-1:0]  set;
+    logic [TAG_BITS-1:0]  tag;
+    logic [WORD_BITS-1:0] word;
+    logic [WAY_W-1:0]     hit_way;
+
+    always_comb begin
+        set     = pc[OFF_BITS +: SET_BITS];
+        tag     = pc[31 -: TAG_BITS];
+        word    = pc[2 +: WORD_BITS];
+        hit     = 1'b0;
+        hit_way = '0;
+        for (int w = 0; w < WAYS; w++) begin
+            if (valid[set][w] && tags[set][w] == tag) begin
+                hit     = 1'b1;
+                hit_way = WAY_W'(w);
+            end
+        end
+        instr = data[set][hit_way][word];
+    end
+
+    // ==================================
+    // REPLACEMENT
+    // ==================================
+    logic [WAY_W-1:0]  victim;
+    logic [WAY_W-1:0]  age_next [0:WAYS-1];
+    logic [PLRU_W-1:0] plru_next;
+    int                node;
+
+    always_comb begin
+        // Victim for a miss in `set`
+        victim = '0;
+        node   = 0;
+        case (REPL)
+            REPL_PLRU: begin
+                for (int l = 0; l < WAY_BITS; l++) begin
+                    victim = WAY_W'({victim, plru[set][node]});
+                    node   = 2 * node + 1 + int'(plru[set][node]);
+                end
+            end
+            REPL_RANDOM: victim = (WAYS > 1) ? WAY_W'(lfsr) : '0;
+            default: begin
+                for (int w = 0; w < WAYS; w++)
+                    if (age[set][w] == WAY_W'(WAYS - 1))
+                        victim = WAY_W'(w);
+            end
+        endcase
+        for (int w = WAYS - 1; w >= 0; w--)
+            if (!valid[set][w])
+                victim = WAY_W'(w);
+
+        // Recency update for a hit on `hit_way`
+        for (int w = 0; w < WAYS; w++)
+            age_next[w] = (age[set][w] < age[set][hit_way]) ? age[set][w] + 1'b1 : age[set][w];
+        age_next[hit_way] = '0;
+
+        plru_next = plru[set];
+        node      = 0;
+        for (int l = 0; l < WAY_BITS; l++) begin
+            plru_next[node] = !hit_way[WAY_BITS - 1 - l];
+            node            = 2 * node + 1 + int'(hit_way[WAY_BITS - 1 - l]);
+        end
+    end
+
+    // ==================================
+    // UPDATE AND REFILL
+    // ==================================
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            for (int s = 0; s < SETS; s++) begin
+                for (int w = 0; w < WAYS; w++) begin
+                    valid[s][w] <= 1'b0;
+                    age[s][w]   <= WAY_W'(w);
+                end
+                plru[s] <= '0;
+            end
+            lfsr         <= 16'hACE1;
+            state        <= IDLE;
+            fill_set     <= '0;
+            fill_tag     <= '0;
+            fill_way     <= '0;
+            fill_word    <= '0;
+            lat_cnt      <= 32'b0;
+            stat_hits    <= 32'b0;
+            stat_misses  <= 32'b0;
+            stat_refills <= 32'b0;
+        end else begin
+            lfsr <= {lfsr[14:0], lfsr[15] ^ lfsr[13] ^ lfsr[12] ^ lfsr[10]};
+
+            if (req && hit) begin
+                stat_hits <= stat_hits + 1;
+                if (REPL == REPL_LRU)
+                    for (int w = 0; w < WAYS; w++)
+                        age[set][w] <= age_next[w];
+                if (REPL == REPL_PLRU)
+                    plru[set] <= plru_next;
+            end
+
+            case (state)
+                IDLE: begin
+                    if (req && !hit) begin
+                        // Invalidate the victim now so a partly refilled line never hits
+                        valid[set][victim] <= 1'b0;
+                        fill_set    <= set;
+                        fill_tag    <= tag;
+                        fill_way    <= victim;
+                        fill_word   <= '0;
+                        lat_cnt     <= MISS_LATENCY;
+                        state       <= REFILL;
+                        stat_misses <= stat_misses + 1;
+                    end
+                end
+
+                REFILL: begin
+                    if (lat_cnt != 0)
+                        lat_cnt <= lat_cnt - 1;
+                    else begin
+                        data[fill_set][fill_way][fill_word] <= mem_rdata;
+                        fill_word <= fill_word + 1'b1;
+                        if (fill_word == WORD_BITS'(LINE_WORDS - 1)) begin
+                            valid[fill_set][fill_way] <= 1'b1;
+                            tags[fill_set][fill_way]  <= fill_tag;
+                            state        <= IDLE;
+                            stat_refills <= stat_refills + 1;
+                        end
+                    end
+                end
+
+                default: state <= IDLE;
+            endcase
+        end
+    end
+
+    assign mem_addr = {fill_tag, fill_set, fill_word, 2'b00};
+
+endmodule
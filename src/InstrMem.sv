@@ -1,32 +1,77 @@
 module InstrMem#(
     parameter WORDS = 128,
-    parameter mem_init = "./src/InstrMem_test.mem"
+    parameter mem_init = "./src/InstrMem_test.mem",
+    parameter LITTLE_ENDIAN = 0,    // 1: byte 0 is the low byte (needed for RV32C parcels)
+    parameter SYNC_READ = 0         // 1: registered read (block RAM): instr is the word at
+                                    //    the address of the previous clock edge
 ) (
-    input logic [31:0] address,
-    output logic [31:0] instr
+    /* verilator lint_off UNUSEDSIGNAL */
+    input logic clk,                // only used with SYNC_READ
+    input logic [31:0] address,     // word aligned: bits 1:0 are ignored
+    /* verilator lint_on UNUSEDSIGNAL */
+    output logic [31:0] instr,
+    output logic [31:0] instr_next  // the word after it: a 64-bit fetch (RV32I_Dual)
 );
+    localparam IDX_W = (WORDS > 1) ? $clog2(WORDS) : 1;
 
-    // Memory array: stores bytes, total size is WORDS * 4 bytes
-    reg [7:0] mem[0:(WORDS * 4) - 1];
+    // Memory array: one 32-bit word per entry, so a read is one array access
+    // and the array maps onto block RAM or LUT RAM. Byte 0 of a word is
+    // bits 7:0 and the word holds the instruction as fetched.
+    // Public so the testbench program loaders can write it directly.
+    logic [31:0] mem[0:WORDS - 1] /*verilator public_flat_rw*/;
+
+    // .mem images stay one byte per entry, most significant byte of each
+    // word first (least significant first with LITTLE_ENDIAN), and are
+    // packed into words here.
+    logic [7:0] init_bytes[0:(WORDS * 4) - 1];
 
     initial begin
+        for (int i = 0; i < (WORDS * 4); i = i + 1) begin
+            init_bytes[i] = 8'h00;
+        end
         if (mem_init != "") begin
             // Load memory contents from a hex file
-            $readmemh(mem_init, mem);
-        end else begin
-            // Otherwise, initialize all memory locations to zero
-            for (int i = 0; i < (WORDS * 4); i = i + 1) begin
-                mem[i] = 8'h00;
-            end
+            $readmemh(mem_init, init_bytes);
+        end
+        for (int i = 0; i < WORDS; i = i + 1) begin
+            if (LITTLE_ENDIAN)
+                mem[i] = {init_bytes[4*i + 3], init_bytes[4*i + 2], init_bytes[4*i + 1], init_bytes[4*i + 0]};
+            else
+                mem[i] = {init_bytes[4*i + 0], init_bytes[4*i + 1], init_bytes[4*i + 2], init_bytes[4*i + 3]};
         end
     end
 
-    always_comb begin
-        // Read w/ EOF Flag
-        instr = (address + 3) >= (WORDS * 4) ? 32'hDEADBEEF : {mem[address + 0],
-                                                                mem[address + 1],
-                                                                mem[address + 2],
-                                                                mem[address + 3]};
-    end
+    logic [IDX_W-1:0] index, index_next;
+    logic             in_range, in_range_next;
+    assign index         = address[IDX_W + 1:2];
+    assign index_next    = index + 1'b1;
+    assign in_range      = address < WORDS * 4;
+    assign in_range_next = address < (WORDS - 1) * 4;
+
+    // The words read, and whether their addresses were in range: straight
+    // from the array, or registered for a synchronous read. The second read
+    // port is only built when instr_next is used.
+    logic [31:0] rword, rword_next;
+    logic        rvalid, rvalid_next;
+
+    generate
+        if (SYNC_READ) begin : g_syncRead
+            always_ff @(posedge clk) begin
+                rword       <= mem[index];
+                rvalid      <= in_range;
+                rword_next  <= mem[index_next];
+                rvalid_next <= in_range_next;
+            end
+        end else begin : g_asyncRead
+            assign rword       = mem[index];
+            assign rvalid      = in_range;
+            assign rword_next  = mem[index_next];
+            assign rvalid_next = in_range_next;
+        end
+    endgenerate
+
+    // Read w/ EOF Flag
+    assign instr      = rvalid ? rword : 32'hDEADBEEF;
+    assign instr_next = rvalid_next ? rword_next : 32'hDEADBEEF;
 
 endmodule
@@ -0,0 +1,16 @@
+module MUXQuad (
+    input  logic  [31:0] A, B, C, D,
+    input  logic  [1:0]  sel,
+    output logic [31:0] OUT
+);
+
+    always_comb begin
+        case (sel)
+            2'b01:   OUT = B;
+            2'b10:   OUT = C;
+            2'b11:   OUT = D;
+            default: OUT = A;
+        endcase
+    end
+
+endmodule
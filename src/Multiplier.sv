@@ -0,0 +1,31 @@
+// Single-cycle multiplier for the M extension. `op` is func3[1:0]:
+//   00 MUL     low 32 bits of the product
+//   01 MULH    high 32 bits, signed x signed
+//   10 MULHSU  high 32 bits, signed x unsigned
+//   11 MULHU   high 32 bits, unsigned x unsigned
+
+module Multiplier (
+    input  logic [31:0] src1, src2,
+    input  logic [1:0]  op,
+    output logic [31:0] result
+);
+
+    typedef enum logic [1:0] {
+        MUL    = 2'b00,
+        MULH   = 2'b01,
+        MULHSU = 2'b10,
+        MULHU  = 2'b11
+    } mul_ops;
+
+    logic signed [32:0] a, b;
+    logic signed [65:0] product;
+
+    always_comb begin
+        // One 33x33 signed multiply covers all four: sign- or zero-extend
+        a       = {op != MULHU && src1[31], src1};
+        b       = {(op == MUL || op == MULH) && src2[31], src2};
+        product = a * b;
+        result  = (op == MUL) ? product[31:0] : product[63:32];
+    end
+
+endmodule
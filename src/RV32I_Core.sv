@@ -2,11 +2,63 @@ module RV32I_Core #(
     parameter IMEM_WORDS = 128,
     parameter DMEM_WORDS = 128,
     parameter IMEM_INIT  = "./src/RV32I_TestProg.mem",
-    parameter DMEM_INIT  = ""
+    parameter DMEM_INIT  = "",
+    parameter NUM_HPM    = 5,
+    parameter BPRED      = 0,    // 1: run BranchPredictor in shadow mode on the fetch path
+    parameter BP_GHR_BITS     = 6,   // its global history length; 0 = bimodal
+    parameter ICACHE     = 0,    // 1: fetch through ICache, stalling on misses
+    parameter IC_SETS         = 8,
+    parameter IC_WAYS         = 2,
+    parameter IC_LINE_WORDS   = 4,
+    parameter IC_REPL         = 0,
+    parameter IC_MISS_LATENCY = 8,
+    parameter DCACHE     = 0,    // 1: loads/stores go through DCache, stalling on misses
+    parameter DC_SETS         = 8,
+    parameter DC_WAYS         = 2,
+    parameter DC_LINE_WORDS   = 4,
+    parameter DC_MISS_LATENCY = 8,
+    parameter COMPRESSED = 0,    // 1: RV32C (halfword PCs, little-endian InstrMem image)
+    parameter DMEM_SPARSE = 0,   // 1: DataMemSparse (C++ page table over DPI, full 32-bit space)
+    parameter TOHOST      = 0,   // 1: a store of (code << 1) | 1 to TOHOST_ADDR ends the run
+    parameter TOHOST_ADDR = DMEM_WORDS * 4 - 4,
+    parameter HART_ID     = 0,   // mhartid
+    parameter EXT_DMEM    = 0,   // 1: no DataMem; loads/stores go out on dbus_* (RV32I_SoC)
+    parameter IMEM_SYNC   = 0,   // 1: synchronous-read (block RAM) InstrMem, read a cycle ahead
+    parameter DMEM_SYNC   = 0,   // 1: synchronous-read (block RAM) DataMem, loads take 2 cycles
+    parameter TRAPS       = 0,   // 1: M-mode traps, MRET/WFI, interrupts and a CLINT at CLINT_BASE
+    parameter logic [31:0] CLINT_BASE = 32'h02000000    // 64 KiB window
 ) (
     input  logic        clk,
     input  logic        rst,
+    /* verilator lint_off UNUSEDSIGNAL */
+    input  logic        irq_external,       // MEIP, level-sensitive (TRAPS=1)
+    /* verilator lint_on UNUSEDSIGNAL */
     output logic        illegal_op,
+    output logic        sim_exit,           // ECALL/EBREAK or a tohost write retires this cycle
+    output logic [31:0] sim_exit_code,      // a0 for ECALL/EBREAK, the tohost value >> 1
+    // Retirement trace (tb/common/commit_log.h): valid for one cycle per
+    // retired instruction
+    output logic        retire_valid,
+    output logic [31:0] retire_pc,
+    output logic [31:0] retire_instr,       // as fetched; 16-bit RVC parcels zero-extended
+    output logic [4:0]  retire_rd,          // 0: no register write
+    output logic [31:0] retire_rd_wdata,
+    output logic [3:0]  retire_mem_mask,    // bytes accessed from retire_mem_addr, 0: none
+    output logic        retire_mem_wen,
+    output logic [31:0] retire_mem_addr,
+    output logic [31:0] retire_mem_wdata,   // store data, masked to retire_mem_mask
+    // Data bus to a shared memory (EXT_DMEM=1). DataMem semantics: the
+    // read data is combinational, the write lands on the clock edge. The
+    // access is held, stalling the core, until dbus_gnt.
+    output logic        dbus_req,
+    output logic        dbus_wen,
+    output logic [31:0] dbus_addr,
+    output logic [31:0] dbus_wdata,
+    output logic [2:0]  dbus_byte_mask,
+    /* verilator lint_off UNUSEDSIGNAL */
+    input  logic [31:0] dbus_rdata,         // unused unless EXT_DMEM
+    input  logic        dbus_gnt,
+    /* verilator lint_on UNUSEDSIGNAL */
     output logic [31:0] debug_pc,
     output logic [31:0] debug_instr,
     output logic [31:0] debug_reg_wdata,
@@ -16,39 +68,84 @@ module RV32I_Core #(
     output logic [31:0] debug_mem_rdata,
     output logic [31:0] debug_next_pc,
     output logic        debug_pc_src_sel,
-    output logic [3:0]  debug_alu_ctrl,
-    output logic        debug_reg_wen
+    output logic [5:0]  debug_alu_ctrl,
+    output logic        debug_reg_wen,
+    output logic        debug_mem_wen,
+    output logic [63:0] debug_cycle,
+    output logic [63:0] debug_instret,
+    output logic [NUM_HPM*64-1:0] debug_hpmcounter,
+    output logic [31:0] debug_bp_branches,
+    output logic [31:0] debug_bp_branch_miss,
+    output logic [31:0] debug_bp_jumps,
+    output logic [31:0] debug_bp_jump_miss,
+    output logic        debug_fetch_stall,
+    output logic [31:0] debug_ic_hits,
+    output logic [31:0] debug_ic_misses,
+    output logic [31:0] debug_ic_refills,
+    output logic        debug_mem_stall,
+    output logic [31:0] debug_dc_hits,
+    output logic [31:0] debug_dc_misses,
+    output logic [31:0] debug_dc_writebacks,
+    output logic        debug_div_stall,
+    output logic        debug_trap,         // a trap is taken: the handler is the next PC
+    output logic [31:0] debug_trap_cause,
+    output logic [2:0]  debug_mip           // {MEIP, MTIP, MSIP}
 );
+    localparam NOP      = 32'h00000013;     // addi x0, x0, 0
+    localparam OP_FENCE = 7'b0001111;
+
     // ==================================
     // INTERNAL WIRES
     // ==================================
     // IF
-    logic [31:0] next_pc, pc, pc_plus_4;
-    logic [31:0] instr;
+    logic [31:0] next_pc, resolved_pc, pc, pc_step, pc_seq;
+    logic [31:0] instr, fetch_instr, fetch_raw;
+    logic [31:0] imem_addr, imem_rdata;
+    logic [31:0] fetch_addr, fetch_word;
+    logic        fetch_hit, fetch_ok;
+    logic        fetch_stall, mem_stall, div_stall, wfi_stall, stall;
     
     // ID
     logic [31:0] immediate;
-    /* verilator lint_off UNOPTFLAT */
     logic [31:0] reg_wdata;
-    /* verilator lint_on UNOPTFLAT */
     logic [31:0] reg_rdata1, reg_rdata2;
     
     // CONTROLLER OUTPUTS
     logic reg_wen;
     logic alu_pc_sel, alu_imm_sel;
-    logic [3:0] alu_ctrl;
+    logic [5:0] alu_ctrl;
     logic mem_wen;
     logic [1:0] wb_sel;
+    logic csr_en;
+    logic muldiv_en;
+    logic ctrl_illegal, op_illegal;
+    logic sys_exit;
+    logic mret, wfi;
     
     logic pc_src_sel;
     
     // EX
     logic [2:0] branch_cond;
     logic [31:0] alu_src1, alu_src2, alu_result;
+    logic [31:0] mul_result, div_result, muldiv_result, ex_result;
 
     // MEM
     logic [2:0]  byte_mask;
-    logic [31:0] mem_rdata;
+    logic [31:0] mem_rdata, data_rdata, clint_rdata;
+    logic        mem_access, clint_sel;
+
+    // CSR
+    logic [31:0] csr_rdata;
+    logic        csr_illegal;
+    logic [4:0]  hpm_events;
+    logic [63:0] csr_time;
+
+    // TRAPS
+    logic        trap_en, exception, interrupt, take_trap;
+    logic        irq_pending, irq_wake, handler_set;
+    logic [2:0]  irq;
+    logic [31:0] trap_cause, irq_cause, trap_epc, trap_tval;
+    logic [31:0] trap_vector, trap_mepc, redirect_pc, flow_pc;
 
     // ==================================
     // INSTRUCTION FETCH (NEEDS PC INPUT FROM TRI STATE MUX -- UPDATE CONTROLLER!!!)
@@ -59,25 +156,141 @@ module RV32I_Core #(
         .pc(pc)
     );
 
+    // pc_step is 2 after a compressed instruction, 4 otherwise
     Adder u_pcIncr (
-        .src1(pc), .src2(32'd4),
-        .result(pc_plus_4)
+        .src1(pc), .src2(pc_step),
+        .result(pc_seq)
     );
 
     MUX pcSel (
-        .A(pc_plus_4), .B(alu_result),
+        .A(pc_seq), .B(alu_result),
         .sel(pc_src_sel),
+        .OUT(resolved_pc)
+    );
+
+    // Traps go to the handler, MRET back to mepc
+    MUX u_trapTarget (
+        .A(trap_mepc), .B(trap_vector),
+        .sel(take_trap),
+        .OUT(redirect_pc)
+    );
+
+    MUX u_trapSel (
+        .A(resolved_pc), .B(redirect_pc),
+        .sel(take_trap || (mret && !stall)),
+        .OUT(flow_pc)
+    );
+
+    // Hold the PC while a cache refills, the divider runs or WFI waits
+    assign stall = fetch_stall || mem_stall || div_stall || wfi_stall;
+
+    MUX u_pcHold (
+        .A(flow_pc), .B(pc),
+        .sel(stall),
         .OUT(next_pc)
     );
 
+    generate
+        if (IMEM_SYNC && (ICACHE || COMPRESSED)) begin : g_checkImemSync
+            $error("IMEM_SYNC needs ICACHE=0 and COMPRESSED=0: only a plain fetch knows its next address a cycle ahead");
+        end
+    endgenerate
+
     InstrMem #(
         .WORDS(IMEM_WORDS),
-        .mem_init(IMEM_INIT)
+        .mem_init(IMEM_INIT),
+        .LITTLE_ENDIAN(COMPRESSED),
+        .SYNC_READ(IMEM_SYNC)
     ) u_instrMem (
-        .address(pc),
-        .instr(instr)
+        .clk(clk),
+        .address(imem_addr),
+        .instr(imem_rdata),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .instr_next()
+        /* verilator lint_on PINCONNECTEMPTY */
     );
 
+    // With the I-cache, InstrMem is the backing memory. Fetch reads one
+    // aligned word per cycle from either.
+    generate
+        if (ICACHE) begin : g_icache
+            ICache #(
+                .SETS(IC_SETS), .WAYS(IC_WAYS), .LINE_WORDS(IC_LINE_WORDS),
+                .REPL(IC_REPL), .MISS_LATENCY(IC_MISS_LATENCY)
+            ) u_iCache (
+                .clk(clk), .rst(rst),
+                .req(1'b1), .pc(fetch_addr),
+                .instr(fetch_word), .hit(fetch_hit),
+                .mem_addr(imem_addr), .mem_rdata(imem_rdata),
+                .stat_hits(debug_ic_hits), .stat_misses(debug_ic_misses),
+                .stat_refills(debug_ic_refills)
+            );
+        end else begin : g_no_icache
+            // A synchronous InstrMem is addressed with the PC's next value
+            // (0 in reset), so the word is there when the PC is.
+            assign imem_addr        = IMEM_SYNC ? (rst ? next_pc : 32'b0) : fetch_addr;
+            assign fetch_word       = imem_rdata;
+            assign fetch_hit        = 1'b1;
+            assign debug_ic_hits    = 32'b0;
+            assign debug_ic_misses  = 32'b0;
+            assign debug_ic_refills = 32'b0;
+        end
+    endgenerate
+
+    // RV32C: FetchAlign assembles the instruction at a halfword PC (one
+    // extra cycle when it straddles two words) and RVCExpander turns a
+    // 16-bit parcel into its RV32I equivalent, so decode is unchanged.
+    generate
+        if (COMPRESSED) begin : g_rvc
+            logic [31:0] fetch_window, rvc_instr;
+            logic        is_c;
+
+            FetchAlign u_fetchAlign (
+                .clk(clk), .rst(rst),
+                .pc(pc), .advance(!stall),
+                .fetch_addr(fetch_addr), .fetch_word(fetch_word), .fetch_valid(fetch_hit),
+                .window(fetch_window), .valid(fetch_ok)
+            );
+
+            RVCExpander u_rvcExpander (
+                .cinstr(fetch_window[15:0]),
+                .instr(rvc_instr)
+            );
+
+            assign is_c = fetch_window[1:0] != 2'b11;
+
+            MUX u_rvcSel (
+                .A(fetch_window), .B(rvc_instr),
+                .sel(is_c),
+                .OUT(fetch_instr)
+            );
+
+            assign fetch_raw = is_c ? {16'b0, fetch_window[15:0]} : fetch_window;
+
+            MUX u_pcStep (
+                .A(32'd4), .B(32'd2),
+                .sel(is_c),
+                .OUT(pc_step)
+            );
+        end else begin : g_no_rvc
+            assign fetch_addr  = pc;
+            assign fetch_instr = fetch_word;
+            assign fetch_raw   = fetch_word;
+            assign fetch_ok    = fetch_hit;
+            assign pc_step     = 32'd4;
+        end
+    endgenerate
+
+    // A fetch stall executes a NOP in place of the instruction, which
+    // leaves no architectural state.
+    MUX u_stallNop (
+        .A(NOP), .B(fetch_instr),
+        .sel(fetch_ok),
+        .OUT(instr)
+    );
+
+    assign fetch_stall = !fetch_ok;
+
     // ==================================
     // DECODE 
     // ==================================
@@ -85,22 +298,45 @@ module RV32I_Core #(
         .instr(instr), .immediate(immediate)
     );
 
-    RegFile u_regFile (
-        .clk(clk), .rst(rst), .wen(reg_wen),
-        .rsrc1(instr[19:15]), .rsrc2(instr[24:20]), .wdest(instr[11:7]),
+    // ECALL/EBREAK read a0 (the exit code) through the rs1 port
+    logic [4:0] rsrc1;
+    assign rsrc1 = sys_exit ? 5'd10 : instr[19:15];
+
+    // No write forwarding: the write lands on the clock edge, so the
+    // reg_wdata -> rdata path would only form a combinational loop.
+    RegFile #(
+        .WRITE_FWD(0)
+    ) u_regFile (
+        .clk(clk), .rst(rst), .wen(reg_wen && !csr_illegal && !mem_stall && !div_stall),
+        .rsrc1(rsrc1), .rsrc2(instr[24:20]), .wdest(instr[11:7]),
         .wdata(reg_wdata),
         .rdata1(reg_rdata1), .rdata2(reg_rdata2)
     );
 
-    Controller u_controller (
-        .opcode(instr[6:0]), .func7(instr[31:25]), .func3(instr[14:12]),
+    Controller #(
+        .TRAPS(TRAPS)
+    ) u_controller (
+        .opcode(instr[6:0]), .func7(instr[31:25]), .func3(instr[14:12]), .rs2(instr[24:20]),
+        .rs1(instr[19:15]), .rd(instr[11:7]),
         .alu_ctrl(alu_ctrl),
         .branch_cond(branch_cond),
         .byte_mask(byte_mask), .wb_sel(wb_sel), .reg_wen(reg_wen),
         .alu_pc_sel(alu_pc_sel), .alu_imm_sel(alu_imm_sel), .mem_wen(mem_wen),
-        .illegal_op(illegal_op)
+        .csr_en(csr_en), .muldiv_en(muldiv_en), .illegal_op(ctrl_illegal),
+        .sys_exit(sys_exit), .mret(mret), .wfi(wfi)
     );
 
+    // An illegal instruction halts the core unless it traps
+    assign op_illegal = ctrl_illegal || csr_illegal;
+    assign illegal_op = op_illegal && !trap_en;
+
+    // Program exit: ECALL/EBREAK, or a tohost store in the HTIF format
+    // (bit 0 set, exit code above it). The testbench stops on sim_exit.
+    logic tohost_exit;
+    assign tohost_exit   = TOHOST != 0 && mem_wen && alu_result == TOHOST_ADDR && reg_rdata2[0];
+    assign sim_exit      = ((sys_exit && !trap_en) || tohost_exit) && !stall;
+    assign sim_exit_code = sys_exit ? reg_rdata1 : {1'b0, reg_rdata2[31:1]};
+
     // ==================================
     // EXECUTE
     // ==================================
@@ -127,24 +363,277 @@ module RV32I_Core #(
         .result(alu_result)
     );
 
+    // M extension: single-cycle multiply, iterative divide that holds the
+    // instruction (PC, register write, counters) until its result is ready
+    Multiplier u_multiplier (
+        .src1(reg_rdata1), .src2(reg_rdata2),
+        .op(instr[13:12]),
+        .result(mul_result)
+    );
+
+    logic div_ready;
+
+    Divider u_divider (
+        .clk(clk), .rst(rst),
+        .req(muldiv_en && instr[14]), .op(instr[13:12]),
+        .src1(reg_rdata1), .src2(reg_rdata2),
+        .hold(mem_stall),
+        .result(div_result), .ready(div_ready)
+    );
+
+    assign div_stall = !div_ready;
+
+    MUX u_mulDivSel (
+        .A(mul_result), .B(div_result),
+        .sel(instr[14]),
+        .OUT(muldiv_result)
+    );
+
+    MUX u_exResultSel (
+        .A(alu_result), .B(muldiv_result),
+        .sel(muldiv_en),
+        .OUT(ex_result)
+    );
+
     // ==================================
     // MEMORY
     // ==================================
-    DataMem #(
-        .WORDS(DMEM_WORDS),
-        .mem_init(DMEM_INIT)
-    ) u_dataMem (
-        .clk(clk), .wen(mem_wen),
-        .address(alu_result), .wdata(reg_rdata2),
-        .byte_mask(byte_mask),
-        .rdata(mem_rdata)
+    logic [31:0] dmem_addr, dmem_wdata, dmem_rdata;
+    logic [2:0]  dmem_byte_mask;
+    logic        dmem_wen;
+
+    // Loads and stores in the CLINT window go to the CLINT instead
+    assign mem_access = mem_wen || wb_sel == 2'd1;
+    assign clint_sel  = TRAPS != 0 && mem_access && alu_result[31:16] == CLINT_BASE[31:16];
+
+    generate
+        if (EXT_DMEM) begin : g_extDataMem
+            if (DCACHE) begin : g_check
+                $error("EXT_DMEM needs DCACHE=0: the shared memory takes DataMem's byte-masked accesses");
+            end
+            if (DMEM_SYNC) begin : g_checkSync
+                $error("DMEM_SYNC needs EXT_DMEM=0: the shared memory reads asynchronously");
+            end
+            assign dbus_req       = mem_access && !clint_sel;
+            assign dbus_wen       = dmem_wen;
+            assign dbus_addr      = dmem_addr;
+            assign dbus_wdata     = dmem_wdata;
+            assign dbus_byte_mask = dmem_byte_mask;
+            assign dmem_rdata     = dbus_rdata;
+        end else if (DMEM_SPARSE) begin : g_dataMemSparse
+            if (DMEM_SYNC) begin : g_checkSync
+                $error("DMEM_SYNC needs DMEM_SPARSE=0: DataMemSparse reads asynchronously");
+            end
+            DataMemSparse #(
+                .mem_init(DMEM_INIT)
+            ) u_dataMem (
+                .clk(clk), .wen(dmem_wen),
+                .address(dmem_addr), .wdata(dmem_wdata),
+                .byte_mask(dmem_byte_mask),
+                .rdata(dmem_rdata)
+            );
+        end else begin : g_dataMem
+            DataMem #(
+                .WORDS(DMEM_WORDS),
+                .mem_init(DMEM_INIT),
+                .SYNC_READ(DMEM_SYNC)
+            ) u_dataMem (
+                .clk(clk), .wen(dmem_wen),
+                .address(dmem_addr), .wdata(dmem_wdata),
+                .byte_mask(dmem_byte_mask),
+                .rdata(dmem_rdata)
+            );
+        end
+
+        if (!EXT_DMEM) begin : g_no_dbus
+            assign dbus_req       = 1'b0;
+            assign dbus_wen       = 1'b0;
+            assign dbus_addr      = 32'b0;
+            assign dbus_wdata     = 32'b0;
+            assign dbus_byte_mask = 3'b0;
+        end
+    endgenerate
+
+    // With the D-cache, DataMem is the word-wide backing memory. A miss
+    // holds the whole instruction (PC, register write, counters) until the
+    // line is in; FENCE writes back and invalidates the cache.
+    generate
+        if (DCACHE) begin : g_dcache
+            logic dc_ready;
+
+            DCache #(
+                .SETS(DC_SETS), .WAYS(DC_WAYS), .LINE_WORDS(DC_LINE_WORDS),
+                .MISS_LATENCY(DC_MISS_LATENCY)
+            ) u_dCache (
+                .clk(clk), .rst(rst),
+                .req(mem_access && !clint_sel), .wen(mem_wen && !clint_sel),
+                .address(alu_result), .wdata(reg_rdata2),
+                .byte_mask(byte_mask),
+                .rdata(data_rdata),
+                .flush(instr[6:0] == OP_FENCE), .ready(dc_ready),
+                .mem_addr(dmem_addr), .mem_wdata(dmem_wdata),
+                .mem_wen(dmem_wen), .mem_rdata(dmem_rdata),
+                .stat_hits(debug_dc_hits), .stat_misses(debug_dc_misses),
+                .stat_writebacks(debug_dc_writebacks)
+            );
+
+            if (DMEM_SYNC) begin : g_checkSync
+                $error("DMEM_SYNC needs DCACHE=0: DCache refills from an asynchronous DataMem");
+            end
+
+            assign dmem_byte_mask = 3'b010;     // LW
+            assign mem_stall      = !dc_ready;
+        end else begin : g_no_dcache
+            assign dmem_addr           = alu_result;
+            assign dmem_wdata          = reg_rdata2;
+            assign dmem_wen            = mem_wen && !clint_sel;
+            assign dmem_byte_mask      = byte_mask;
+            assign data_rdata          = dmem_rdata;
+            // A synchronous DataMem has a load's word a cycle after its
+            // address: the first cycle of every load stalls.
+            logic load_done;
+            if (DMEM_SYNC) begin : g_syncLoad
+                always_ff @(posedge clk) begin
+                    if (!rst)
+                        load_done <= 1'b0;
+                    else
+                        load_done <= wb_sel == 2'd1 && !load_done;
+                end
+            end else begin : g_asyncLoad
+                assign load_done = 1'b1;
+            end
+
+            // A shared memory stalls the access until the arbiter grants it
+            assign mem_stall           = (EXT_DMEM != 0 && dbus_req && !dbus_gnt) ||
+                                         (wb_sel == 2'd1 && !load_done);
+            assign debug_dc_hits       = 32'b0;
+            assign debug_dc_misses     = 32'b0;
+            assign debug_dc_writebacks = 32'b0;
+        end
+    endgenerate
+
+    MUX u_clintSel (
+        .A(data_rdata), .B(clint_rdata),
+        .sel(clint_sel),
+        .OUT(mem_rdata)
     );
 
+    generate
+        if (TRAPS) begin : g_clint
+            logic msip, mtip;
+
+            CLINT u_clint (
+                .clk(clk), .rst(rst),
+                .sel(clint_sel && !stall), .wen(mem_wen),
+                .offset(alu_result[15:0]), .wdata(reg_rdata2),
+                .rdata(clint_rdata),
+                .mtime(csr_time),
+                .msip(msip), .mtip(mtip)
+            );
+
+            assign irq = {irq_external, mtip, msip};
+        end else begin : g_no_clint
+            assign clint_rdata = 32'b0;
+            assign irq         = 3'b0;
+        end
+    endgenerate
+
+    // ==================================
+    // BRANCH PREDICTION (shadow mode)
+    // ==================================
+    // A single-cycle core always knows next_pc, so the predictor only
+    // looks up the fetch PC and is scored against the resolved next_pc.
+    generate
+        if (BPRED) begin : g_bpred
+            logic        bp_taken;
+            logic [31:0] bp_target, bp_next_pc;
+            logic [(BP_GHR_BITS > 0 ? BP_GHR_BITS : 1)-1:0] bp_ghr;    // predicted and resolved in the same cycle
+
+            BranchPredictor #(
+                .GHR_BITS(BP_GHR_BITS),
+                .COMPRESSED(COMPRESSED)
+            ) u_branchPredictor (
+                .clk(clk), .rst(rst),
+                .pc(pc),
+                .pred_taken(bp_taken), .pred_target(bp_target), .pred_ghr(bp_ghr),
+                .upd_valid(!op_illegal && !stall), .upd_pc(pc), .upd_seq_pc(pc_seq), .upd_instr(instr),
+                .upd_taken(pc_src_sel), .upd_target(alu_result), .upd_ghr(bp_ghr),
+                .upd_mispredict(bp_next_pc != next_pc),
+                .stat_branches(debug_bp_branches), .stat_branch_miss(debug_bp_branch_miss),
+                .stat_jumps(debug_bp_jumps), .stat_jump_miss(debug_bp_jump_miss)
+            );
+
+            assign bp_next_pc = bp_taken ? bp_target : pc_seq;
+        end else begin : g_no_bpred
+            assign debug_bp_branches    = 32'b0;
+            assign debug_bp_branch_miss = 32'b0;
+            assign debug_bp_jumps       = 32'b0;
+            assign debug_bp_jump_miss   = 32'b0;
+        end
+    endgenerate
+
+    // ==================================
+    // CSR (performance counters)
+    // ==================================
+    // Events: {illegal op, jump, store, load, taken branch}
+    // A load/store waiting on the D-cache is counted once, when it completes
+    assign hpm_events = (mem_stall || div_stall) ? 5'b0 : {
+        op_illegal,
+        wb_sel == 2'd2,                             // JAL/JALR write back the return address
+        mem_wen,
+        wb_sel == 2'd1,
+        pc_src_sel && branch_cond != 3'b111         // conditional branch taken
+    };
+
+    CSRFile #(
+        .NUM_HPM(NUM_HPM),
+        .HART_ID(HART_ID),
+        .TRAPS(TRAPS)
+    ) u_csrFile (
+        .clk(clk), .rst(rst),
+        .csr_en(csr_en), .csr_op(instr[14:12]), .csr_addr(instr[31:20]),
+        .csr_zimm(instr[19:15]), .csr_src(reg_rdata1),
+        .csr_rdata(csr_rdata), .csr_illegal(csr_illegal),
+        .retire(!op_illegal && !stall && !exception), .events(hpm_events),
+        .irq(irq), .trap_enter(take_trap), .trap_cause(trap_cause),
+        .trap_epc(trap_epc), .trap_tval(trap_tval), .mret(mret && !stall),
+        .irq_pending(irq_pending), .irq_cause(irq_cause), .irq_wake(irq_wake),
+        .trap_vector(trap_vector), .trap_mepc(trap_mepc), .handler_set(handler_set),
+        .debug_cycle(debug_cycle), .debug_time(csr_time),
+        .debug_instret(debug_instret), .debug_hpmcounter(debug_hpmcounter)
+    );
+
+    // ==================================
+    // TRAPS (M mode)
+    // ==================================
+    // Nothing traps until mtvec is set: with mtvec = 0, ECALL/EBREAK still
+    // end the run and an illegal instruction halts, as with TRAPS = 0.
+    // Exceptions (illegal instruction, EBREAK, ECALL) abandon the
+    // instruction; mepc is its PC. An interrupt is taken as an instruction
+    // retires, so a divide or a cache miss is never cut short, and mepc is
+    // the next PC. Interrupts wait out CSR instructions and MRET, whose
+    // effects on mstatus/mie must land first.
+    assign trap_en   = TRAPS != 0 && handler_set;
+    assign exception = trap_en && (op_illegal || sys_exit) && !stall;
+    assign interrupt = trap_en && irq_pending && !stall && !op_illegal && !sys_exit && !csr_en && !mret;
+    assign take_trap = exception || interrupt;
+
+    // mcause: illegal instruction 2, breakpoint 3, ECALL from M mode 11
+    assign trap_cause = interrupt  ? irq_cause :
+                        op_illegal ? 32'd2     :
+                        instr[20]  ? 32'd3     : 32'd11;
+    assign trap_epc   = interrupt ? resolved_pc : pc;
+    assign trap_tval  = exception && op_illegal ? fetch_raw : 32'b0;
+
+    // WFI stalls until an interrupt enabled in mie is pending, even with
+    // mstatus.MIE clear (then it just falls through)
+    assign wfi_stall = TRAPS != 0 && wfi && !irq_wake;
+
     // ==================================
     // WRITE BACK
     // ==================================
-    MUXTri u_wbSel(
-        .A(alu_result), .B(mem_rdata), .C(pc_plus_4),
+    MUXQuad u_wbSel(
+        .A(ex_result), .B(mem_rdata), .C(pc_seq), .D(csr_rdata),
         .sel(wb_sel),
         .OUT(reg_wdata)
     );
@@ -163,4 +652,26 @@ module RV32I_Core #(
     assign debug_pc_src_sel = pc_src_sel;
     assign debug_alu_ctrl = alu_ctrl;
     assign debug_reg_wen = reg_wen;
+    assign debug_mem_wen = mem_wen;
+    assign debug_fetch_stall = fetch_stall;
+    assign debug_mem_stall = mem_stall;
+    assign debug_div_stall = div_stall;
+    assign debug_trap = take_trap;
+    assign debug_trap_cause = trap_cause;
+    assign debug_mip = irq;
+
+    // Retirement trace: as instret, and nothing retires in reset
+    logic [3:0] mem_mask;
+    assign mem_mask = byte_mask[1:0] == 2'b00 ? 4'b0001 :
+                      byte_mask[1:0] == 2'b01 ? 4'b0011 : 4'b1111;
+
+    assign retire_valid     = rst && !op_illegal && !stall && !exception;
+    assign retire_pc        = pc;
+    assign retire_instr     = fetch_raw;
+    assign retire_rd        = reg_wen ? instr[11:7] : 5'd0;
+    assign retire_rd_wdata  = reg_wdata;
+    assign retire_mem_mask  = (mem_wen || wb_sel == 2'd1) ? mem_mask : 4'b0;
+    assign retire_mem_wen   = mem_wen;
+    assign retire_mem_addr  = alu_result;
+    assign retire_mem_wdata = reg_rdata2 & {{8{mem_mask[3]}}, {8{mem_mask[2]}}, {8{mem_mask[1]}}, {8{mem_mask[0]}}};
 endmodule
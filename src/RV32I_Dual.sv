@@ -0,0 +1,466 @@
+// Two-wide in-order superscalar variant of RV32I_Core.
+//
+// InstrMem returns the two words at the PC every cycle (a 64-bit fetch:
+// instr and instr_next). Lane 0 executes the first exactly as RV32I_Core
+// does. Lane 1 executes the second in the same cycle when the pair may
+// issue together, and the PC then steps by 8. Pairing rules:
+//   - lane 0 retires this cycle and does not redirect the PC (taken
+//     branch, JAL/JALR) or exit
+//   - lane 1 is an ALU op, LUI/AUIPC, load/store, FENCE, branch or jump:
+//     CSR accesses, the M extension and ECALL/EBREAK go in lane 0 only
+//   - at most one memory op (one DataMem port) and one branch or jump
+//   - lane 1 does not read lane 0's rd, unless BUNDLE_FWD = 1 and lane 0
+//     is an ALU op (wb_sel 0): its result is then forwarded across lanes
+// Otherwise lane 1 waits and is lane 0 of the next bundle. debug_split
+// says why. DUAL_ISSUE = 0 never pairs: a single-issue baseline on the
+// same datapath.
+// No caches, RV32C, branch predictor or tohost; programs end with ECALL/
+// EBREAK or an illegal instruction, as on RV32I_Core.
+
+module RV32I_Dual #(
+    parameter IMEM_WORDS = 128,
+    parameter DMEM_WORDS = 128,
+    parameter IMEM_INIT  = "./src/RV32I_TestProg.mem",
+    parameter DMEM_INIT  = "",
+    parameter NUM_HPM    = 5,
+    parameter DUAL_ISSUE = 1,    // 0: lane 0 only (single-issue baseline)
+    parameter BUNDLE_FWD = 1     // 1: forward a lane-0 ALU result to lane 1 of the same bundle
+) (
+    input  logic        clk,
+    input  logic        rst,
+    output logic        illegal_op,
+    output logic        sim_exit,           // ECALL/EBREAK retires this cycle (lane 0)
+    output logic [31:0] sim_exit_code,      // a0
+    // Retirement trace, one set per lane (as RV32I_Core's retire_*). Lane 1
+    // only retires together with lane 0, and is the later instruction.
+    output logic        retire0_valid,
+    output logic [31:0] retire0_pc,
+    output logic [31:0] retire0_instr,
+    output logic [4:0]  retire0_rd,         // 0: no register write
+    output logic [31:0] retire0_rd_wdata,
+    output logic [3:0]  retire0_mem_mask,   // bytes accessed from retire0_mem_addr, 0: none
+    output logic        retire0_mem_wen,
+    output logic [31:0] retire0_mem_addr,
+    output logic [31:0] retire0_mem_wdata,  // store data, masked to retire0_mem_mask
+    output logic        retire1_valid,
+    output logic [31:0] retire1_pc,
+    output logic [31:0] retire1_instr,
+    output logic [4:0]  retire1_rd,
+    output logic [31:0] retire1_rd_wdata,
+    output logic [3:0]  retire1_mem_mask,
+    output logic        retire1_mem_wen,
+    output logic [31:0] retire1_mem_addr,
+    output logic [31:0] retire1_mem_wdata,
+    output logic [1:0]  debug_split,        // lane 0 retired alone: SPLIT_* says why
+    output logic [31:0] debug_pc,
+    output logic [31:0] debug_next_pc,
+    output logic [63:0] debug_cycle,
+    output logic [63:0] debug_instret,
+    output logic [NUM_HPM*64-1:0] debug_hpmcounter,
+    output logic        debug_div_stall
+);
+    // debug_split
+    localparam SPLIT_NONE     = 2'd0;   // paired, or lane 0 did not retire
+    localparam SPLIT_REDIRECT = 2'd1;   // lane 0 is a taken branch or a jump
+    localparam SPLIT_STRUCT   = 2'd2;   // lane 1 is lane-0-only, or a second memory op / branch
+    localparam SPLIT_DEP      = 2'd3;   // lane 1 reads lane 0's rd and it cannot be forwarded
+
+    localparam OP_LUI   = 7'b0110111;
+    localparam OP_AUIPC = 7'b0010111;
+    localparam OP_JAL   = 7'b1101111;
+    localparam OP_R     = 7'b0110011;
+    localparam OP_S     = 7'b0100011;
+    localparam OP_B     = 7'b1100011;
+
+    // ==================================
+    // INTERNAL WIRES
+    // ==================================
+    // IF
+    logic [31:0] pc, next_pc, pc_plus_4, pc_plus_8;
+    logic [31:0] instr0, instr1;
+    logic        div_stall, issue1;
+
+    // Lane 0
+    logic [31:0] immediate0, rdata1_0, rdata2_0, reg_wdata0;
+    logic [5:0]  alu_ctrl0;
+    logic [2:0]  branch_cond0, byte_mask0;
+    logic [1:0]  wb_sel0;
+    logic        reg_wen0, alu_pc_sel0, alu_imm_sel0, mem_wen0, csr_en0, muldiv_en0;
+    logic        ctrl_illegal0, sys_exit0, taken0;
+    logic [31:0] alu_src1_0, alu_src2_0, alu_result0;
+    logic [31:0] mul_result, div_result, muldiv_result, ex_result0;
+
+    // Lane 1
+    logic [31:0] immediate1, rdata1_1, rdata2_1, src1_1, src2_1, reg_wdata1;
+    logic [5:0]  alu_ctrl1;
+    logic [2:0]  branch_cond1, byte_mask1;
+    logic [1:0]  wb_sel1;
+    logic        reg_wen1, alu_pc_sel1, alu_imm_sel1, mem_wen1;
+    logic        csr_en1, muldiv_en1, ctrl_illegal1, sys_exit1;   // only to refuse the pairing
+    logic        taken1;
+    logic [31:0] alu_src1_1, alu_src2_1, alu_result1;
+
+    // MEM
+    logic [31:0] mem_rdata;
+
+    // CSR
+    logic [31:0] csr_rdata;
+    logic        csr_illegal;
+    logic [4:0]  hpm_events;
+    /* verilator lint_off UNUSEDSIGNAL */
+    logic [63:0] csr_time;
+    /* verilator lint_on UNUSEDSIGNAL */
+
+    // ==================================
+    // INSTRUCTION FETCH
+    // ==================================
+    PC u_pc (
+        .clk(clk), .rst(rst),
+        .next_pc(next_pc),
+        .pc(pc)
+    );
+
+    Adder u_pcIncr4 (
+        .src1(pc), .src2(32'd4),
+        .result(pc_plus_4)
+    );
+
+    Adder u_pcIncr8 (
+        .src1(pc), .src2(32'd8),
+        .result(pc_plus_8)
+    );
+
+    // Hold on the divider; lane 0's redirect wins; then lane 1's; else the
+    // PC steps over what retired
+    always_comb begin
+        if (div_stall)
+            next_pc = pc;
+        else if (taken0)
+            next_pc = alu_result0;
+        else if (issue1)
+            next_pc = taken1 ? alu_result1 : pc_plus_8;
+        else
+            next_pc = pc_plus_4;
+    end
+
+    InstrMem #(
+        .WORDS(IMEM_WORDS),
+        .mem_init(IMEM_INIT)
+    ) u_instrMem (
+        .clk(clk),
+        .address(pc),
+        .instr(instr0),
+        .instr_next(instr1)
+    );
+
+    // ==================================
+    // DECODE
+    // ==================================
+    ImmGen u_immGen0 (
+        .instr(instr0), .immediate(immediate0)
+    );
+
+    ImmGen u_immGen1 (
+        .instr(instr1), .immediate(immediate1)
+    );
+
+    Controller u_controller0 (
+        .opcode(instr0[6:0]), .func7(instr0[31:25]), .func3(instr0[14:12]), .rs2(instr0[24:20]),
+        .rs1(instr0[19:15]), .rd(instr0[11:7]),
+        .alu_ctrl(alu_ctrl0),
+        .branch_cond(branch_cond0),
+        .byte_mask(byte_mask0), .wb_sel(wb_sel0), .reg_wen(reg_wen0),
+        .alu_pc_sel(alu_pc_sel0), .alu_imm_sel(alu_imm_sel0), .mem_wen(mem_wen0),
+        .csr_en(csr_en0), .muldiv_en(muldiv_en0), .illegal_op(ctrl_illegal0),
+        .sys_exit(sys_exit0),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .mret(), .wfi()
+        /* verilator lint_on PINCONNECTEMPTY */
+    );
+
+    Controller u_controller1 (
+        .opcode(instr1[6:0]), .func7(instr1[31:25]), .func3(instr1[14:12]), .rs2(instr1[24:20]),
+        .rs1(instr1[19:15]), .rd(instr1[11:7]),
+        .alu_ctrl(alu_ctrl1),
+        .branch_cond(branch_cond1),
+        .byte_mask(byte_mask1), .wb_sel(wb_sel1), .reg_wen(reg_wen1),
+        .alu_pc_sel(alu_pc_sel1), .alu_imm_sel(alu_imm_sel1), .mem_wen(mem_wen1),
+        .csr_en(csr_en1), .muldiv_en(muldiv_en1), .illegal_op(ctrl_illegal1),
+        .sys_exit(sys_exit1),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .mret(), .wfi()
+        /* verilator lint_on PINCONNECTEMPTY */
+    );
+
+    assign illegal_op = ctrl_illegal0 || csr_illegal;
+
+    // ECALL/EBREAK read a0 (the exit code) through lane 0's rs1 port
+    logic [4:0] rsrc1_0;
+    assign rsrc1_0 = sys_exit0 ? 5'd10 : instr0[19:15];
+
+    assign sim_exit      = sys_exit0 && !div_stall;
+    assign sim_exit_code = rdata1_0;
+
+    // No write forwarding: the writes land on the clock edge, so the
+    // wdata -> rdata path would only form a combinational loop.
+    RegFileDual #(
+        .WRITE_FWD(0)
+    ) u_regFile (
+        .clk(clk), .rst(rst),
+        .wen_a(reg_wen0 && !csr_illegal && !div_stall), .wen_b(issue1 && reg_wen1),
+        .rsrc1_a(rsrc1_0), .rsrc2_a(instr0[24:20]),
+        .rsrc1_b(instr1[19:15]), .rsrc2_b(instr1[24:20]),
+        .wdest_a(instr0[11:7]), .wdest_b(instr1[11:7]),
+        .wdata_a(reg_wdata0), .wdata_b(reg_wdata1),
+        .rdata1_a(rdata1_0), .rdata2_a(rdata2_0),
+        .rdata1_b(rdata1_1), .rdata2_b(rdata2_1)
+    );
+
+    // ==================================
+    // ISSUE (pairing)
+    // ==================================
+    logic lane0_retires, lane1_allowed, mem0, mem1, ctrl0, ctrl1;
+    logic uses_rs1_1, uses_rs2_1, writes0, dep1_1, dep2_1, fwd_ok;
+
+    assign lane0_retires = rst && !illegal_op && !div_stall;
+    assign lane1_allowed = !csr_en1 && !muldiv_en1 && !sys_exit1 && !ctrl_illegal1;
+    assign mem0          = mem_wen0 || wb_sel0 == 2'd1;
+    assign mem1          = mem_wen1 || wb_sel1 == 2'd1;
+    assign ctrl0         = branch_cond0 != 3'b000;
+    assign ctrl1         = branch_cond1 != 3'b000;
+
+    // Registers lane 1 actually reads, against lane 0's destination
+    assign uses_rs1_1 = instr1[6:0] != OP_LUI && instr1[6:0] != OP_AUIPC && instr1[6:0] != OP_JAL;
+    assign uses_rs2_1 = instr1[6:0] == OP_R || instr1[6:0] == OP_S || instr1[6:0] == OP_B;
+    assign writes0    = reg_wen0 && instr0[11:7] != 5'd0;
+    assign dep1_1     = writes0 && uses_rs1_1 && instr1[19:15] == instr0[11:7];
+    assign dep2_1     = writes0 && uses_rs2_1 && instr1[24:20] == instr0[11:7];
+    assign fwd_ok     = BUNDLE_FWD != 0 && wb_sel0 == 2'd0 && !muldiv_en0;
+
+    always_comb begin
+        issue1      = 1'b0;
+        debug_split = SPLIT_NONE;
+        if (DUAL_ISSUE != 0 && lane0_retires && !sys_exit0) begin
+            if (taken0)
+                debug_split = SPLIT_REDIRECT;
+            else if (!lane1_allowed || (mem0 && mem1) || (ctrl0 && ctrl1))
+                debug_split = SPLIT_STRUCT;
+            else if ((dep1_1 || dep2_1) && !fwd_ok)
+                debug_split = SPLIT_DEP;
+            else
+                issue1 = 1'b1;
+        end
+    end
+
+    // Cross-lane bypass: lane 1 takes lane 0's ALU result for a register
+    // lane 0 writes in the same bundle
+    MUX u_fwdSrc1_1 (
+        .A(rdata1_1), .B(alu_result0),
+        .sel(dep1_1),
+        .OUT(src1_1)
+    );
+
+    MUX u_fwdSrc2_1 (
+        .A(rdata2_1), .B(alu_result0),
+        .sel(dep2_1),
+        .OUT(src2_1)
+    );
+
+    // ==================================
+    // EXECUTE: lane 0
+    // ==================================
+    BranchHandler u_branchHandler0 (
+        .branch_cond(branch_cond0), .src1(rdata1_0), .src2(rdata2_0),
+        .branched(taken0)
+    );
+
+    MUX u_aluPCSel0 (
+        .A(rdata1_0), .B(pc),
+        .sel(alu_pc_sel0),
+        .OUT(alu_src1_0)
+    );
+
+    MUX u_aluImmSel0 (
+        .A(rdata2_0), .B(immediate0),
+        .sel(alu_imm_sel0),
+        .OUT(alu_src2_0)
+    );
+
+    ALU u_alu0 (
+        .src1(alu_src1_0), .src2(alu_src2_0),
+        .alu_ctrl(alu_ctrl0),
+        .result(alu_result0)
+    );
+
+    // M extension, lane 0 only: single-cycle multiply, iterative divide
+    // that holds the bundle until its result is ready
+    Multiplier u_multiplier (
+        .src1(rdata1_0), .src2(rdata2_0),
+        .op(instr0[13:12]),
+        .result(mul_result)
+    );
+
+    logic div_ready;
+
+    Divider u_divider (
+        .clk(clk), .rst(rst),
+        .req(muldiv_en0 && instr0[14]), .op(instr0[13:12]),
+        .src1(rdata1_0), .src2(rdata2_0),
+        .hold(1'b0),
+        .result(div_result), .ready(div_ready)
+    );
+
+    assign div_stall = !div_ready;
+
+    MUX u_mulDivSel (
+        .A(mul_result), .B(div_result),
+        .sel(instr0[14]),
+        .OUT(muldiv_result)
+    );
+
+    MUX u_exResultSel0 (
+        .A(alu_result0), .B(muldiv_result),
+        .sel(muldiv_en0),
+        .OUT(ex_result0)
+    );
+
+    // ==================================
+    // EXECUTE: lane 1
+    // ==================================
+    BranchHandler u_branchHandler1 (
+        .branch_cond(branch_cond1), .src1(src1_1), .src2(src2_1),
+        .branched(taken1)
+    );
+
+    MUX u_aluPCSel1 (
+        .A(src1_1), .B(pc_plus_4),
+        .sel(alu_pc_sel1),
+        .OUT(alu_src1_1)
+    );
+
+    MUX u_aluImmSel1 (
+        .A(src2_1), .B(immediate1),
+        .sel(alu_imm_sel1),
+        .OUT(alu_src2_1)
+    );
+
+    ALU u_alu1 (
+        .src1(alu_src1_1), .src2(alu_src2_1),
+        .alu_ctrl(alu_ctrl1),
+        .result(alu_result1)
+    );
+
+    // ==================================
+    // MEMORY
+    // ==================================
+    // One port: lane 1 drives it when lane 0 has no memory op, and only
+    // writes when it issues
+    logic [31:0] dmem_addr, dmem_wdata;
+    logic [2:0]  dmem_byte_mask;
+    logic        dmem_wen;
+
+    assign dmem_addr      = mem0 ? alu_result0 : alu_result1;
+    assign dmem_wdata     = mem0 ? rdata2_0 : src2_1;
+    assign dmem_byte_mask = mem0 ? byte_mask0 : byte_mask1;
+    assign dmem_wen       = mem0 ? mem_wen0 : (issue1 && mem_wen1);
+
+    DataMem #(
+        .WORDS(DMEM_WORDS),
+        .mem_init(DMEM_INIT)
+    ) u_dataMem (
+        .clk(clk), .wen(dmem_wen),
+        .address(dmem_addr), .wdata(dmem_wdata),
+        .byte_mask(dmem_byte_mask),
+        .rdata(mem_rdata)
+    );
+
+    // ==================================
+    // CSR (performance counters)
+    // ==================================
+    // Events: {illegal op, jump, store, load, taken branch}, from either
+    // lane: a bundle has at most one memory op and one branch or jump
+    logic [4:0] events0, events1;
+    assign events0 = {
+        illegal_op,
+        wb_sel0 == 2'd2,                            // JAL/JALR write back the return address
+        mem_wen0,
+        wb_sel0 == 2'd1,
+        taken0 && branch_cond0 != 3'b111            // conditional branch taken
+    };
+    assign events1 = {
+        1'b0,
+        wb_sel1 == 2'd2,
+        mem_wen1,
+        wb_sel1 == 2'd1,
+        taken1 && branch_cond1 != 3'b111
+    };
+    assign hpm_events = div_stall ? 5'b0 : (events0 | (issue1 ? events1 : 5'b0));
+
+    CSRFile #(
+        .NUM_HPM(NUM_HPM),
+        .RETIRE_W(2)
+    ) u_csrFile (
+        .clk(clk), .rst(rst),
+        .csr_en(csr_en0), .csr_op(instr0[14:12]), .csr_addr(instr0[31:20]),
+        .csr_zimm(instr0[19:15]), .csr_src(rdata1_0),
+        .csr_rdata(csr_rdata), .csr_illegal(csr_illegal),
+        .retire({issue1, !illegal_op && !div_stall}), .events(hpm_events),
+        .irq(3'b0), .trap_enter(1'b0), .trap_cause(32'b0),
+        .trap_epc(32'b0), .trap_tval(32'b0), .mret(1'b0),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .irq_pending(), .irq_cause(), .irq_wake(),
+        .trap_vector(), .trap_mepc(), .handler_set(),
+        /* verilator lint_on PINCONNECTEMPTY */
+        .debug_cycle(debug_cycle), .debug_time(csr_time),
+        .debug_instret(debug_instret), .debug_hpmcounter(debug_hpmcounter)
+    );
+
+    // ==================================
+    // WRITE BACK
+    // ==================================
+    MUXQuad u_wbSel0 (
+        .A(ex_result0), .B(mem_rdata), .C(pc_plus_4), .D(csr_rdata),
+        .sel(wb_sel0),
+        .OUT(reg_wdata0)
+    );
+
+    MUXQuad u_wbSel1 (
+        .A(alu_result1), .B(mem_rdata), .C(pc_plus_8), .D(32'b0),
+        .sel(wb_sel1),
+        .OUT(reg_wdata1)
+    );
+
+    // ==================================
+    // Assigning debug outputs
+    // ==================================
+    assign debug_pc        = pc;
+    assign debug_next_pc   = next_pc;
+    assign debug_div_stall = div_stall;
+
+    // Retirement trace
+    logic [3:0] mem_mask0, mem_mask1;
+    assign mem_mask0 = byte_mask0[1:0] == 2'b00 ? 4'b0001 :
+                       byte_mask0[1:0] == 2'b01 ? 4'b0011 : 4'b1111;
+    assign mem_mask1 = byte_mask1[1:0] == 2'b00 ? 4'b0001 :
+                       byte_mask1[1:0] == 2'b01 ? 4'b0011 : 4'b1111;
+
+    assign retire0_valid     = lane0_retires;
+    assign retire0_pc        = pc;
+    assign retire0_instr     = instr0;
+    assign retire0_rd        = reg_wen0 ? instr0[11:7] : 5'd0;
+    assign retire0_rd_wdata  = reg_wdata0;
+    assign retire0_mem_mask  = mem0 ? mem_mask0 : 4'b0;
+    assign retire0_mem_wen   = mem_wen0;
+    assign retire0_mem_addr  = alu_result0;
+    assign retire0_mem_wdata = rdata2_0 & {{8{mem_mask0[3]}}, {8{mem_mask0[2]}}, {8{mem_mask0[1]}}, {8{mem_mask0[0]}}};
+
+    assign retire1_valid     = issue1;
+    assign retire1_pc        = pc_plus_4;
+    assign retire1_instr     = instr1;
+    assign retire1_rd        = reg_wen1 ? instr1[11:7] : 5'd0;
+    assign retire1_rd_wdata  = reg_wdata1;
+    assign retire1_mem_mask  = mem1 ? mem_mask1 : 4'b0;
+    assign retire1_mem_wen   = mem_wen1;
+    assign retire1_mem_addr  = alu_result1;
+    assign retire1_mem_wdata = src2_1 & {{8{mem_mask1[3]}}, {8{mem_mask1[2]}}, {8{mem_mask1[1]}}, {8{mem_mask1[0]}}};
+endmodule
@@ -0,0 +1,585 @@
+// Five-stage (IF/ID/EX/MEM/WB) variant of RV32I_Core.
+//
+// Hazards:
+//   - EX/MEM -> EX and MEM/WB -> EX forwarding; WB -> ID goes through the
+//     RegFile write forwarding.
+//   - Load-use: one bubble when the instruction in ID reads the rd of a load in EX.
+//   - Branches and jumps resolve in EX. Fetch follows BranchPredictor
+//     (BPRED = 1) or falls through (BPRED = 0); a wrong next PC flushes
+//     IF/ID and ID/EX.
+//   - With ICACHE = 1, an I-cache miss holds the PC and feeds bubbles to ID.
+//   - With DCACHE = 1, a D-cache miss in MEM freezes IF..MEM and feeds
+//     bubbles to WB.
+//   - DIV/DIVU/REM/REMU hold IF..EX while the divider runs and feed bubbles
+//     to MEM.
+// The debug_* outputs describe the instruction retiring in WB.
+
+module RV32I_Pipe #(
+    parameter IMEM_WORDS = 128,
+    parameter DMEM_WORDS = 128,
+    parameter IMEM_INIT  = "./src/RV32I_TestProg.mem",
+    parameter DMEM_INIT  = "",
+    parameter NUM_HPM    = 5,
+    parameter BPRED      = 1,
+    parameter BP_GHR_BITS     = 6,   // BranchPredictor global history length; 0 = bimodal
+    parameter ICACHE     = 0,    // 1: fetch through ICache, inserting bubbles on misses
+    parameter IC_SETS         = 8,
+    parameter IC_WAYS         = 2,
+    parameter IC_LINE_WORDS   = 4,
+    parameter IC_REPL         = 0,
+    parameter IC_MISS_LATENCY = 8,
+    parameter DCACHE     = 0,    // 1: MEM goes through DCache, freezing the pipe on misses
+    parameter DC_SETS         = 8,
+    parameter DC_WAYS         = 2,
+    parameter DC_LINE_WORDS   = 4,
+    parameter DC_MISS_LATENCY = 8
+) (
+    input  logic        clk,
+    input  logic        rst,
+    output logic        illegal_op,
+    output logic        debug_retire,
+    output logic [31:0] debug_pc,
+    output logic [31:0] debug_instr,
+    output logic [31:0] debug_reg_wdata,
+    output logic [4:0]  debug_reg_wdest,
+    output logic        debug_reg_wen,
+    output logic        debug_stall,
+    output logic        debug_flush,
+    output logic [63:0] debug_cycle,
+    output logic [63:0] debug_instret,
+    output logic [31:0] debug_bp_branches,
+    output logic [31:0] debug_bp_branch_miss,
+    output logic [31:0] debug_bp_jumps,
+    output logic [31:0] debug_bp_jump_miss,
+    output logic        debug_fetch_stall,
+    output logic [31:0] debug_ic_hits,
+    output logic [31:0] debug_ic_misses,
+    output logic [31:0] debug_ic_refills,
+    output logic        debug_mem_stall,
+    output logic [31:0] debug_dc_hits,
+    output logic [31:0] debug_dc_misses,
+    output logic [31:0] debug_dc_writebacks,
+    output logic        debug_div_stall
+);
+    localparam NOP = 32'h00000013;      // addi x0, x0, 0
+
+    // Opcodes / write-back selects used by the hazard logic
+    localparam OP_LUI   = 7'b0110111;
+    localparam OP_AUIPC = 7'b0010111;
+    localparam OP_JAL   = 7'b1101111;
+    localparam OP_R     = 7'b0110011;
+    localparam OP_S     = 7'b0100011;
+    localparam OP_B     = 7'b1100011;
+    localparam OP_FENCE = 7'b0001111;
+    localparam MEM_WB   = 2'd1;
+
+    localparam BP_GHR_W = (BP_GHR_BITS > 0) ? BP_GHR_BITS : 1;     // pred_ghr / upd_ghr width
+
+    // ==================================
+    // INTERNAL WIRES
+    // ==================================
+    // IF
+    logic [31:0] if_pc, if_pc_plus_4, if_pred_next, if_seq_pc, if_next_pc, if_instr;
+    logic [BP_GHR_W-1:0] if_bp_ghr;
+    logic [31:0] imem_addr, imem_rdata;
+    logic        if_miss;
+
+    // ID
+    logic        id_valid;
+    logic [31:0] id_pc, id_pc_plus_4, id_pred_next, id_instr;
+    logic [BP_GHR_W-1:0] id_bp_ghr;
+    logic [31:0] id_immediate, id_rdata1, id_rdata2;
+    logic [5:0]  id_alu_ctrl;
+    logic [2:0]  id_branch_cond, id_byte_mask;
+    logic [1:0]  id_wb_sel;
+    logic        id_reg_wen, id_alu_pc_sel, id_alu_imm_sel, id_mem_wen, id_csr_en, id_muldiv_en, id_illegal;
+    logic        id_ctrl_illegal, id_sys_exit;
+    logic        id_uses_rs1, id_uses_rs2;
+
+    // EX
+    logic        ex_valid;
+    logic [31:0] ex_pc, ex_pc_plus_4, ex_pred_next, ex_instr;
+    logic [BP_GHR_W-1:0] ex_bp_ghr;
+    logic [31:0] ex_immediate, ex_rdata1, ex_rdata2;
+    logic [5:0]  ex_alu_ctrl;
+    logic [2:0]  ex_branch_cond, ex_byte_mask;
+    logic [1:0]  ex_wb_sel;
+    logic        ex_reg_wen, ex_alu_pc_sel, ex_alu_imm_sel, ex_mem_wen, ex_csr_en, ex_muldiv_en, ex_illegal;
+    logic [31:0] ex_fwd1, ex_fwd2, ex_alu_src1, ex_alu_src2, ex_alu_result, ex_result;
+    logic [31:0] ex_mul_result, ex_div_result, ex_muldiv_result, ex_exec_result;
+    logic [31:0] ex_actual_next;
+    logic        ex_branched, ex_redirect, ex_fire;
+    logic [31:0] ex_csr_rdata;
+    logic        ex_csr_illegal;
+    logic [4:0]  ex_events;
+
+    // MEM
+    logic        mem_valid;
+    logic [31:0] mem_pc, mem_instr, mem_result, mem_store_data, mem_rdata, mem_wb_data;
+    logic [2:0]  mem_byte_mask;
+    logic [1:0]  mem_wb_sel;
+    logic        mem_reg_wen, mem_mem_wen, mem_illegal;
+
+    // WB
+    logic        wb_valid;
+    logic [31:0] wb_pc, wb_instr, wb_data;
+    logic        wb_reg_wen, wb_illegal;
+
+    // Hazard control
+    logic stall, mem_stall, div_stall, ex_hold;
+
+    /* verilator lint_off UNUSEDSIGNAL */
+    logic [63:0] csr_time;
+    /* verilator lint_on UNUSEDSIGNAL */
+
+    // ==================================
+    // INSTRUCTION FETCH
+    // ==================================
+    PC u_pc (
+        .clk(clk), .rst(rst),
+        .next_pc(if_next_pc),
+        .pc(if_pc)
+    );
+
+    Adder u_pcIncr (
+        .src1(if_pc), .src2(32'd4),
+        .result(if_pc_plus_4)
+    );
+
+    // Predicted next fetch PC
+    generate
+        if (BPRED) begin : g_bpred
+            logic        bp_taken;
+            logic [31:0] bp_target;
+
+            // The history each branch was predicted with rides down to EX
+            // (if/id/ex_bp_ghr), so the BHT trains the counter it read
+            BranchPredictor #(
+                .GHR_BITS(BP_GHR_BITS)
+            ) u_branchPredictor (
+                .clk(clk), .rst(rst),
+                .pc(if_pc),
+                .pred_taken(bp_taken), .pred_target(bp_target), .pred_ghr(if_bp_ghr),
+                .upd_valid(ex_fire), .upd_pc(ex_pc), .upd_seq_pc(ex_pc_plus_4), .upd_instr(ex_instr),
+                .upd_taken(ex_branched), .upd_target(ex_alu_result), .upd_ghr(ex_bp_ghr),
+                .upd_mispredict(ex_redirect),
+                .stat_branches(debug_bp_branches), .stat_branch_miss(debug_bp_branch_miss),
+                .stat_jumps(debug_bp_jumps), .stat_jump_miss(debug_bp_jump_miss)
+            );
+
+            MUX u_predSel (
+                .A(if_pc_plus_4), .B(bp_target),
+                .sel(bp_taken),
+                .OUT(if_pred_next)
+            );
+        end else begin : g_no_bpred
+            assign if_pred_next         = if_pc_plus_4;
+            assign if_bp_ghr            = '0;
+            assign debug_bp_branches    = 32'b0;
+            assign debug_bp_branch_miss = 32'b0;
+            assign debug_bp_jumps       = 32'b0;
+            assign debug_bp_jump_miss   = 32'b0;
+        end
+    endgenerate
+
+    MUX u_pcHold (
+        .A(if_pred_next), .B(if_pc),
+        .sel(stall || if_miss || ex_hold),
+        .OUT(if_seq_pc)
+    );
+
+    MUX u_pcSel (
+        .A(if_seq_pc), .B(ex_actual_next),
+        .sel(ex_redirect),
+        .OUT(if_next_pc)
+    );
+
+    InstrMem #(
+        .WORDS(IMEM_WORDS),
+        .mem_init(IMEM_INIT)
+    ) u_instrMem (
+        .clk(clk),
+        .address(imem_addr),
+        .instr(imem_rdata),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .instr_next()
+        /* verilator lint_on PINCONNECTEMPTY */
+    );
+
+    // With the I-cache, InstrMem is the backing memory and a miss sends a
+    // NOP bubble down the pipe while the PC holds.
+    generate
+        if (ICACHE) begin : g_icache
+            logic [31:0] ic_instr;
+            logic        ic_hit;
+
+            ICache #(
+                .SETS(IC_SETS), .WAYS(IC_WAYS), .LINE_WORDS(IC_LINE_WORDS),
+                .REPL(IC_REPL), .MISS_LATENCY(IC_MISS_LATENCY)
+            ) u_iCache (
+                .clk(clk), .rst(rst),
+                .req(!stall), .pc(if_pc),
+                .instr(ic_instr), .hit(ic_hit),
+                .mem_addr(imem_addr), .mem_rdata(imem_rdata),
+                .stat_hits(debug_ic_hits), .stat_misses(debug_ic_misses),
+                .stat_refills(debug_ic_refills)
+            );
+
+            MUX u_missNop (
+                .A(NOP), .B(ic_instr),
+                .sel(ic_hit),
+                .OUT(if_instr)
+            );
+
+            assign if_miss = !ic_hit;
+        end else begin : g_no_icache
+            assign imem_addr        = if_pc;
+            assign if_instr         = imem_rdata;
+            assign if_miss          = 1'b0;
+            assign debug_ic_hits    = 32'b0;
+            assign debug_ic_misses  = 32'b0;
+            assign debug_ic_refills = 32'b0;
+        end
+    endgenerate
+
+    // IF/ID
+    always_ff @(posedge clk) begin
+        if (!rst || ex_redirect) begin
+            id_valid <= 1'b0;
+            id_instr <= NOP;
+        end else if (!stall && !ex_hold) begin
+            id_valid     <= !if_miss;
+            id_pc        <= if_pc;
+            id_pc_plus_4 <= if_pc_plus_4;
+            id_pred_next <= if_pred_next;
+            id_bp_ghr    <= if_bp_ghr;
+            id_instr     <= if_instr;
+        end
+    end
+
+    // ==================================
+    // DECODE
+    // ==================================
+    ImmGen u_immGen (
+        .instr(id_instr), .immediate(id_immediate)
+    );
+
+    RegFile u_regFile (
+        .clk(clk), .rst(rst), .wen(wb_reg_wen),
+        .rsrc1(id_instr[19:15]), .rsrc2(id_instr[24:20]), .wdest(wb_instr[11:7]),
+        .wdata(wb_data),
+        .rdata1(id_rdata1), .rdata2(id_rdata2)
+    );
+
+    Controller u_controller (
+        .opcode(id_instr[6:0]), .func7(id_instr[31:25]), .func3(id_instr[14:12]), .rs2(id_instr[24:20]),
+        .rs1(id_instr[19:15]), .rd(id_instr[11:7]),
+        .alu_ctrl(id_alu_ctrl),
+        .branch_cond(id_branch_cond),
+        .byte_mask(id_byte_mask), .wb_sel(id_wb_sel), .reg_wen(id_reg_wen),
+        .alu_pc_sel(id_alu_pc_sel), .alu_imm_sel(id_alu_imm_sel), .mem_wen(id_mem_wen),
+        .csr_en(id_csr_en), .muldiv_en(id_muldiv_en), .illegal_op(id_ctrl_illegal),
+        .sys_exit(id_sys_exit),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .mret(), .wfi()
+        /* verilator lint_on PINCONNECTEMPTY */
+    );
+
+    // The pipeline has no exit port: ECALL/EBREAK halt it like an illegal op
+    assign id_illegal = id_ctrl_illegal || id_sys_exit;
+
+    // Load-use hazard: hold IF/ID for one cycle and send a bubble to EX
+    assign id_uses_rs1 = !(id_instr[6:0] == OP_LUI || id_instr[6:0] == OP_AUIPC || id_instr[6:0] == OP_JAL);
+    assign id_uses_rs2 = id_instr[6:0] == OP_R || id_instr[6:0] == OP_S || id_instr[6:0] == OP_B;
+
+    assign stall = ex_valid && ex_wb_sel == MEM_WB && ex_instr[11:7] != 5'd0 &&
+                   ((id_uses_rs1 && ex_instr[11:7] == id_instr[19:15]) ||
+                    (id_uses_rs2 && ex_instr[11:7] == id_instr[24:20]));
+
+    // ID/EX. While MEM waits on the D-cache or the divider runs, EX holds its
+    // instruction and captures its forwarded operands, because the MEM/WB
+    // producer retires.
+    assign ex_hold = mem_stall || div_stall;
+
+    always_ff @(posedge clk) begin
+        if (!rst || ex_redirect || (!ex_hold && (stall || !id_valid))) begin
+            ex_valid       <= 1'b0;
+            ex_reg_wen     <= 1'b0;
+            ex_mem_wen     <= 1'b0;
+            ex_csr_en      <= 1'b0;
+            ex_muldiv_en   <= 1'b0;
+            ex_illegal     <= 1'b0;
+            ex_branch_cond <= 3'b000;
+            ex_wb_sel      <= 2'd0;
+            ex_instr       <= NOP;
+        end else if (!ex_hold) begin
+            ex_valid       <= 1'b1;
+            ex_reg_wen     <= id_reg_wen;
+            ex_mem_wen     <= id_mem_wen;
+            ex_csr_en      <= id_csr_en;
+            ex_muldiv_en   <= id_muldiv_en;
+            ex_illegal     <= id_illegal;
+            ex_branch_cond <= id_branch_cond;
+            ex_wb_sel      <= id_wb_sel;
+            ex_instr       <= id_instr;
+        end
+
+        if (ex_hold) begin
+            ex_rdata1      <= ex_fwd1;
+            ex_rdata2      <= ex_fwd2;
+        end else begin
+            ex_pc          <= id_pc;
+            ex_pc_plus_4   <= id_pc_plus_4;
+            ex_pred_next   <= id_pred_next;
+            ex_bp_ghr      <= id_bp_ghr;
+            ex_immediate   <= id_immediate;
+            ex_rdata1      <= id_rdata1;
+            ex_rdata2      <= id_rdata2;
+            ex_alu_ctrl    <= id_alu_ctrl;
+            ex_byte_mask   <= id_byte_mask;
+            ex_alu_pc_sel  <= id_alu_pc_sel;
+            ex_alu_imm_sel <= id_alu_imm_sel;
+        end
+    end
+
+    // ==================================
+    // EXECUTE
+    // ==================================
+    // Forwarding: youngest producer (EX/MEM) first, then MEM/WB
+    always_comb begin
+        if (mem_reg_wen && mem_instr[11:7] != 5'd0 && mem_instr[11:7] == ex_instr[19:15])
+            ex_fwd1 = mem_result;
+        else if (wb_reg_wen && wb_instr[11:7] != 5'd0 && wb_instr[11:7] == ex_instr[19:15])
+            ex_fwd1 = wb_data;
+        else
+            ex_fwd1 = ex_rdata1;
+
+        if (mem_reg_wen && mem_instr[11:7] != 5'd0 && mem_instr[11:7] == ex_instr[24:20])
+            ex_fwd2 = mem_result;
+        else if (wb_reg_wen && wb_instr[11:7] != 5'd0 && wb_instr[11:7] == ex_instr[24:20])
+            ex_fwd2 = wb_data;
+        else
+            ex_fwd2 = ex_rdata2;
+    end
+
+    BranchHandler u_branchHandler (
+        .branch_cond(ex_branch_cond), .src1(ex_fwd1), .src2(ex_fwd2),
+        .branched(ex_branched)
+    );
+
+    MUX u_nextPCSel (
+        .A(ex_pc_plus_4), .B(ex_alu_result),
+        .sel(ex_branched),
+        .OUT(ex_actual_next)
+    );
+
+    // EX acts (redirects, trains, counts, writes CSRs) once, on its last cycle
+    assign ex_fire     = ex_valid && !ex_hold;
+    assign ex_redirect = ex_fire && ex_actual_next != ex_pred_next;
+
+    MUX u_aluPCSel (
+        .A(ex_fwd1), .B(ex_pc),
+        .sel(ex_alu_pc_sel),
+        .OUT(ex_alu_src1)
+    );
+
+    MUX u_aluImmSel (
+        .A(ex_fwd2), .B(ex_immediate),
+        .sel(ex_alu_imm_sel),
+        .OUT(ex_alu_src2)
+    );
+
+    ALU u_alu (
+        .src1(ex_alu_src1), .src2(ex_alu_src2),
+        .alu_ctrl(ex_alu_ctrl),
+        .result(ex_alu_result)
+    );
+
+    // M extension
+    Multiplier u_multiplier (
+        .src1(ex_fwd1), .src2(ex_fwd2),
+        .op(ex_instr[13:12]),
+        .result(ex_mul_result)
+    );
+
+    logic div_ready;
+
+    Divider u_divider (
+        .clk(clk), .rst(rst),
+        .req(ex_valid && ex_muldiv_en && ex_instr[14]), .op(ex_instr[13:12]),
+        .src1(ex_fwd1), .src2(ex_fwd2),
+        .hold(mem_stall),
+        .result(ex_div_result), .ready(div_ready)
+    );
+
+    assign div_stall = !div_ready;
+
+    MUX u_mulDivSel (
+        .A(ex_mul_result), .B(ex_div_result),
+        .sel(ex_instr[14]),
+        .OUT(ex_muldiv_result)
+    );
+
+    MUX u_execSel (
+        .A(ex_alu_result), .B(ex_muldiv_result),
+        .sel(ex_muldiv_en),
+        .OUT(ex_exec_result)
+    );
+
+    // Events: {illegal op, jump, store, load, taken branch}
+    assign ex_events = {
+        ex_fire && (ex_illegal || ex_csr_illegal),
+        ex_fire && ex_wb_sel == 2'd2,
+        ex_fire && ex_mem_wen,
+        ex_fire && ex_wb_sel == MEM_WB,
+        ex_fire && ex_branched && ex_branch_cond != 3'b111
+    };
+
+    // CSRs execute in EX, which is never flushed once an instruction reaches it
+    CSRFile #(
+        .NUM_HPM(NUM_HPM)
+    ) u_csrFile (
+        .clk(clk), .rst(rst),
+        .csr_en(ex_csr_en && !mem_stall), .csr_op(ex_instr[14:12]), .csr_addr(ex_instr[31:20]),
+        .csr_zimm(ex_instr[19:15]), .csr_src(ex_fwd1),
+        .csr_rdata(ex_csr_rdata), .csr_illegal(ex_csr_illegal),
+        .retire(wb_valid && !wb_illegal), .events(ex_events),
+        .irq(3'b0), .trap_enter(1'b0), .trap_cause(32'b0),
+        .trap_epc(32'b0), .trap_tval(32'b0), .mret(1'b0),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .irq_pending(), .irq_cause(), .irq_wake(),
+        .trap_vector(), .trap_mepc(), .handler_set(),
+        /* verilator lint_on PINCONNECTEMPTY */
+        .debug_cycle(debug_cycle), .debug_time(csr_time),
+        .debug_instret(debug_instret),
+        /* verilator lint_off PINCONNECTEMPTY */
+        .debug_hpmcounter()
+        /* verilator lint_on PINCONNECTEMPTY */
+    );
+
+    // Result carried to MEM (loads replace it there)
+    MUXQuad u_exResultSel (
+        .A(ex_exec_result), .B(ex_alu_result), .C(ex_pc_plus_4), .D(ex_csr_rdata),
+        .sel(ex_wb_sel),
+        .OUT(ex_result)
+    );
+
+    // EX/MEM. A division still running leaves a bubble in MEM.
+    always_ff @(posedge clk) begin
+        if (!rst || (div_stall && !mem_stall)) begin
+            mem_valid   <= 1'b0;
+            mem_reg_wen <= 1'b0;
+            mem_mem_wen <= 1'b0;
+            mem_illegal <= 1'b0;
+            mem_instr   <= NOP;
+        end else if (!mem_stall) begin
+            mem_valid   <= ex_valid;
+            mem_reg_wen <= ex_reg_wen && !ex_csr_illegal;
+            mem_mem_wen <= ex_mem_wen;
+            mem_illegal <= ex_illegal || ex_csr_illegal;
+            mem_instr   <= ex_instr;
+        end
+
+        if (!mem_stall) begin
+            mem_pc         <= ex_pc;
+            mem_result     <= ex_result;
+            mem_store_data <= ex_fwd2;
+            mem_byte_mask  <= ex_byte_mask;
+            mem_wb_sel     <= ex_wb_sel;
+        end
+    end
+
+    // ==================================
+    // MEMORY
+    // ==================================
+    logic [31:0] dmem_addr, dmem_wdata, dmem_rdata;
+    logic [2:0]  dmem_byte_mask;
+    logic        dmem_wen;
+
+    DataMem #(
+        .WORDS(DMEM_WORDS),
+        .mem_init(DMEM_INIT)
+    ) u_dataMem (
+        .clk(clk), .wen(dmem_wen),
+        .address(dmem_addr), .wdata(dmem_wdata),
+        .byte_mask(dmem_byte_mask),
+        .rdata(dmem_rdata)
+    );
+
+    // With the D-cache, DataMem is the word-wide backing memory and FENCE
+    // writes back and invalidates the cache.
+    generate
+        if (DCACHE) begin : g_dcache
+            logic dc_ready;
+
+            DCache #(
+                .SETS(DC_SETS), .WAYS(DC_WAYS), .LINE_WORDS(DC_LINE_WORDS),
+                .MISS_LATENCY(DC_MISS_LATENCY)
+            ) u_dCache (
+                .clk(clk), .rst(rst),
+                .req(mem_valid && (mem_mem_wen || mem_wb_sel == MEM_WB)), .wen(mem_mem_wen),
+                .address(mem_result), .wdata(mem_store_data),
+                .byte_mask(mem_byte_mask),
+                .rdata(mem_rdata),
+                .flush(mem_valid && mem_instr[6:0] == OP_FENCE), .ready(dc_ready),
+                .mem_addr(dmem_addr), .mem_wdata(dmem_wdata),
+                .mem_wen(dmem_wen), .mem_rdata(dmem_rdata),
+                .stat_hits(debug_dc_hits), .stat_misses(debug_dc_misses),
+                .stat_writebacks(debug_dc_writebacks)
+            );
+
+            assign dmem_byte_mask = 3'b010;     // LW
+            assign mem_stall      = !dc_ready;
+        end else begin : g_no_dcache
+            assign dmem_addr           = mem_result;
+            assign dmem_wdata          = mem_store_data;
+            assign dmem_wen            = mem_mem_wen;
+            assign dmem_byte_mask      = mem_byte_mask;
+            assign mem_rdata           = dmem_rdata;
+            assign mem_stall           = 1'b0;
+            assign debug_dc_hits       = 32'b0;
+            assign debug_dc_misses     = 32'b0;
+            assign debug_dc_writebacks = 32'b0;
+        end
+    endgenerate
+
+    MUX u_memResultSel (
+        .A(mem_result), .B(mem_rdata),
+        .sel(mem_wb_sel == MEM_WB),
+        .OUT(mem_wb_data)
+    );
+
+    // MEM/WB
+    always_ff @(posedge clk) begin
+        if (!rst || mem_stall) begin
+            wb_valid   <= 1'b0;
+            wb_reg_wen <= 1'b0;
+            wb_illegal <= 1'b0;
+            wb_instr   <= NOP;
+        end else begin
+            wb_valid   <= mem_valid;
+            wb_reg_wen <= mem_reg_wen;
+            wb_illegal <= mem_illegal;
+            wb_instr   <= mem_instr;
+        end
+
+        wb_pc   <= mem_pc;
+        wb_data <= mem_wb_data;
+    end
+
+    // ==================================
+    // Assigning debug outputs
+    // ==================================
+    assign illegal_op      = wb_valid && wb_illegal;
+    assign debug_retire    = wb_valid;
+    assign debug_pc        = wb_pc;
+    assign debug_instr     = wb_instr;
+    assign debug_reg_wdata = wb_data;
+    assign debug_reg_wdest = wb_instr[11:7];
+    assign debug_reg_wen   = wb_reg_wen;
+    assign debug_stall     = stall;
+    assign debug_fetch_stall = if_miss;
+    assign debug_mem_stall   = mem_stall;
+    assign debug_div_stall   = div_stall;
+    assign debug_flush     = ex_redirect;
+endmodule
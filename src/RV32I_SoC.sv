@@ -0,0 +1,128 @@
+// NUM_HARTS copies of RV32I_Core sharing one DataMem.
+//
+// Each hart fetches from its own InstrMem (all loaded with IMEM_INIT) and
+// reads its index from mhartid, so one program can split the work. Loads
+// and stores leave the cores on their dbus_* port (EXT_DMEM=1) and reach
+// the shared memory through DMemArbiter: one access per cycle, round-robin,
+// and a hart that loses stalls until it is granted. The memory has no
+// atomics; harts that share data need their own slots or a protocol on
+// plain loads and stores.
+//
+// The per-hart flags are bit vectors indexed by hart (up to 64 harts).
+// Everything else is read one hart at a time through dbg_hart.
+
+module RV32I_SoC #(
+    parameter NUM_HARTS  = 2,
+    parameter IMEM_WORDS = 128,
+    parameter DMEM_WORDS = 256,
+    parameter IMEM_INIT  = "./src/RV32I_SoC_TestProg.mem",
+    parameter DMEM_INIT  = ""
+) (
+    input  logic        clk,
+    input  logic        rst,
+    output logic [7:0]  num_harts,              // NUM_HARTS, for the testbench
+    output logic [NUM_HARTS-1:0] illegal_op,
+    output logic [NUM_HARTS-1:0] sim_exit,      // ECALL/EBREAK retires on that hart this cycle
+    output logic [NUM_HARTS-1:0] mem_wait,      // the hart is stalled behind another's access
+
+    // The hart selected by dbg_hart
+    input  logic [7:0]  dbg_hart,
+    output logic [31:0] dbg_pc,
+    output logic [31:0] dbg_exit_code,
+    output logic [63:0] dbg_cycle,
+    output logic [63:0] dbg_instret,
+    output logic [31:0] dbg_wait_cycles         // cycles stalled on the shared memory
+);
+    localparam IDX_W = (NUM_HARTS > 1) ? $clog2(NUM_HARTS) : 1;
+
+    generate
+        if (NUM_HARTS < 1 || NUM_HARTS > 64) begin : g_check
+            $error("NUM_HARTS must be 1-64");
+        end
+    endgenerate
+
+    logic [NUM_HARTS-1:0]    dbus_req, dbus_wen, dbus_gnt;
+    logic [NUM_HARTS*32-1:0] dbus_addr, dbus_wdata, exit_code, pc;
+    logic [NUM_HARTS*3-1:0]  dbus_byte_mask;
+    logic [NUM_HARTS*64-1:0] cycle, instret;
+    logic [NUM_HARTS*32-1:0] wait_cycles;
+    logic [31:0]             dbus_rdata;
+
+    assign num_harts = 8'(NUM_HARTS);
+
+    // ==================================
+    // HARTS
+    // ==================================
+    genvar i;
+    generate
+        for (i = 0; i < NUM_HARTS; i++) begin : g_hart
+            /* verilator lint_off PINMISSING */
+            RV32I_Core #(
+                .IMEM_WORDS(IMEM_WORDS),
+                .DMEM_WORDS(DMEM_WORDS),
+                .IMEM_INIT(IMEM_INIT),
+                .HART_ID(i),
+                .EXT_DMEM(1)
+            ) u_core (
+                .clk(clk), .rst(rst),
+                .irq_external(1'b0),
+                .illegal_op(illegal_op[i]),
+                .sim_exit(sim_exit[i]),
+                .sim_exit_code(exit_code[i*32 +: 32]),
+                .dbus_req(dbus_req[i]), .dbus_wen(dbus_wen[i]),
+                .dbus_addr(dbus_addr[i*32 +: 32]), .dbus_wdata(dbus_wdata[i*32 +: 32]),
+                .dbus_byte_mask(dbus_byte_mask[i*3 +: 3]),
+                .dbus_rdata(dbus_rdata), .dbus_gnt(dbus_gnt[i]),
+                .debug_pc(pc[i*32 +: 32]),
+                .debug_cycle(cycle[i*64 +: 64]),
+                .debug_instret(instret[i*64 +: 64])
+            );
+            /* verilator lint_on PINMISSING */
+
+            assign mem_wait[i] = dbus_req[i] && !dbus_gnt[i];
+        end
+    endgenerate
+
+    // ==================================
+    // SHARED DATA MEMORY
+    // ==================================
+    logic        mem_wen;
+    logic [31:0] mem_addr, mem_wdata, mem_rdata;
+    logic [2:0]  mem_byte_mask;
+
+    DMemArbiter #(
+        .N(NUM_HARTS)
+    ) u_arbiter (
+        .clk(clk), .rst(rst),
+        .req(dbus_req), .wen(dbus_wen),
+        .addr(dbus_addr), .wdata(dbus_wdata),
+        .byte_mask(dbus_byte_mask),
+        .gnt(dbus_gnt), .rdata(dbus_rdata),
+        .mem_wen(mem_wen), .mem_addr(mem_addr),
+        .mem_wdata(mem_wdata), .mem_byte_mask(mem_byte_mask),
+        .mem_rdata(mem_rdata),
+        .stat_wait(wait_cycles)
+    );
+
+    DataMem #(
+        .WORDS(DMEM_WORDS),
+        .mem_init(DMEM_INIT)
+    ) u_dataMem (
+        .clk(clk), .wen(mem_wen),
+        .address(mem_addr), .wdata(mem_wdata),
+        .byte_mask(mem_byte_mask),
+        .rdata(mem_rdata)
+    );
+
+    // ==================================
+    // DEBUG
+    // ==================================
+    logic [IDX_W-1:0] sel;
+    assign sel = (int'(dbg_hart) < NUM_HARTS) ? IDX_W'(dbg_hart) : '0;
+
+    assign dbg_pc          = pc[sel*32 +: 32];
+    assign dbg_exit_code   = exit_code[sel*32 +: 32];
+    assign dbg_cycle       = cycle[sel*64 +: 64];
+    assign dbg_instret     = instret[sel*64 +: 64];
+    assign dbg_wait_cycles = wait_cycles[sel*32 +: 32];
+endmodule
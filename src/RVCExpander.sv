@@ -0,0 +1,157 @@
+// RV32C expander: rewrites a 16-bit compressed instruction as its 32-bit
+// RV32I equivalent, so ImmGen/Controller only ever see base encodings.
+//
+// Reserved, RV64-only and floating-point encodings (and the all-zero
+// halfword) expand to 32'h0, which the Controller rejects as illegal.
+// C.EBREAK expands to EBREAK.
+
+module RVCExpander (
+    input  logic [15:0] cinstr,
+    output logic [31:0] instr
+);
+    localparam OP_LOAD   = 7'b0000011;
+    localparam OP_IMM    = 7'b0010011;
+    localparam OP_STORE  = 7'b0100011;
+    localparam OP_REG    = 7'b0110011;
+    localparam OP_LUI    = 7'b0110111;
+    localparam OP_BRANCH = 7'b1100011;
+    localparam OP_JALR   = 7'b1100111;
+    localparam OP_JAL    = 7'b1101111;
+    localparam EBREAK    = 32'h00100073;
+    localparam ILLEGAL   = 32'h00000000;
+
+    localparam [4:0] X0 = 5'd0, RA = 5'd1, SP = 5'd2;
+
+    // 32-bit encoders
+    function automatic logic [31:0] enc_i(input logic [11:0] imm, input logic [4:0] rs1,
+                                          input logic [2:0] f3, input logic [4:0] rd, input logic [6:0] op);
+        enc_i = {imm, rs1, f3, rd, op};
+    endfunction
+
+    function automatic logic [31:0] enc_s(input logic [11:0] imm, input logic [4:0] rs2,
+                                          input logic [4:0] rs1, input logic [2:0] f3);
+        enc_s = {imm[11:5], rs2, rs1, f3, imm[4:0], OP_STORE};
+    endfunction
+
+    function automatic logic [31:0] enc_b(input logic [12:0] imm, input logic [4:0] rs1,
+                                          input logic [2:0] f3);
+        enc_b = {imm[12], imm[10:5], X0, rs1, f3, imm[4:1], imm[11], OP_BRANCH};
+    endfunction
+
+    function automatic logic [31:0] enc_j(input logic [20:0] imm, input logic [4:0] rd);
+        enc_j = {imm[20], imm[10:1], imm[11], imm[19:12], rd, OP_JAL};
+    endfunction
+
+    function automatic logic [31:0] enc_r(input logic [6:0] f7, input logic [4:0] rs2, input logic [4:0] rs1,
+                                          input logic [2:0] f3, input logic [4:0] rd);
+        enc_r = {f7, rs2, rs1, f3, rd, OP_REG};
+    endfunction
+
+    // Common fields
+    logic [4:0]  rd, rs2, rs1_p, rs2_p;
+    logic [11:0] imm6, lw_off, lwsp_off, swsp_off, addi4spn_imm, addi16sp_imm;
+    logic [12:0] b_off;
+    logic [20:0] j_off;
+
+    always_comb begin
+        rd    = cinstr[11:7];
+        rs2   = cinstr[6:2];
+        rs1_p = {2'b01, cinstr[9:7]};       // rs1' (and rd' for CB/CA), x8..x15
+        rs2_p = {2'b01, cinstr[4:2]};       // rs2' (and rd' for CIW/CL)
+
+        imm6         = {{7{cinstr[12]}}, cinstr[6:2]};
+        lw_off       = {5'b0, cinstr[5], cinstr[12:10], cinstr[6], 2'b00};
+        lwsp_off     = {4'b0, cinstr[3:2], cinstr[12], cinstr[6:4], 2'b00};
+        swsp_off     = {4'b0, cinstr[8:7], cinstr[12:9], 2'b00};
+        addi4spn_imm = {2'b0, cinstr[10:7], cinstr[12:11], cinstr[5], cinstr[6], 2'b00};
+        addi16sp_imm = {{3{cinstr[12]}}, cinstr[4:3], cinstr[5], cinstr[2], cinstr[6], 4'b0};
+        b_off        = {{5{cinstr[12]}}, cinstr[6:5], cinstr[2], cinstr[11:10], cinstr[4:3], 1'b0};
+        j_off        = {{10{cinstr[12]}}, cinstr[8], cinstr[10:9], cinstr[6], cinstr[7],
+                        cinstr[2], cinstr[11], cinstr[5:3], 1'b0};
+
+        instr = ILLEGAL;
+
+        case ({cinstr[1:0], cinstr[15:13]})
+            // ---------- Quadrant 0 ----------
+            5'b00_000:  // C.ADDI4SPN
+                if (addi4spn_imm != 12'b0)
+                    instr = enc_i(addi4spn_imm, SP, 3'b000, rs2_p, OP_IMM);
+            5'b00_010:  // C.LW
+                instr = enc_i(lw_off, rs1_p, 3'b010, rs2_p, OP_LOAD);
+            5'b00_110:  // C.SW
+                instr = enc_s(lw_off, rs2_p, rs1_p, 3'b010);
+
+            // ---------- Quadrant 1 ----------
+            5'b01_000:  // C.ADDI / C.NOP
+                instr = enc_i(imm6, rd, 3'b000, rd, OP_IMM);
+            5'b01_001:  // C.JAL
+                instr = enc_j(j_off, RA);
+            5'b01_010:  // C.LI
+                instr = enc_i(imm6, X0, 3'b000, rd, OP_IMM);
+            5'b01_011: begin
+                if (rd == SP) begin     // C.ADDI16SP
+                    if (addi16sp_imm != 12'b0)
+                        instr = enc_i(addi16sp_imm, SP, 3'b000, SP, OP_IMM);
+                end else if (imm6 != 12'b0)     // C.LUI
+                    instr = {{14{cinstr[12]}}, cinstr[12], cinstr[6:2], rd, OP_LUI};
+            end
+            5'b01_100: begin
+                case (cinstr[11:10])
+                    2'b00:  // C.SRLI
+                        if (!cinstr[12])
+                            instr = enc_i({7'b0000000, cinstr[6:2]}, rs1_p, 3'b101, rs1_p, OP_IMM);
+                    2'b01:  // C.SRAI
+                        if (!cinstr[12])
+                            instr = enc_i({7'b0100000, cinstr[6:2]}, rs1_p, 3'b101, rs1_p, OP_IMM);
+                    2'b10:  // C.ANDI
+                        instr = enc_i(imm6, rs1_p, 3'b111, rs1_p, OP_IMM);
+                    default: begin
+                        if (!cinstr[12]) begin
+                            case (cinstr[6:5])
+                                2'b00:   instr = enc_r(7'b0100000, rs2_p, rs1_p, 3'b000, rs1_p);  // C.SUB
+                                2'b01:   instr = enc_r(7'b0000000, rs2_p, rs1_p, 3'b100, rs1_p);  // C.XOR
+                                2'b10:   instr = enc_r(7'b0000000, rs2_p, rs1_p, 3'b110, rs1_p);  // C.OR
+                                default: instr = enc_r(7'b0000000, rs2_p, rs1_p, 3'b111, rs1_p);  // C.AND
+                            endcase
+                        end
+                    end
+                endcase
+            end
+            5'b01_101:  // C.J
+                instr = enc_j(j_off, X0);
+            5'b01_110:  // C.BEQZ
+                instr = enc_b(b_off, rs1_p, 3'b000);
+            5'b01_111:  // C.BNEZ
+                instr = enc_b(b_off, rs1_p, 3'b001);
+
+            // ---------- Quadrant 2 ----------
+            5'b10_000:  // C.SLLI
+                if (!cinstr[12])
+                    instr = enc_i({7'b0000000, cinstr[6:2]}, rd, 3'b001, rd, OP_IMM);
+            5'b10_010:  // C.LWSP
+                if (rd != X0)
+                    instr = enc_i(lwsp_off, SP, 3'b010, rd, OP_LOAD);
+            5'b10_100: begin
+                if (!cinstr[12]) begin
+                    if (rs2 == X0) begin        // C.JR
+                        if (rd != X0)
+                            instr = enc_i(12'b0, rd, 3'b000, X0, OP_JALR);
+                    end else                    // C.MV
+                        instr = enc_r(7'b0000000, rs2, X0, 3'b000, rd);
+                end else begin
+                    if (rs2 == X0 && rd == X0)  // C.EBREAK
+                        instr = EBREAK;
+                    else if (rs2 == X0)         // C.JALR
+                        instr = enc_i(12'b0, rd, 3'b000, RA, OP_JALR);
+                    else                        // C.ADD
+                        instr = enc_r(7'b0000000, rs2, rd, 3'b000, rd);
+                end
+            end
+            5'b10_110:  // C.SWSP
+                instr = enc_s(swsp_off, rs2, SP, 3'b010);
+
+            default: instr = ILLEGAL;       // F/D loads and stores, reserved
+        endcase
+    end
+
+endmodule
@@ -11,7 +11,11 @@
 // x18-x27 |   s2-s11         |   Callee-Saved regs  |   Yes
 // x28-x31 |   t3-t6          |   Temp regs          |   No
 
-module RegFile (
+module RegFile #(
+    // Same-cycle write->read bypass. A single-cycle core reads and writes in
+    // the same cycle, so it must disable this to avoid a wdata->rdata loop.
+    parameter WRITE_FWD = 1
+) (
     input clk, rst, wen,
     input [4:0] rsrc1, rsrc2, wdest,
     input [31:0] wdata,
@@ -30,8 +34,15 @@ module RegFile (
             regs[wdest] <= wdata;
     end
 
-    // Asynchronous reads with write forwarding
-    assign rdata1 = (wen && (rsrc1 == wdest) && wdest != 5'd0) ? wdata : regs[rsrc1];
-    assign rdata2 = (wen && (rsrc2 == wdest) && wdest != 5'd0) ? wdata : regs[rsrc2];
+    // Asynchronous reads with optional write forwarding
+    generate
+        if (WRITE_FWD) begin : g_fwd
+            assign rdata1 = (wen && (rsrc1 == wdest) && wdest != 5'd0) ? wdata : regs[rsrc1];
+            assign rdata2 = (wen && (rsrc2 == wdest) && wdest != 5'd0) ? wdata : regs[rsrc2];
+        end else begin : g_nofwd
+            assign rdata1 = regs[rsrc1];
+            assign rdata2 = regs[rsrc2];
+        end
+    endgenerate
 
 endmodule
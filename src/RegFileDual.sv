@@ -0,0 +1,52 @@
+// RegFile for RV32I_Dual: two read ports and one write port per issue lane
+// (a = lane 0, b = lane 1). Both writes land on the same clock edge; when
+// they name the same register, lane b (the later instruction) wins.
+
+module RegFileDual #(
+    // Same-cycle write->read bypass, as RegFile. A single-cycle core reads
+    // and writes in the same cycle, so it must disable this.
+    parameter WRITE_FWD = 1
+) (
+    input clk, rst,
+    input wen_a, wen_b,
+    input [4:0] rsrc1_a, rsrc2_a, rsrc1_b, rsrc2_b,
+    input [4:0] wdest_a, wdest_b,
+    input [31:0] wdata_a, wdata_b,
+
+    output [31:0] rdata1_a, rdata2_a, rdata1_b, rdata2_b
+);
+    reg [31:0] regs [0:31]; //32 32-bit Registers
+    initial regs[0] = 0;
+
+    logic write_a, write_b;
+    assign write_a = wen_a && wdest_a != 5'd0;
+    assign write_b = wen_b && wdest_b != 5'd0;
+
+    always_ff @(posedge clk) begin
+        if (!rst) begin
+            for (int i = 0; i < 32; i = i + 1) begin
+                regs[i] <= 32'b0;
+            end
+        end else begin
+            if (write_a && !(write_b && wdest_b == wdest_a))
+                regs[wdest_a] <= wdata_a;
+            if (write_b)
+                regs[wdest_b] <= wdata_b;
+        end
+    end
+
+    // Asynchronous reads with optional write forwarding (lane b first)
+    function automatic logic [31:0] read(input logic [4:0] rsrc);
+        if (WRITE_FWD && write_b && rsrc == wdest_b)
+            return wdata_b;
+        if (WRITE_FWD && write_a && rsrc == wdest_a)
+            return wdata_a;
+        return regs[rsrc];
+    endfunction
+
+    assign rdata1_a = read(rsrc1_a);
+    assign rdata2_a = read(rsrc2_a);
+    assign rdata1_b = read(rsrc1_b);
+    assign rdata2_b = read(rsrc2_b);
+
+endmodule
@@ -1,11 +1,10 @@
-#include <stdlib.h>
-#include <iostream>
+#include <map>
+#include <string>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VALU.h"  // Make sure module name matches your ALU Verilog top module
+#include "common/harness.h"
 
-#define MAX_SIM_TIME 200
-vluint64_t sim_time = 0;
+#define RANDOM_VECTORS 2000     // per shard, override with +vectors+N
 
 
 // ALU OpCodes and Strings
@@ -22,6 +21,15 @@ enum AluOps {
     SLTU = 0b1001,
     JALR = 0b1010,
     THRU = 0b1111,
+    // Zba/Zbb/Zbs
+    SH1ADD = 0b010000, SH2ADD = 0b010001, SH3ADD = 0b010010,
+    ANDN   = 0b010011, ORN    = 0b010100, XNOR   = 0b010101,
+    CLZ    = 0b010110, CTZ    = 0b010111, CPOP   = 0b011000,
+    MIN    = 0b011001, MAX    = 0b011010, MINU   = 0b011011, MAXU = 0b011100,
+    SEXTB  = 0b011101, SEXTH  = 0b011110, ZEXTH  = 0b011111,
+    REV8   = 0b100000, ORCB   = 0b100001, ROL    = 0b100010, ROR  = 0b100011,
+    BCLR   = 0b100100, BSET   = 0b100101, BINV   = 0b100110, BEXT = 0b100111,
+    LAST_OP = BEXT,
 };
 
 std::map<AluOps, std::string> aluOpNames = {
@@ -36,10 +44,41 @@ std::map<AluOps, std::string> aluOpNames = {
     {SLT, "SLT"},
     {SLTU, "SLTU"},
     {JALR, "JALR"},
-    {THRU, "THRU"}
+    {THRU, "THRU"},
+    {SH1ADD, "SH1ADD"}, {SH2ADD, "SH2ADD"}, {SH3ADD, "SH3ADD"},
+    {ANDN, "ANDN"}, {ORN, "ORN"}, {XNOR, "XNOR"},
+    {CLZ, "CLZ"}, {CTZ, "CTZ"}, {CPOP, "CPOP"},
+    {MIN, "MIN"}, {MAX, "MAX"}, {MINU, "MINU"}, {MAXU, "MAXU"},
+    {SEXTB, "SEXTB"}, {SEXTH, "SEXTH"}, {ZEXTH, "ZEXTH"},
+    {REV8, "REV8"}, {ORCB, "ORCB"}, {ROL, "ROL"}, {ROR, "ROR"},
+    {BCLR, "BCLR"}, {BSET, "BSET"}, {BINV, "BINV"}, {BEXT, "BEXT"}
 };
 
 // HELPER FUNCTIONS
+// Bit-serial references for the Zbb counts, independent of the RTL's loops
+uint32_t countLeadingZeros(uint32_t x) {
+    uint32_t n = 0;
+    for (int i = 31; i >= 0 && !((x >> i) & 1); i--) n++;
+    return n;
+}
+
+uint32_t countTrailingZeros(uint32_t x) {
+    uint32_t n = 0;
+    for (int i = 0; i < 32 && !((x >> i) & 1); i++) n++;
+    return n;
+}
+
+uint32_t popCount(uint32_t x) {
+    uint32_t n = 0;
+    for (int i = 0; i < 32; i++) n += (x >> i) & 1;
+    return n;
+}
+
+uint32_t rotateLeft(uint32_t x, uint32_t s) {
+    s &= 0x1F;
+    return s ? (x << s) | (x >> (32 - s)) : x;
+}
+
 uint32_t calculateExpected(uint32_t src1, uint32_t src2, uint8_t alu_ctrl) {
     uint32_t expected_result;
 
@@ -80,6 +119,81 @@ uint32_t calculateExpected(uint32_t src1, uint32_t src2, uint8_t alu_ctrl) {
         case THRU:
             expected_result = src2;
             break;
+        case SH1ADD:
+            expected_result = (src1 << 1) + src2;
+            break;
+        case SH2ADD:
+            expected_result = (src1 << 2) + src2;
+            break;
+        case SH3ADD:
+            expected_result = (src1 << 3) + src2;
+            break;
+        case ANDN:
+            expected_result = src1 & ~src2;
+            break;
+        case ORN:
+            expected_result = src1 | ~src2;
+            break;
+        case XNOR:
+            expected_result = ~(src1 ^ src2);
+            break;
+        case CLZ:
+            expected_result = countLeadingZeros(src1);
+            break;
+        case CTZ:
+            expected_result = countTrailingZeros(src1);
+            break;
+        case CPOP:
+            expected_result = popCount(src1);
+            break;
+        case MIN:
+            expected_result = ((int32_t)src1 < (int32_t)src2) ? src1 : src2;
+            break;
+        case MAX:
+            expected_result = ((int32_t)src1 > (int32_t)src2) ? src1 : src2;
+            break;
+        case MINU:
+            expected_result = (src1 < src2) ? src1 : src2;
+            break;
+        case MAXU:
+            expected_result = (src1 > src2) ? src1 : src2;
+            break;
+        case SEXTB:
+            expected_result = (uint32_t)(int32_t)(int8_t)(src1 & 0xFF);
+            break;
+        case SEXTH:
+            expected_result = (uint32_t)(int32_t)(int16_t)(src1 & 0xFFFF);
+            break;
+        case ZEXTH:
+            expected_result = src1 & 0xFFFF;
+            break;
+        case REV8:
+            expected_result = ((src1 & 0xFF) << 24) | ((src1 & 0xFF00) << 8) |
+                              ((src1 >> 8) & 0xFF00) | (src1 >> 24);
+            break;
+        case ORCB:
+            expected_result = 0;
+            for (int b = 0; b < 4; b++)
+                if ((src1 >> (8 * b)) & 0xFF) expected_result |= 0xFFu << (8 * b);
+            break;
+        case ROL:
+            expected_result = rotateLeft(src1, src2);
+            break;
+        case ROR:
+            expected_result = rotateLeft(src1, 32 - (src2 & 0x1F));
+            break;
+        case BCLR:
+            expected_result = src1 & ~(1u << (src2 & 0x1F));
+            break;
+        case BSET:
+            expected_result = src1 | (1u << (src2 & 0x1F));
+            break;
+        case BINV:
+            expected_result = src1 ^ (1u << (src2 & 0x1F));
+            break;
+        case BEXT:
+            expected_result = (src1 >> (src2 & 0x1F)) & 1;
+            break;
         default:
             expected_result = 0;
             break;
@@ -88,59 +202,36 @@ uint32_t calculateExpected(uint32_t src1, uint32_t src2, uint8_t alu_ctrl) {
     return expected_result;
 }
 
-void advance_sim(VALU* dut, VerilatedVcdC* trace) {
-    dut->eval();
-    trace->dump(sim_time);
-    sim_time++;
-}
-
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VALU* dut = new VALU;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/ALU_waveform.vcd");
-
-    // Loop to generate random tests
-    for (uint8_t aluOp = ADD; aluOp <= THRU; aluOp++) {
-        if (sim_time >= MAX_SIM_TIME) break;
-        
-        const char* op_name = aluOpNames[(AluOps)aluOp].c_str();
-        if (aluOp > JALR && aluOp < THRU) { // Invalid operation range
-            op_name = "Invalid";
-        }
-
-        printf("     Testing %-4s\t\t|| SRC1\t\tSRC2\t\tALU_OP\t||\tRESULT\t\tEXPECTED\n", op_name);
-        printf("------------------------------------------------------------------------------------------------------------------\n");
-        
-
-        for (int i = 0; i < 5; i++) {
-            uint32_t src1 = rand();
-            uint32_t src2 = rand();
-            uint32_t expected = calculateExpected(src1, src2, aluOp);
-
-            dut->src1       = src1;
-            dut->src2       = src2;
-            dut->alu_ctrl   = aluOp;
-
-            advance_sim(dut, m_trace);
-
-            printf("[%2lu] %-24s\t|| 0x%08X\t0x%08X\t0x%X\t||\t0x%08X\t0x%08X\n",
-            sim_time,
-            op_name,
-            dut->src1, dut->src2, dut->alu_ctrl,
-            dut->result, expected);
-
-            assert(dut->result == expected && "❌ Incorrect ALU result");
+    uint64_t vectors = tb::Options::get().vectors_or(RANDOM_VECTORS);
+
+    return tb::run<VALU>("ALU", [&](tb::Sim<VALU>& sim, tb::Check& check) {
+        auto test = [&](uint8_t aluOp, uint32_t src1, uint32_t src2) {
+            auto name = aluOpNames.find((AluOps)aluOp);
+            const char* op_name = name == aluOpNames.end() ? "Invalid" : name->second.c_str();
+
+            sim->src1     = src1;
+            sim->src2     = src2;
+            sim->alu_ctrl = aluOp;
+            sim.eval();
+
+            check.expect_eq(sim->result, calculateExpected(src1, src2, aluOp),
+                            "%-6s 0x%08X 0x%08X", op_name, src1, src2);
+        };
+
+        // Shift amounts and sign boundaries, then random operands. The
+        // byte patterns exercise sext/zext/rev8/orc.b; unused codes give 0.
+        const uint32_t corners[] = {0x00000000, 0x00000001, 0x0000001F, 0x00000020,
+                                    0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0x00000080,
+                                    0x00008000, 0x12345678, 0x00FF0100};
+        for (uint8_t aluOp = ADD; aluOp <= LAST_OP + 1; aluOp++) {
+            if (check.shard() == 0)
+                for (uint32_t src1 : corners)
+                    for (uint32_t src2 : corners)
+                        test(aluOp, src1, src2);
+            for (uint64_t i = 0; i < vectors / (LAST_OP + 2); i++)
+                test(aluOp, check.rand32(), check.rand32());
         }
-        printf("\n");
-    }
-
-    printf("✅ All ALU test cases passed!\n");
-
-    m_trace->close();
-    delete dut;
-    return 0;
-}
\ No newline at end of file
+    });
+}
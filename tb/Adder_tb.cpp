@@ -1,19 +1,12 @@
-#include <iostream>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VAdder.h"
+#include "common/harness.h"
 
-#define MAX_SIM_TIME 100
-vluint64_t sim_time = 0;
+#define RANDOM_VECTORS 2000     // per shard, override with +vectors+N
 
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VAdder* dut = new VAdder;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/Adder_waveform.vcd");
+    uint64_t vectors = tb::Options::get().vectors_or(RANDOM_VECTORS);
 
     struct TestCase {
         uint32_t src1;
@@ -33,30 +26,22 @@ int main(int argc, char** argv, char** env) {
         {0xDEADBEEF, 0x00000001, 0xDEADBEF0, "Carry through lower bits"},
     };
 
-    printf("     Test\t\t\t\t||\tSRC1\t\tSRC2\t\tEXPECTED\tRESULT\n");
-    printf("------------------------------------------------------------------------------------------------------------\n");
-
-    for (auto test : test_cases) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        dut->src1 = test.src1;
-        dut->src2 = test.src2;
-
-        dut->eval(); 
-        m_trace->dump(sim_time++);
-
-        printf("[%2lu] %-27s\t||\t0x%08X\t0x%08X\t0x%08X\t0x%08X\t\n",
-            sim_time,
-            test.description,
-            test.src1, test.src2,
-            test.expected_result,
-            dut->result);
-
-        assert(dut->result == test.expected_result && "❌ Incorrect adder result");
-    }
-
-    printf("✅ All adder test cases passed!\n");
-    m_trace->close();
-    delete dut;
-    return 0;
+    return tb::run<VAdder>("Adder", [&](tb::Sim<VAdder>& sim, tb::Check& check) {
+        if (check.shard() == 0) {
+            for (auto test : test_cases) {
+                sim->src1 = test.src1;
+                sim->src2 = test.src2;
+                sim.eval();
+                check.expect_eq(sim->result, test.expected_result, "%s", test.description);
+            }
+        }
+
+        for (uint64_t i = 0; i < vectors; i++) {
+            uint32_t src1 = check.rand32(), src2 = check.rand32();
+            sim->src1 = src1;
+            sim->src2 = src2;
+            sim.eval();
+            check.expect_eq(sim->result, src1 + src2, "0x%08X + 0x%08X", src1, src2);
+        }
+    });
 }
@@ -1,12 +1,12 @@
-#include <iostream>
-#include <vector>
+#include <map>
+#include <string>
 #include <utility>
+#include <vector>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VBranchHandler.h"  // Ensure this matches the compiled Verilator wrapper name
+#include "common/harness.h"
 
-#define MAX_SIM_TIME 100
-vluint64_t sim_time = 0;
+#define RANDOM_VECTORS 2000     // per shard, override with +vectors+N
 
 enum BranchCond {
     NOB  = 0b000,
@@ -45,21 +45,9 @@ bool expectedBranch(uint32_t src1, uint32_t src2, uint8_t cond) {
     }
 }
 
-// Advance simulation and dump wave
-void advance_sim(VBranchHandler* dut, VerilatedVcdC* trace) {
-    dut->eval();
-    trace->dump(sim_time);
-    sim_time++;
-}
-
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VBranchHandler* dut = new VBranchHandler;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/BranchHandler_waveform.vcd");
+    uint64_t vectors = tb::Options::get().vectors_or(RANDOM_VECTORS);
 
     // 6 deterministic test cases: 2 equal, 2 signed, 2 unsigned
     std::vector<std::pair<uint32_t, uint32_t>> test_cases = {
@@ -71,42 +59,25 @@ int main(int argc, char** argv, char** env) {
         {0xFFFFFFFE, 0xFFFFFFFD}   // Unsigned >, Signed < (both negative)
     };
 
-    for (uint8_t cond = NOB; cond <= JMP; cond++) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        const char* cond_name = branchCondNames[(BranchCond)cond].c_str();
-
-        printf("     Testing %-5s\t|| SRC1\t\tSRC2\t\tCOND\t||\tBRANCHED\tEXPECTED\n", cond_name);
-        printf("------------------------------------------------------------------------------------------------------\n");
-
-        for (size_t i = 0; i < test_cases.size(); i++) {
-            uint32_t src1 = test_cases[i].first;
-            uint32_t src2 = test_cases[i].second;
-
-            bool expected = expectedBranch(src1, src2, cond);
-
-            dut->src1 = src1;
-            dut->src2 = src2;
-            dut->branch_cond = cond;
-
-            advance_sim(dut, m_trace);
-
-            printf("[%2lu] %-16s\t|| 0x%08X\t0x%08X\t0x%X\t||\t%s\t\t%s\n",
-                   sim_time,
-                   cond_name,
-                   dut->src1, dut->src2, dut->branch_cond,
-                   dut->branched ? "true " : "false",
-                   expected ? "true " : "false");
-
-            assert(dut->branched == expected && "❌ BranchHandler incorrect result");
+    return tb::run<VBranchHandler>("BranchHandler", [&](tb::Sim<VBranchHandler>& sim, tb::Check& check) {
+        auto test = [&](uint8_t cond, uint32_t src1, uint32_t src2) {
+            sim->src1 = src1;
+            sim->src2 = src2;
+            sim->branch_cond = cond;
+            sim.eval();
+            check.expect_eq(sim->branched, expectedBranch(src1, src2, cond), "%-4s 0x%08X 0x%08X",
+                            branchCondNames.at((BranchCond)cond).c_str(), src1, src2);
+        };
+
+        for (uint8_t cond = NOB; cond <= JMP; cond++) {
+            if (check.shard() == 0)
+                for (auto& tc : test_cases) test(cond, tc.first, tc.second);
+
+            // Random operands; every fourth pair equal, so BEQ/BGE take both ways
+            for (uint64_t i = 0; i < vectors / (JMP + 1); i++) {
+                uint32_t src1 = check.rand32();
+                test(cond, src1, (i & 3) == 0 ? src1 : check.rand32());
+            }
         }
-
-        printf("\n");
-    }
-
-    printf("✅ All BranchHandler test cases passed!\n");
-
-    m_trace->close();
-    delete dut;
-    return 0;
+    });
 }
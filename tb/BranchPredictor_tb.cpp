@@ -0,0 +1,170 @@
+#include <iostream>
+#include <cassert>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "VBranchPredictor.h"
+
+#define MAX_SIM_TIME 500
+vluint64_t sim_time = 0;
+
+// Instructions used for updates
+#define BEQ_BACK  0xfe2080e3    // beq  x1, x2, -0x20
+#define CALL_FWD  0x100000ef    // jal  x1, +0x100
+#define CALL_BACK 0xf01ff0ef    // jal  x1, -0x100
+#define RET       0x00008067    // jalr x0, 0(x1)
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    VBranchPredictor* dut = new VBranchPredictor;
+
+    Verilated::traceEverOn(true);
+    VerilatedVcdC* m_trace = new VerilatedVcdC;
+    dut->trace(m_trace, 5);
+    m_trace->open("VCD/BranchPredictor_waveform.vcd");
+
+    // Each row looks up `pc`, checks the prediction, then (optionally)
+    // resolves the instruction at `pc` on the clock edge. The mispredict
+    // flag is derived from the prediction the same way the cores do it.
+    // Default parameters: 16-entry BTB, 64-entry gshare BHT with 6 bits of
+    // history, 4-deep RAS.
+    struct TestCase {
+        uint32_t pc;
+        bool     expected_taken;
+        uint32_t expected_target;   // checked when taken
+        bool     update;
+        uint32_t instr;
+        bool     taken;
+        uint32_t target;
+        const char* description;
+        uint32_t length = 4;        // 2: a compressed instruction (its call pushes pc + 2)
+    } test_cases[] = {
+        // Always-taken loop branch: each update moves the history, so the
+        // counters warm up at new gshare indices until the history saturates.
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: BTB cold"},
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: GHR 000001"},
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: GHR 000011"},
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: GHR 000111"},
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: GHR 001111"},
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: GHR 011111"},
+        {0x040, 0, 0,     1, BEQ_BACK, 1, 0x020, "Loop branch: GHR 111111 (weak)"},
+        {0x040, 1, 0x020, 1, BEQ_BACK, 1, 0x020, "Loop branch: trained"},
+        {0x040, 1, 0x020, 1, BEQ_BACK, 1, 0x020, "Loop branch: strongly taken"},
+        {0x040, 1, 0x020, 1, BEQ_BACK, 1, 0x020, "Loop branch: steady"},
+
+        // Calls and returns
+        {0x100, 0, 0,     1, CALL_FWD,  1, 0x200, "Call from 0x100: BTB cold"},
+        {0x100, 1, 0x200, 0, 0,         0, 0,     "Call from 0x100: BTB hit"},
+        {0x208, 0, 0,     1, RET,       1, 0x104, "Return: BTB cold"},
+        {0x300, 0, 0,     1, CALL_BACK, 1, 0x200, "Call from 0x300: BTB conflict"},
+        {0x208, 1, 0x304, 1, RET,       1, 0x304, "Return: target from RAS"},
+        {0x208, 1, 0x304, 0, 0,         0, 0,     "Return: RAS empty, BTB target"},
+        {0x400, 0, 0,     1, CALL_FWD,  1, 0x500, "C.JAL from 0x400: BTB cold", 2},
+        {0x208, 1, 0x402, 1, RET,       1, 0x402, "Return: to 0x402 after a C.JAL"},
+    };
+
+    printf("    Predictor Test\t\t\t\t||\tPC\tPred\tTarget\t\t||\tActual\tTarget\n");
+    printf("---------------------------------------------------------------------------------------------------------------\n");
+
+    // Reset
+    dut->rst = 0;
+    dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+    dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+    dut->rst = 1;
+
+    for (auto& test : test_cases) {
+        if (sim_time >= MAX_SIM_TIME) break;
+
+        dut->pc = test.pc;
+        dut->upd_valid = 0;
+        dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+
+        bool     pred_taken  = dut->pred_taken;
+        uint32_t pred_target = dut->pred_target;
+        uint8_t  pred_ghr    = dut->pred_ghr;
+        uint32_t pred_next   = pred_taken ? pred_target : test.pc + test.length;
+        uint32_t actual_next = test.taken ? test.target : test.pc + test.length;
+
+        printf("[%2lu] %-40s\t||\t0x%03X\t%d\t0x%08X\t||\t%d\t0x%08X\n",
+               sim_time / 2,
+               test.description,
+               test.pc, pred_taken, pred_target,
+               test.taken, test.target);
+
+        assert(pred_taken == test.expected_taken && "❌ Taken prediction mismatch");
+        if (test.expected_taken)
+            assert(pred_target == test.expected_target && "❌ Target prediction mismatch");
+
+        dut->upd_valid      = test.update;
+        dut->upd_pc         = test.pc;
+        dut->upd_seq_pc     = test.pc + test.length;
+        dut->upd_instr      = test.instr;
+        dut->upd_taken      = test.taken;
+        dut->upd_target     = test.target;
+        dut->upd_ghr        = pred_ghr;
+        dut->upd_mispredict = pred_next != actual_next;
+        dut->eval();
+        dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+    }
+
+    printf("\nBranches: %u (%u mispredicted)  Jumps: %u (%u mispredicted)\n",
+           dut->stat_branches, dut->stat_branch_miss, dut->stat_jumps, dut->stat_jump_miss);
+
+    assert(dut->stat_branches == 10 && dut->stat_branch_miss == 7 && "❌ Branch accuracy counters");
+    assert(dut->stat_jumps == 6 && dut->stat_jump_miss == 4 && "❌ Jump accuracy counters");
+
+    // Two branches in flight, as in RV32I_Pipe: both are fetched before the
+    // first resolves, so the first one's outcome shifts the history between
+    // the second one's prediction and its update. A alternates and B
+    // repeats A's outcome, which B's fetch-time history determines. Trained
+    // at the counters they were predicted with, both are predicted right
+    // once warm; training B with the live history never gets there.
+    const uint32_t PC_A = 0x040, PC_B = 0x084;
+    dut->rst = 0;
+    dut->upd_valid = 0;
+    dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+    dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+    dut->rst = 1;
+
+    printf("\n    In-flight pair\t||\tA: pred\tactual\t||\tB: pred\tactual\n");
+    for (int k = 0; k < 16 && sim_time < MAX_SIM_TIME; k++) {
+        bool outcome = k & 1;
+        struct Fetched { uint32_t pc, target; bool taken; uint8_t ghr; } inflight[2];
+        const uint32_t pcs[2] = {PC_A, PC_B};
+        for (int i = 0; i < 2; i++) {
+            dut->pc = pcs[i];
+            dut->eval();
+            inflight[i] = {pcs[i], dut->pred_target, (bool)dut->pred_taken, dut->pred_ghr};
+        }
+        printf("[%2d] iteration\t\t||\t%d\t%d\t||\t%d\t%d\n", k, inflight[0].taken, outcome,
+               inflight[1].taken, outcome);
+        if (k >= 4) {
+            assert(inflight[0].taken == outcome && "❌ In-flight pair: branch A mispredicted once warm");
+            assert(inflight[1].taken == outcome && "❌ In-flight pair: branch B mispredicted once warm");
+        }
+
+        for (const Fetched& f : inflight) {
+            uint32_t target = f.pc - 0x20;
+            uint32_t pred_next = f.taken ? f.target : f.pc + 4;
+            dut->upd_valid      = 1;
+            dut->upd_pc         = f.pc;
+            dut->upd_seq_pc     = f.pc + 4;
+            dut->upd_instr      = BEQ_BACK;
+            dut->upd_taken      = outcome;
+            dut->upd_target     = target;
+            dut->upd_ghr        = f.ghr;
+            dut->upd_mispredict = pred_next != (outcome ? target : f.pc + 4);
+            dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+            dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+        }
+        dut->upd_valid = 0;
+    }
+
+    printf("\nIn-flight branches: %u (%u mispredicted)\n", dut->stat_branches, dut->stat_branch_miss);
+    assert(dut->stat_branches == 32 && dut->stat_branch_miss == 4 && "❌ In-flight pair accuracy counters");
+
+    printf("✅ All BranchPredictor test cases passed!\n");
+
+    m_trace->close();
+    delete dut;
+    return 0;
+}
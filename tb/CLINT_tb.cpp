@@ -0,0 +1,66 @@
+#include <verilated.h>
+#include "VCLINT.h"
+#include "common/harness.h"
+
+// Random word accesses, mostly to the CLINT registers, while mtime runs
+// (and sometimes jumps) under them. Reads, msip and mtip are checked
+// against a model every cycle, with an occasional reset.
+static const uint16_t OFFSETS[] = {0x0000, 0x4000, 0x4004, 0xBFF8, 0xBFFC, 0x0004, 0x8000};
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    return tb::run<VCLINT>("CLINT", [](tb::Sim<VCLINT>& sim, tb::Check& check) {
+        uint64_t vectors = tb::Options::get().vectors_or(20000);
+        uint64_t mtime = 0, mtimecmp = ~0ull;
+        bool msip = false;
+
+        sim->sel = 0;
+        sim->mtime = mtime;
+        sim.reset();
+
+        for (uint64_t v = 0; v < vectors; v++) {
+            bool rst = check.rand_below(256) != 0;
+            bool sel = check.rand_below(2);
+            bool wen = check.rand_below(2);
+            uint16_t offset = OFFSETS[check.rand_below(sizeof(OFFSETS) / sizeof(OFFSETS[0]))];
+            uint32_t wdata = check.rand32();
+            // Keep mtime close to mtimecmp now and then, so both sides of the compare are hit
+            if (check.rand_below(64) == 0)
+                mtime = check.rand_below(2) ? mtimecmp - check.rand_below(4) : ((uint64_t)check.rand32() << 32) | check.rand32();
+
+            sim->rst = rst;
+            sim->sel = sel;
+            sim->wen = wen;
+            sim->offset = offset;
+            sim->wdata = wdata;
+            sim->mtime = mtime;
+            sim->clk = 0;
+            sim.eval();
+
+            uint32_t expected = 0;
+            switch (offset) {
+                case 0x0000: expected = msip; break;
+                case 0x4000: expected = (uint32_t)mtimecmp; break;
+                case 0x4004: expected = (uint32_t)(mtimecmp >> 32); break;
+                case 0xBFF8: expected = (uint32_t)mtime; break;
+                case 0xBFFC: expected = (uint32_t)(mtime >> 32); break;
+            }
+            check.expect_eq(sim->rdata, expected, "vector %lu: read of 0x%04X", (unsigned long)v, offset);
+            check.expect_eq(sim->msip, msip, "vector %lu: msip", (unsigned long)v);
+            check.expect_eq(sim->mtip, mtime >= mtimecmp, "vector %lu: mtip (mtime 0x%lX, mtimecmp 0x%lX)",
+                            (unsigned long)v, (unsigned long)mtime, (unsigned long)mtimecmp);
+
+            sim->clk = 1;
+            sim.eval();
+            if (!rst) {
+                msip = false;
+                mtimecmp = ~0ull;
+            } else if (sel && wen) {
+                if (offset == 0x0000) msip = wdata & 1;
+                if (offset == 0x4000) mtimecmp = (mtimecmp & ~0xFFFFFFFFull) | wdata;
+                if (offset == 0x4004) mtimecmp = (mtimecmp & 0xFFFFFFFFull) | ((uint64_t)wdata << 32);
+            }
+            mtime++;
+        }
+    });
+}
@@ -0,0 +1,184 @@
+#include <iostream>
+#include <cassert>
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "VCSRFile.h"
+
+#define MAX_SIM_TIME 300
+vluint64_t sim_time = 0;
+
+// CSR func3 codes
+enum CsrOps {
+    CSRRW  = 0b001, CSRRS  = 0b010, CSRRC  = 0b011,
+    CSRRWI = 0b101, CSRRSI = 0b110, CSRRCI = 0b111
+};
+
+// Event bits: {illegal, jump, store, load, taken branch}
+enum Events {
+    EV_NONE = 0, EV_BRANCH = 1 << 0, EV_LOAD = 1 << 1, EV_STORE = 1 << 2,
+    EV_JUMP = 1 << 3, EV_ILLEGAL = 1 << 4
+};
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    VCSRFile* dut = new VCSRFile;
+
+    Verilated::traceEverOn(true);
+    VerilatedVcdC* m_trace = new VerilatedVcdC;
+    dut->trace(m_trace, 5);
+    m_trace->open("VCD/CSRFile_waveform.vcd");
+
+    bool reset = false;
+
+    // Outputs are checked before the clock edge; the edge then applies
+    // the write and the counter increments for that cycle.
+    struct TestCase {
+        bool     rst;
+        bool     csr_en;
+        uint8_t  csr_op;
+        uint16_t csr_addr;
+        uint8_t  zimm;
+        uint32_t src;
+        uint8_t  events;
+        uint32_t expected_rdata;
+        bool     expected_illegal;
+        const char* description;
+    } test_cases[] = {
+        {reset,  0, CSRRS,  0x000, 0, 0,     EV_NONE,  0x000, 0, "Reset: counters zeroed"},
+        {!reset, 1, CSRRS,  0xC00, 0, 0,     EV_LOAD,  0x000, 0, "rdcycle after reset"},
+        {!reset, 1, CSRRS,  0xC02, 0, 0,     EV_LOAD,  0x001, 0, "rdinstret"},
+        {!reset, 1, CSRRS,  0xC04, 0, 0,     EV_NONE,  0x002, 0, "hpmcounter4 counts loads"},
+        {!reset, 1, CSRRWI, 0x323, 3, 0,     EV_NONE,  0x001, 0, "mhpmevent3 <- stores"},
+        {!reset, 1, CSRRS,  0x323, 0, 0,     EV_STORE, 0x003, 0, "Read back mhpmevent3"},
+        {!reset, 1, CSRRS,  0xC03, 0, 0,     EV_NONE,  0x001, 0, "hpmcounter3 counted store"},
+        {!reset, 1, CSRRW,  0xB00, 0, 0x100, EV_NONE,  0x006, 0, "mcycle <- 0x100"},
+        {!reset, 1, CSRRS,  0xC00, 0, 0,     EV_NONE,  0x100, 0, "rdcycle after write"},
+        {!reset, 1, CSRRW,  0xC00, 1, 0x5,   EV_NONE,  0x000, 1, "Write to read-only cycle"},
+        {!reset, 1, CSRRS,  0x7C0, 0, 0,     EV_NONE,  0x000, 1, "Unknown CSR"},
+        {!reset, 1, CSRRSI, 0xC02, 0, 0,     EV_NONE,  0x00A, 0, "CSRRSI x0 on read-only"},
+        {!reset, 1, CSRRWI, 0x320, 1, 0,     EV_NONE,  0x000, 0, "Inhibit mcycle"},
+        {!reset, 1, CSRRS,  0xC00, 0, 0,     EV_NONE,  0x105, 0, "rdcycle while inhibited"},
+        {!reset, 1, CSRRS,  0xC00, 0, 0,     EV_NONE,  0x105, 0, "rdcycle still held"},
+        {!reset, 1, CSRRC,  0xB80, 0, 0,     EV_NONE,  0x000, 0, "mcycleh"},
+        {!reset, 1, CSRRS,  0xF14, 0, 0,     EV_NONE,  0x000, 0, "mhartid (HART_ID 0)"},
+        {!reset, 1, CSRRS,  0xF11, 0, 0,     EV_NONE,  0x000, 0, "mvendorid reads 0"},
+        {!reset, 1, CSRRW,  0xF14, 0, 0x1,   EV_NONE,  0x000, 1, "Write to read-only mhartid"},
+        {!reset, 1, CSRRS,  0xF15, 0, 0,     EV_NONE,  0x000, 1, "Unknown machine info CSR"},
+    };
+
+    printf("    CSRFile Test\t\t\t||\top\taddr\tsrc\t\t||\trdata\t\tillegal\n");
+    printf("-------------------------------------------------------------------------------------------------------------\n");
+
+    for (auto& test : test_cases) {
+        if (sim_time >= MAX_SIM_TIME) break;
+
+        dut->rst       = test.rst;
+        dut->csr_en    = test.csr_en;
+        dut->csr_op    = test.csr_op;
+        dut->csr_addr  = test.csr_addr;
+        dut->csr_zimm  = test.zimm;
+        dut->csr_src   = test.src;
+        dut->retire    = test.rst;
+        dut->events    = test.events;
+
+        dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+
+        printf("[%2lu] %-30s\t||\t%d\t0x%03X\t0x%08X\t||\t0x%08X\t%d\n",
+               sim_time / 2,
+               test.description,
+               test.csr_op, test.csr_addr, test.src,
+               dut->csr_rdata, dut->csr_illegal);
+
+        if (test.rst) {
+            assert(dut->csr_rdata == test.expected_rdata && "❌ csr_rdata mismatch");
+            assert(dut->csr_illegal == test.expected_illegal && "❌ csr_illegal mismatch");
+        }
+
+        dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+    }
+
+    // +traps: the trap CSRs of a TRAPS=1 build (VFLAGS=-GTRAPS=1; Verimax
+    // runs it as CSRFile:traps). The outputs are checked before the edge,
+    // as above; trap_cause also picks the trap_vector that is checked.
+    struct TrapCase {
+        bool     csr_en;
+        uint8_t  csr_op;
+        uint16_t csr_addr;
+        uint32_t src;
+        uint8_t  irq;           // {MEIP, MTIP, MSIP}
+        bool     trap_enter, mret;
+        uint32_t cause, epc, tval;
+        uint32_t expected_rdata;
+        bool     expected_illegal, expected_pending;
+        uint32_t expected_vector;
+        const char* description;
+    } trap_cases[] = {
+        {1, CSRRS, 0x300, 0,      0, 0, 0, 0,          0,    0,      0x00001800, 0, 0, 0x000, "mstatus after reset (MPP = M)"},
+        {1, CSRRS, 0x301, 0,      0, 0, 0, 0,          0,    0,      0x40001102, 0, 0, 0x000, "misa"},
+        {1, CSRRW, 0x305, 0x203,  0, 0, 0, 0,          0,    0,      0x00000000, 0, 0, 0x000, "mtvec <- 0x203"},
+        {1, CSRRS, 0x305, 0,      0, 0, 0, 2,          0,    0,      0x00000201, 0, 0, 0x200, "mtvec: reserved mode 3 -> 1"},
+        {1, CSRRW, 0x304, 0xFFFF, 0, 0, 0, 2,          0,    0,      0x00000000, 0, 0, 0x200, "mie <- all ones"},
+        {1, CSRRS, 0x304, 0,      2, 0, 0, 2,          0,    0,      0x00000888, 0, 0, 0x200, "mie keeps MSIE/MTIE/MEIE"},
+        {1, CSRRS, 0x344, 0,      2, 0, 0, 2,          0,    0,      0x00000080, 0, 0, 0x200, "mip: MTIP (raw irq, not masked)"},
+        {1, CSRRSI,0x300, 8,      2, 0, 0, 0x80000007, 0,    0,      0x00001800, 0, 0, 0x21C, "Set mstatus.MIE"},
+        {0, CSRRS, 0x300, 0,      2, 1, 0, 0x80000007, 0x44, 0,      0x00001808, 0, 1, 0x21C, "Timer interrupt taken"},
+        {1, CSRRS, 0x300, 0,      2, 0, 0, 0,          0,    0,      0x00001880, 0, 0, 0x200, "mstatus: MPIE = 1, MIE = 0"},
+        {1, CSRRS, 0x341, 0,      2, 0, 0, 0,          0,    0,      0x00000044, 0, 0, 0x200, "mepc"},
+        {1, CSRRS, 0x342, 0,      2, 0, 0, 0,          0,    0,      0x80000007, 0, 0, 0x200, "mcause"},
+        {0, CSRRS, 0x300, 0,      0, 0, 1, 0,          0,    0,      0x00001880, 0, 0, 0x200, "MRET"},
+        {1, CSRRS, 0x300, 0,      7, 0, 0, 0x8000000B, 0,    0,      0x00001888, 0, 1, 0x22C, "MIE back; MEI first of all three"},
+        {0, CSRRS, 0x300, 0,      0, 1, 0, 2,          0x80, 0x73,   0x00001888, 0, 0, 0x200, "Illegal instruction (not vectored)"},
+        {1, CSRRS, 0x343, 0,      0, 0, 0, 0,          0,    0,      0x00000073, 0, 0, 0x200, "mtval"},
+        {1, CSRRW, 0x340, 0xCAFE, 0, 0, 0, 0,          0,    0,      0x00000000, 0, 0, 0x200, "mscratch <- 0xCAFE"},
+        {1, CSRRW, 0x341, 0x103,  0, 0, 0, 0,          0,    0,      0x00000080, 0, 0, 0x200, "mepc <- 0x103"},
+        {1, CSRRS, 0x341, 0,      0, 0, 0, 0,          0,    0,      0x00000102, 0, 0, 0x200, "mepc bit 0 reads 0"},
+        {1, CSRRW, 0x344, 0x888,  1, 0, 0, 0,          0,    0,      0x00000008, 0, 0, 0x200, "Writes to mip are ignored"},
+        {1, CSRRS, 0x310, 0,      0, 0, 0, 0,          0,    0,      0x00000000, 0, 0, 0x200, "mstatush reads 0"},
+        {1, CSRRS, 0x345, 0,      0, 0, 0, 0,          0,    0,      0x00000000, 1, 0, 0x200, "Unknown trap CSR"},
+    };
+
+    bool traps = Verilated::commandArgsPlusMatch("traps")[0] != '\0';
+    if (traps) {
+        dut->rst = 0;
+        dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+        dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+        dut->rst = 1;
+        dut->retire = 0;
+        dut->events = EV_NONE;
+
+        for (auto& test : trap_cases) {
+            dut->csr_en     = test.csr_en;
+            dut->csr_op     = test.csr_op;
+            dut->csr_addr   = test.csr_addr;
+            dut->csr_zimm   = test.csr_op & 4 ? test.src : 0;
+            dut->csr_src    = test.src;
+            dut->irq        = test.irq;
+            dut->trap_enter = test.trap_enter;
+            dut->mret       = test.mret;
+            dut->trap_cause = test.cause;
+            dut->trap_epc   = test.epc;
+            dut->trap_tval  = test.tval;
+
+            dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
+
+            printf("[%2lu] %-34s\t||\t0x%03X\t||\t0x%08X\t%d\tpending %d\tvector 0x%03X\n",
+                   sim_time / 2, test.description, test.csr_addr,
+                   dut->csr_rdata, dut->csr_illegal, dut->irq_pending, dut->trap_vector);
+
+            assert(dut->csr_rdata == test.expected_rdata && "❌ csr_rdata mismatch");
+            assert(dut->csr_illegal == test.expected_illegal && "❌ csr_illegal mismatch");
+            assert(dut->irq_pending == test.expected_pending && "❌ irq_pending mismatch");
+            assert(dut->trap_vector == test.expected_vector && "❌ trap_vector mismatch");
+            if (test.expected_pending)
+                assert(dut->irq_cause == test.cause && "❌ irq_cause mismatch");
+
+            dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+        }
+    }
+
+    printf("✅ All CSRFile test cases passed%s!\n", traps ? " (with the trap CSRs)" : "");
+
+    m_trace->close();
+    delete dut;
+    return 0;
+}
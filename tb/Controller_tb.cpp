@@ -1,18 +1,19 @@
-#include <iostream>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VController.h"
-#include <cassert>
-#include <iomanip>
-
-#define MAX_SIM_TIME 1000
-vluint64_t sim_time = 0;
+#include "common/harness.h"
 
 // Enums for decoding
 enum ALU_CTRL {
     ALU_ADD  = 0b0000, ALU_SUB  = 0b0001, ALU_XOR  = 0b0010, ALU_OR   = 0b0011,
     ALU_AND  = 0b0100, ALU_SLL  = 0b0101, ALU_SRL  = 0b0110, ALU_SRA  = 0b0111,
-    ALU_SLT  = 0b1000, ALU_SLTU = 0b1001, ALU_JALR = 0b1010, ALU_THRU = 0b1111
+    ALU_SLT  = 0b1000, ALU_SLTU = 0b1001, ALU_JALR = 0b1010, ALU_THRU = 0b1111,
+    // Zba/Zbb/Zbs
+    ALU_SH1ADD = 0b010000, ALU_SH2ADD = 0b010001, ALU_SH3ADD = 0b010010, ALU_ANDN = 0b010011,
+    ALU_ORN    = 0b010100, ALU_XNOR   = 0b010101, ALU_CLZ    = 0b010110, ALU_CTZ  = 0b010111,
+    ALU_CPOP   = 0b011000, ALU_MIN    = 0b011001, ALU_MAX    = 0b011010, ALU_MINU = 0b011011,
+    ALU_MAXU   = 0b011100, ALU_SEXTB  = 0b011101, ALU_SEXTH  = 0b011110, ALU_ZEXTH = 0b011111,
+    ALU_REV8   = 0b100000, ALU_ORCB   = 0b100001, ALU_ROL    = 0b100010, ALU_ROR  = 0b100011,
+    ALU_BCLR   = 0b100100, ALU_BSET   = 0b100101, ALU_BINV   = 0b100110, ALU_BEXT = 0b100111
 };
 
 enum BRANCH_CTRL {
@@ -21,7 +22,7 @@ enum BRANCH_CTRL {
 };
 
 enum WB_SEL {
-    RES_WB = 0b00, MEM_WB = 0b01, PC_WB = 0b10
+    RES_WB = 0b00, MEM_WB = 0b01, PC_WB = 0b10, CSR_WB = 0b11
 };
 
 enum BYTE_MASK {
@@ -38,6 +39,9 @@ struct ControlOutput {
     bool    alu_imm_sel;
     bool    mem_wen;
     bool    illegal_op;
+    bool    csr_en = false;
+    bool    muldiv_en = false;
+    bool    sys_exit = false;
 };
 
 struct TestCase {
@@ -46,85 +50,40 @@ struct TestCase {
     uint8_t func7;
     const char* description;
     ControlOutput expected;
+    uint8_t rs2 = 0;        // instr[24:20]: selects the Zbb unary ops
+    uint8_t rs1 = 0;        // instr[19:15]
+    uint8_t rd = 0;         // instr[11:7]
 };
 
-// ---------- Enum name printers ----------
-const char* alu_ctrl_name(uint8_t code) {
-    switch (code) {
-        case ALU_ADD: return "ADD"; case ALU_SUB: return "SUB"; case ALU_XOR: return "XOR";
-        case ALU_OR:  return "OR";  case ALU_AND: return "AND"; case ALU_SLL: return "SLL";
-        case ALU_SRL: return "SRL"; case ALU_SRA: return "SRA"; case ALU_SLT: return "SLT";
-        case ALU_SLTU:return "SLTU";case ALU_JALR:return "JALR";case ALU_THRU:return "THRU";
-        default: return "???";
-    }
-}
-
-const char* byte_mask_name(uint8_t code) {
-    switch (code) {
-        case BM_BYTE: return "BYTE"; case BM_HALF: return "HALF"; case BM_WORD: return "WORD";
-        case BM_BYTEu: return "BYTEu"; case BM_HALFu: return "HALFu";
-        default: return "???";
-    }
-}
-
-const char* branch_name(uint8_t code) {
-    switch (code) {
-        case NOB_CTRL: return "NONE"; case BEQ_CTRL: return "BEQ"; case BNE_CTRL: return "BNE";
-        case BLT_CTRL: return "BLT";  case BGE_CTRL: return "BGE"; case BLTU_CTRL: return "BLTU";
-        case BGEU_CTRL:return "BGEU"; case JMP_CTRL: return "JMP"; default: return "???";
-    }
-}
-
-const char* wb_sel_name(uint8_t code) {
-    switch (code) {
-        case RES_WB: return "RES"; case MEM_WB: return "MEM"; case PC_WB: return "PC";
-        default: return "???";
-    }
-}
-
-// ---------- Test Result Printer ----------
-void print_result(vluint64_t time, const TestCase& test, VController* dut) {
-    std::cout << "[" << std::setw(2) << time << "] "
-              << std::left << std::setw(22) << test.description
-              << " | " << std::setw(5) << alu_ctrl_name(dut->alu_ctrl)
-              << "\t" << std::setw(5) << byte_mask_name(dut->byte_mask)
-              << "\t" << std::setw(5) << branch_name(dut->branch_cond)
-              << "\t" << std::setw(4) << wb_sel_name(dut->wb_sel)
-              << " | " << (dut->reg_wen ? '1' : '0') // Explicitly print '1' or '0'
-              << "\t" << (dut->alu_pc_sel ? '1' : '0')
-              << "\t" << (dut->alu_imm_sel ? '1' : '0')
-              << "\t" << (dut->mem_wen ? '1' : '0')
-              << "\t" << (dut->illegal_op ? '1' : '0')
-              << std::endl;
-}
-
 // ---------- Output Validator ----------
-void check_outputs(VController* dut, const TestCase& test) {
-    assert(dut->alu_ctrl    == test.expected.alu_ctrl && "❌ ALU control mismatch");
-    assert(dut->byte_mask   == test.expected.byte_mask && "❌ Byte mask mismatch");
-    assert(dut->branch_cond == test.expected.branch_cond && "❌ Branch cond mismatch");
-    assert(dut->wb_sel      == test.expected.wb_sel && "❌ WB_SEL mismatch");
-    assert(dut->reg_wen     == test.expected.reg_wen && "❌ reg_wen mismatch");
-    assert(dut->alu_pc_sel  == test.expected.alu_pc_sel && "❌ alu_pc_sel mismatch");
-    assert(dut->alu_imm_sel == test.expected.alu_imm_sel && "❌ alu_imm_sel mismatch");
-    assert(dut->mem_wen     == test.expected.mem_wen && "❌ mem_wen mismatch");
-    assert(dut->illegal_op  == test.expected.illegal_op && "❌ illegal_op mismatch");
+void check_outputs(VController* dut, const TestCase& test, tb::Check& check) {
+    check.expect_eq(dut->alu_ctrl,    test.expected.alu_ctrl,    "%s: alu_ctrl", test.description);
+    check.expect_eq(dut->byte_mask,   test.expected.byte_mask,   "%s: byte_mask", test.description);
+    check.expect_eq(dut->branch_cond, test.expected.branch_cond, "%s: branch_cond", test.description);
+    check.expect_eq(dut->wb_sel,      test.expected.wb_sel,      "%s: wb_sel", test.description);
+    check.expect_eq(dut->reg_wen,     test.expected.reg_wen,     "%s: reg_wen", test.description);
+    check.expect_eq(dut->alu_pc_sel,  test.expected.alu_pc_sel,  "%s: alu_pc_sel", test.description);
+    check.expect_eq(dut->alu_imm_sel, test.expected.alu_imm_sel, "%s: alu_imm_sel", test.description);
+    check.expect_eq(dut->mem_wen,     test.expected.mem_wen,     "%s: mem_wen", test.description);
+    check.expect_eq(dut->illegal_op,  test.expected.illegal_op,  "%s: illegal_op", test.description);
+    check.expect_eq(dut->csr_en,      test.expected.csr_en,      "%s: csr_en", test.description);
+    check.expect_eq(dut->muldiv_en,   test.expected.muldiv_en,   "%s: muldiv_en", test.description);
+    check.expect_eq(dut->sys_exit,    test.expected.sys_exit,    "%s: sys_exit", test.description);
 }
 
 // ---------- Main ----------
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VController* dut = new VController;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/Controller_waveform_new.vcd");
 
     TestCase tests[] = {
         {0x33, 0b000, 0x00, "R-Type: ADD",     {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
         {0x33, 0b000, 0x20, "R-Type: SUB",     {ALU_SUB, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
         {0x33, 0b101, 0x00, "R-Type: SRL",     {ALU_SRL, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b000, 0x01, "M: MUL",          {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0,0,1}},
+        {0x33, 0b011, 0x01, "M: MULHU",        {ALU_SLTU,BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0,0,1}},
+        {0x33, 0b100, 0x01, "M: DIV",          {ALU_XOR, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0,0,1}},
+        {0x33, 0b111, 0x01, "M: REMU",         {ALU_AND, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0,0,1}},
+        {0x13, 0b000, 0x01, "I-Type: ADDI, imm 0x20", {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}},
         {0x13, 0b000, 0x00, "I-Type: ADDI",    {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}},
         {0x13, 0b101, 0x20, "I-Type: SRAI",    {ALU_SRA, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}},
         {0x63, 0b000, 0x00, "Branch: BEQ",     {ALU_ADD, BM_WORD, BEQ_CTRL, RES_WB, 0,1,1,0,0}},
@@ -138,38 +97,67 @@ int main(int argc, char** argv, char** env) {
         {0x6F, 0b000, 0x00, "Jump: JAL",       {ALU_ADD, BM_WORD, JMP_CTRL, PC_WB,  1,1,1,0,0}},
         {0x67, 0b000, 0x00, "Jump: JALR",      {ALU_JALR,BM_WORD, JMP_CTRL, PC_WB,  1,0,1,0,0}},
         {0x37, 0b000, 0x00, "LUI",             {ALU_THRU,BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}},
-        {0x17, 0b000, 0x00, "AUIPC",           {ALU_ADD, BM_WORD, JMP_CTRL, RES_WB, 0,0,1,0,0}},
+        {0x17, 0b000, 0x00, "AUIPC",           {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 1,1,1,0,0}},
         {0x03, 0b100, 0x00, "Load: LBU",       {ALU_ADD, BM_BYTEu, NOB_CTRL, MEM_WB, 1,0,1,0,0}},
         {0x03, 0b101, 0x00, "Load: LHU",       {ALU_ADD, BM_HALFu, NOB_CTRL, MEM_WB, 1,0,1,0,0}},
-        {0x00, 0b000, 0x00, "Illegal Opcode",  {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}}
+        {0x73, 0b010, 0x00, "CSR: CSRRS",      {ALU_ADD, BM_WORD, NOB_CTRL, CSR_WB, 1,0,0,0,0,1}},
+        {0x73, 0b101, 0x00, "CSR: CSRRWI",     {ALU_ADD, BM_WORD, NOB_CTRL, CSR_WB, 1,0,0,0,0,1}},
+        {0x73, 0b000, 0x00, "System: ECALL",   {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,0,0,0,1}},
+        {0x73, 0b000, 0x18, "System: MRET",    {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1,0}},
+        {0x73, 0b000, 0x00, "System: EBREAK",  {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,0,0,0,1}, 1},
+        {0x73, 0b000, 0x00, "System: URET",    {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}, 2},
+        {0x73, 0b000, 0x00, "System: ECALL, rd x1",  {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}, 0, 0, 1},
+        {0x73, 0b000, 0x00, "System: ECALL, rs1 x1", {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}, 0, 1, 0},
+        {0x73, 0b000, 0x00, "System: rs2 31",  {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}, 31},
+        {0x0F, 0b000, 0x00, "Fence: FENCE",    {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,0,0}},
+        {0x00, 0b000, 0x00, "Illegal Opcode",  {ALU_ADD, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}},
+        // Zba/Zbb/Zbs, R-type then OP-IMM (func7 = imm[11:5], rs2 = imm[4:0])
+        {0x33, 0b010, 0x10, "Zba: SH1ADD",     {ALU_SH1ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b100, 0x10, "Zba: SH2ADD",     {ALU_SH2ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b110, 0x10, "Zba: SH3ADD",     {ALU_SH3ADD, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b111, 0x20, "Zbb: ANDN",       {ALU_ANDN, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b110, 0x20, "Zbb: ORN",        {ALU_ORN,  BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b100, 0x20, "Zbb: XNOR",       {ALU_XNOR, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b100, 0x05, "Zbb: MIN",        {ALU_MIN,  BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b101, 0x05, "Zbb: MINU",       {ALU_MINU, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b110, 0x05, "Zbb: MAX",        {ALU_MAX,  BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b111, 0x05, "Zbb: MAXU",       {ALU_MAXU, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b100, 0x04, "Zbb: ZEXT.H",     {ALU_ZEXTH, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b100, 0x04, "Zbb: ZEXT.H, rs2 1", {ALU_ZEXTH, BM_WORD, NOB_CTRL, RES_WB, 0,0,0,0,1}, 1},
+        {0x33, 0b001, 0x30, "Zbb: ROL",        {ALU_ROL,  BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b101, 0x30, "Zbb: ROR",        {ALU_ROR,  BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b001, 0x24, "Zbs: BCLR",       {ALU_BCLR, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b101, 0x24, "Zbs: BEXT",       {ALU_BEXT, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b001, 0x34, "Zbs: BINV",       {ALU_BINV, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b001, 0x14, "Zbs: BSET",       {ALU_BSET, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x33, 0b001, 0x10, "R-Type: SLL, func7 0x10", {ALU_SLL, BM_WORD, NOB_CTRL, RES_WB, 1,0,0,0,0}},
+        {0x13, 0b001, 0x30, "Zbb: CLZ",        {ALU_CLZ,  BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 0},
+        {0x13, 0b001, 0x30, "Zbb: CTZ",        {ALU_CTZ,  BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 1},
+        {0x13, 0b001, 0x30, "Zbb: CPOP",       {ALU_CPOP, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 2},
+        {0x13, 0b001, 0x30, "Zbb: SEXT.B",     {ALU_SEXTB, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 4},
+        {0x13, 0b001, 0x30, "Zbb: SEXT.H",     {ALU_SEXTH, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 5},
+        {0x13, 0b001, 0x30, "Zbb: unary, rs2 3", {ALU_SLL, BM_WORD, NOB_CTRL, RES_WB, 0,0,1,0,1}, 3},
+        {0x13, 0b101, 0x30, "Zbb: RORI",       {ALU_ROR,  BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 7},
+        {0x13, 0b101, 0x34, "Zbb: REV8",       {ALU_REV8, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 0x18},
+        {0x13, 0b101, 0x34, "Zbb: REV8, rs2 0", {ALU_REV8, BM_WORD, NOB_CTRL, RES_WB, 0,0,1,0,1}, 0},
+        {0x13, 0b101, 0x14, "Zbb: ORC.B",      {ALU_ORCB, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 0x07},
+        {0x13, 0b001, 0x24, "Zbs: BCLRI",      {ALU_BCLR, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 9},
+        {0x13, 0b101, 0x24, "Zbs: BEXTI",      {ALU_BEXT, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 9},
+        {0x13, 0b001, 0x34, "Zbs: BINVI",      {ALU_BINV, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 9},
+        {0x13, 0b001, 0x14, "Zbs: BSETI",      {ALU_BSET, BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 9},
+        {0x13, 0b001, 0x00, "I-Type: SLLI",    {ALU_SLL,  BM_WORD, NOB_CTRL, RES_WB, 1,0,1,0,0}, 9}
     };
 
-    std::cout << "\n==== Controller Output Table ====\n";
-    std::cout << std::setw(4) << "Time" << " "
-              << std::setw(22) << std::left << "Instruction"
-              << " | " << std::setw(7) << "ALU"
-              << "\tMASK"
-              << "\tBR"
-              << "\tWB"
-              << " | wen\tpcsel\timm\tmemwen\till\n"
-              << std::string(100, '-') << "\n";
-
-    for (const auto& test : tests) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        dut->opcode = test.opcode;
-        dut->func3  = test.func3;
-        dut->func7  = test.func7;
-        dut->eval();
-        m_trace->dump(sim_time++);
-
-        print_result(sim_time, test, dut);
-        check_outputs(dut, test);
-    }
-
-    std::cout << "\n✅ All controller test cases passed successfully!\n";
-
-    m_trace->close();
-    delete dut;
-    return 0;
+    return tb::run<VController>("Controller", [&](tb::Sim<VController>& sim, tb::Check& check) {
+        for (const auto& test : tests) {
+            sim->opcode = test.opcode;
+            sim->func3  = test.func3;
+            sim->func7  = test.func7;
+            sim->rs2    = test.rs2;
+            sim->rs1    = test.rs1;
+            sim->rd     = test.rd;
+            sim.eval();
+            check_outputs(sim.dut(), test, check);
+        }
+    }, 1);
 }
@@ -0,0 +1,362 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <verilated.h>
+#if VM_TRACE
+#include <verilated_vcd_c.h>
+#endif
+#include "VDCache.h"
+
+#define MAX_SIM_TIME 2000000
+vluint64_t sim_time = 0;
+
+#if VM_TRACE
+VerilatedVcdC* m_trace = nullptr;
+#endif
+
+enum LoadTypes {
+    LB  = 0b000,
+    LH  = 0b001,
+    LW  = 0b010,
+    LBU = 0b100,
+    LHU = 0b101
+};
+
+// Geometry of the verilated model. The defaults match DCache.sv; rebuild with
+// -G overrides (VFLAGS) and pass the same values as plusargs to size it.
+struct Config {
+    unsigned sets = 8, ways = 2, line_words = 4, latency = 8;
+} cfg;
+
+unsigned plusarg(const char* name, unsigned fallback) {
+    const char* arg = Verilated::commandArgsPlusMatch(name);
+    if (!arg[0]) return fallback;
+    return (unsigned)strtoul(arg + strlen(name) + 1, nullptr, 0);
+}
+
+// Backing memory seen by the cache, and the byte-level golden copy every
+// load is checked against (both 4 KiB, little-endian like DataMem)
+#define MEM_BYTES 4096
+std::vector<uint32_t> backing(MEM_BYTES / 4);
+std::vector<uint8_t>  golden(MEM_BYTES);
+
+uint32_t golden_load(uint32_t addr, LoadTypes mask) {
+    uint32_t word = golden[addr] | golden[addr + 1] << 8 | golden[addr + 2] << 16 | (uint32_t)golden[addr + 3] << 24;
+    switch (mask) {
+        case LB:  return (uint32_t)(int32_t)(int8_t)golden[addr];
+        case LBU: return golden[addr];
+        case LH:  return (uint32_t)(int32_t)(int16_t)(golden[addr] | golden[addr + 1] << 8);
+        case LHU: return golden[addr] | golden[addr + 1] << 8;
+        default:  return word;
+    }
+}
+
+void golden_store(uint32_t addr, LoadTypes mask, uint32_t wdata) {
+    unsigned bytes = (mask == LW) ? 4 : (mask == LH || mask == LHU) ? 2 : 1;
+    for (unsigned b = 0; b < bytes; b++)
+        golden[addr + b] = (uint8_t)(wdata >> (8 * b));
+}
+
+// Reference model: hit/miss/write-back decisions of an LRU write-back cache
+struct RefCache {
+    std::vector<bool>     valid, dirty;
+    std::vector<uint32_t> tags, age;
+
+    RefCache() : valid(cfg.sets * cfg.ways, false), dirty(cfg.sets * cfg.ways, false),
+                 tags(cfg.sets * cfg.ways, 0), age(cfg.sets * cfg.ways, 0) {
+        for (unsigned s = 0; s < cfg.sets; s++)
+            for (unsigned w = 0; w < cfg.ways; w++)
+                age[s * cfg.ways + w] = w;
+    }
+
+    unsigned set_of(uint32_t addr) { return (addr / (cfg.line_words * 4)) % cfg.sets; }
+    uint32_t tag_of(uint32_t addr) { return addr / (cfg.line_words * 4 * cfg.sets); }
+
+    int lookup(uint32_t addr) {
+        unsigned s = set_of(addr);
+        for (unsigned w = 0; w < cfg.ways; w++)
+            if (valid[s * cfg.ways + w] && tags[s * cfg.ways + w] == tag_of(addr))
+                return (int)w;
+        return -1;
+    }
+
+    // Allocate a line for `addr`; returns true if the victim was dirty
+    bool allocate(uint32_t addr, unsigned& way) {
+        unsigned s = set_of(addr);
+        way = 0;
+        for (unsigned w = 0; w < cfg.ways; w++)
+            if (age[s * cfg.ways + w] == cfg.ways - 1) way = w;
+        for (int w = (int)cfg.ways - 1; w >= 0; w--)
+            if (!valid[s * cfg.ways + w]) way = (unsigned)w;
+
+        unsigned i = s * cfg.ways + way;
+        bool writeback = valid[i] && dirty[i];
+        valid[i] = true;
+        dirty[i] = false;
+        tags[i]  = tag_of(addr);
+        return writeback;
+    }
+
+    void touch(uint32_t addr, unsigned hw, bool write) {
+        uint32_t* a = &age[set_of(addr) * cfg.ways];
+        for (unsigned w = 0; w < cfg.ways; w++)
+            if (a[w] < a[hw]) a[w]++;
+        a[hw] = 0;
+        if (write) dirty[set_of(addr) * cfg.ways + hw] = true;
+    }
+
+    unsigned flush() {
+        unsigned writebacks = 0;
+        for (unsigned i = 0; i < valid.size(); i++) {
+            writebacks += valid[i] && dirty[i];
+            valid[i] = dirty[i] = false;
+        }
+        return writebacks;
+    }
+};
+
+// One clock; serves the backing-memory port like a word-wide DataMem
+void tick(VDCache* dut) {
+    dut->clk = 0; dut->eval();
+    dut->mem_rdata = backing[(dut->mem_addr % MEM_BYTES) / 4];
+    dut->eval();
+#if VM_TRACE
+    m_trace->dump(sim_time);
+#endif
+    sim_time++;
+
+    bool     wen   = dut->mem_wen;
+    uint32_t addr  = dut->mem_addr;
+    uint32_t wdata = dut->mem_wdata;
+
+    dut->clk = 1; dut->eval();
+#if VM_TRACE
+    m_trace->dump(sim_time);
+#endif
+    sim_time++;
+
+    if (wen) backing[(addr % MEM_BYTES) / 4] = wdata;
+}
+
+struct Totals {
+    uint64_t accesses = 0, misses = 0, writebacks = 0, cycles = 0;
+};
+
+// One load or store: check the hit/miss decision and miss penalty against the
+// reference model and the load value against the golden memory.
+void access(VDCache* dut, RefCache& ref, uint32_t addr, LoadTypes mask,
+            bool wen, uint32_t wdata, Totals& totals) {
+    assert(sim_time < MAX_SIM_TIME && "❌ Simulation time limit reached");
+
+    dut->req = 1;
+    dut->wen = wen;
+    dut->address = addr;
+    dut->wdata = wdata;
+    dut->byte_mask = mask;
+    dut->flush = 0;
+    dut->clk = 0; dut->eval();
+
+    int way = ref.lookup(addr);
+    assert(dut->ready == (way >= 0) && "❌ Hit/miss differs from the reference model");
+
+    unsigned cycles = 1;
+    if (way < 0) {
+        unsigned w;
+        bool writeback = ref.allocate(addr, w);
+        way = (int)w;
+        totals.misses++;
+        totals.writebacks += writeback;
+
+        unsigned expected = 1 + cfg.latency + cfg.line_words + (writeback ? cfg.line_words : 0);
+        unsigned penalty = 0;
+        while (!dut->ready) {
+            tick(dut);
+            penalty++;
+            assert(penalty <= expected && "❌ Miss took too long");
+        }
+        assert(penalty == expected && "❌ Unexpected miss penalty");
+        cycles += penalty;
+    }
+
+    if (!wen)
+        assert(dut->rdata == golden_load(addr, mask) && "❌ Incorrect load value");
+    else
+        golden_store(addr, mask, wdata);
+    ref.touch(addr, (unsigned)way, wen);
+    tick(dut);
+    dut->req = 0;
+
+    totals.accesses++;
+    totals.cycles += cycles;
+}
+
+void report(const char* name, const Totals& t) {
+    printf("  %-30s %8lu %8lu %8.2f%% %10lu %10.2f\n", name,
+           (unsigned long)t.accesses, (unsigned long)t.misses,
+           100.0 * t.misses / t.accesses, (unsigned long)t.writebacks,
+           (double)t.cycles / t.accesses);
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    cfg.sets       = plusarg("sets", cfg.sets);
+    cfg.ways       = plusarg("ways", cfg.ways);
+    cfg.line_words = plusarg("line", cfg.line_words);
+    cfg.latency    = plusarg("lat", cfg.latency);
+
+    VDCache* dut = new VDCache;
+
+#if VM_TRACE
+    Verilated::traceEverOn(true);
+    m_trace = new VerilatedVcdC;
+    dut->trace(m_trace, 5);
+    m_trace->open("VCD/DCache_waveform.vcd");
+#endif
+
+    for (unsigned i = 0; i < MEM_BYTES / 4; i++) {
+        backing[i] = i * 0x01010101u ^ 0xA5000000u;
+        for (unsigned b = 0; b < 4; b++)
+            golden[i * 4 + b] = (uint8_t)(backing[i] >> (8 * b));
+    }
+
+    RefCache ref;
+    printf("🧮 DCache %u sets x %u ways x %u words (%u B), LRU, %u-cycle miss latency\n",
+           cfg.sets, cfg.ways, cfg.line_words, cfg.sets * cfg.ways * cfg.line_words * 4,
+           cfg.latency);
+
+    // Reset
+    dut->rst = 0;
+    dut->req = 0;
+    dut->flush = 0;
+    tick(dut);
+    dut->rst = 1;
+
+    // --- byte_mask / sign-extension checks (the DataMem_tb cases, through the cache) ---
+    struct TestCase {
+        uint32_t address;
+        uint32_t write_data;
+        LoadTypes byte_mask;
+        bool     write_enable;
+        uint32_t expected_rdata;    // checked on reads
+        const char* description;
+    } test_cases[] = {
+        {0x00, 0x12345678, LW,  true,  0,          "LW: Write 0x12345678 at 0x00"},
+        {0x00, 0,          LW,  false, 0x12345678, "LW: Read 0x12345678 from 0x00"},
+        {0x0C, 0x0000ABCD, LH,  true,  0,          "SH: Write 0xABCD at 0x0C"},
+        {0x0C, 0,          LH,  false, 0xFFFFABCD, "LH: Read 0xABCD from 0x0C"},
+        {0x0E, 0x00001234, LH,  true,  0,          "SH: Write 0x1234 at 0x0E"},
+        {0x0C, 0,          LW,  false, 0x1234ABCD, "LW: Both halves of 0x0C"},
+        {0x0E, 0,          LHU, false, 0x00001234, "LHU: Read 0x1234 from 0x0E"},
+        {0x1D, 0x000000C1, LB,  true,  0,          "SB: Write 0xC1 at 0x1D"},
+        {0x1D, 0,          LB,  false, 0xFFFFFFC1, "LB: Read 0xC1 from 0x1D"},
+        {0x1D, 0,          LBU, false, 0x000000C1, "LBU: Read 0xC1 from 0x1D"},
+        {0x1F, 0x0000007F, LBU, true,  0,          "SB: Write 0x7F at 0x1F"},
+        {0x1F, 0,          LB,  false, 0x0000007F, "LB: Read 0x7F from 0x1F"},
+    };
+
+    printf("    Test Description\t\t\t\t||\tAddress\t\tWData\t\tWEN\t||\tRData\n");
+    printf("----------------------------------------------------------------------------------------------------------------\n");
+
+    Totals directed, all;
+    for (auto& test : test_cases) {
+        access(dut, ref, test.address, test.byte_mask, test.write_enable, test.write_data, directed);
+        printf("[%6lu] %-40s\t||\t0x%08X\t0x%08X\t%d\t||\t0x%08X\n",
+               sim_time / 2, test.description, test.address, test.write_data,
+               test.write_enable, test.write_enable ? 0 : golden_load(test.address, test.byte_mask));
+        if (!test.write_enable)
+            assert(golden_load(test.address, test.byte_mask) == test.expected_rdata && "❌ Incorrect memory read value");
+    }
+
+    // --- Workloads ---
+    printf("\n  %-30s %8s %8s %9s %10s %10s\n", "Workload", "Accesses", "Misses", "Miss rate", "Writebacks", "Cycles/op");
+    printf("------------------------------------------------------------------------------------\n");
+
+    auto run = [&](const char* name, auto&& body) {
+        Totals t;
+        body(t);
+        report(name, t);
+        all.accesses   += t.accesses;
+        all.misses     += t.misses;
+        all.writebacks += t.writebacks;
+        all.cycles     += t.cycles;
+    };
+
+    run("memcpy 512 B (LW/SW)", [&](Totals& t) {
+        for (uint32_t i = 0; i < 512; i += 4) {
+            access(dut, ref, 0x400 + i, LW, false, 0, t);
+            access(dut, ref, 0x800 + i, LW, true, golden_load(0x400 + i, LW), t);
+        }
+    });
+
+    run("memcpy 256 B (LBU/SB)", [&](Totals& t) {
+        for (uint32_t i = 0; i < 256; i++) {
+            access(dut, ref, 0xC00 + i, LBU, false, 0, t);
+            access(dut, ref, 0xE00 + i, LB, true, golden_load(0xC00 + i, LBU), t);
+        }
+    });
+
+    uint32_t seed = 12345;
+    run("Table lookup 256 B (LBU)", [&](Totals& t) {
+        for (unsigned i = 0; i < 1024; i++) {
+            seed = seed * 1103515245u + 12345u;
+            access(dut, ref, 0x100 + (seed >> 8) % 256, LBU, false, 0, t);
+        }
+    });
+
+    run("Table lookup 2 KiB (LW)", [&](Totals& t) {
+        for (unsigned i = 0; i < 1024; i++) {
+            seed = seed * 1103515245u + 12345u;
+            access(dut, ref, ((seed >> 8) % 512) * 4, LW, false, 0, t);
+        }
+    });
+
+    run("Histogram (LW + SW)", [&](Totals& t) {
+        for (unsigned i = 0; i < 512; i++) {
+            seed = seed * 1103515245u + 12345u;
+            uint32_t bin = 0x600 + ((seed >> 8) % 64) * 4;
+            access(dut, ref, bin, LW, false, 0, t);
+            access(dut, ref, bin, LW, true, golden_load(bin, LW) + 1, t);
+        }
+    });
+
+    printf("------------------------------------------------------------------------------------\n");
+    report("Total", all);
+
+    // --- Flush: every dirty line written back, then the cache is empty ---
+    unsigned flush_writebacks = ref.flush();
+    dut->req = 0;
+    dut->flush = 1;
+    dut->clk = 0; dut->eval();
+    unsigned flush_cycles = 0;
+    while (!dut->ready) {
+        tick(dut);
+        flush_cycles++;
+        assert(flush_cycles <= cfg.sets * cfg.ways * cfg.line_words + 1 && "❌ Flush did not finish");
+    }
+    dut->flush = 0;
+    tick(dut);
+    printf("🧹 Flush: %u dirty lines written back in %u cycles\n", flush_writebacks, flush_cycles);
+
+    for (unsigned i = 0; i < MEM_BYTES; i += 4)
+        assert(backing[i / 4] == golden_load(i, LW) && "❌ Backing memory differs from golden after flush");
+
+    uint64_t writebacks = directed.writebacks + all.writebacks + flush_writebacks;
+    assert(dut->stat_hits == directed.accesses + all.accesses && "❌ Hit counter mismatch");
+    assert(dut->stat_misses == directed.misses + all.misses && "❌ Miss counter mismatch");
+    assert(dut->stat_writebacks == writebacks && "❌ Writeback counter mismatch");
+
+    // Everything misses again after the flush
+    Totals after;
+    access(dut, ref, 0x00, LW, false, 0, after);
+    assert(after.misses == 1 && "❌ Line still valid after flush");
+
+    printf("✅ All DCache test cases passed!\n");
+
+#if VM_TRACE
+    m_trace->close();
+#endif
+    delete dut;
+    return 0;
+}
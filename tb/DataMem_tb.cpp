@@ -1,12 +1,6 @@
-#include <iostream>
-#include <cassert>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VDataMem.h"
-#include <map>
-
-#define MAX_SIM_TIME 200
-vluint64_t sim_time = 0;
+#include "common/harness.h"
 
 // Enum for byte_mask values based on the load types
 enum LoadTypes {
@@ -17,28 +11,8 @@ enum LoadTypes {
     LHU = 0b101
 };
 
-// Map to associate LoadTypes enum values with string descriptions
-std::map<LoadTypes, std::string> loadTypeNames = {
-    {LW,  "LW"},
-    {LH,  "LH"},
-    {LB,  "LB"},
-    {LHU, "LHU"},
-    {LBU, "LBU"}
-};
-
-// Function to convert LoadTypes enum to string
-std::string loadTypeToString(LoadTypes type) {
-    return loadTypeNames[type];
-}
-
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VDataMem* dut = new VDataMem;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/DataMem_waveform.vcd");
 
     struct TestCase {
         uint32_t address;
@@ -80,42 +54,44 @@ int main(int argc, char** argv, char** env) {
         {0x24, 0x0000001A,  LBU, true,  0x0000001A, "LBU: Write 0x1A at 0x24"},
         {0x24, 0,           LBU, false, 0x0000001A, "LBU: Read 0x1A from 0x24"},
 
+        // --- Byte Lanes (sub-word stores into one word) ---
+        {0x28, 0x11223344,  LW, true,   0x11223344, "Lanes: Write 0x11223344 at 0x28"},
+        {0x29, 0x000000AA,  LB, true,   0xFFFFFFAA, "Lanes: Write byte 0xAA at 0x29"},
+        {0x28, 0,           LW, false,  0x1122AA44, "Lanes: Read 0x1122AA44 from 0x28"},
+        {0x2A, 0x0000BEEF,  LHU, true,  0x0000BEEF, "Lanes: Write half 0xBEEF at 0x2A"},
+        {0x28, 0,           LW, false,  0xBEEFAA44, "Lanes: Read 0xBEEFAA44 from 0x28"},
+        {0x2B, 0,           LBU, false, 0x000000BE, "Lanes: Read byte 0xBE from 0x2B"},
+
+        // --- Misaligned (crossing into the next word) ---
+        {0x30, 0x11223344,  LW, true,   0x11223344, "Misaligned: Write 0x11223344 at 0x30"},
+        {0x34, 0x55667788,  LW, true,   0x55667788, "Misaligned: Write 0x55667788 at 0x34"},
+        {0x31, 0,           LW, false,  0x88112233, "Misaligned: Read word 0x88112233 from 0x31"},
+        {0x33, 0,           LH, false,  0xFFFF8811, "Misaligned: Read half 0x8811 from 0x33"},
+        {0x33, 0,           LHU, false, 0x00008811, "Misaligned: Read half 0x8811 from 0x33 (LHU)"},
+        {0x32, 0xAABBCCDD,  LW, true,   0xAABBCCDD, "Misaligned: Write 0xAABBCCDD at 0x32"},
+        {0x30, 0,           LW, false,  0xCCDD3344, "Misaligned: Read 0xCCDD3344 from 0x30"},
+        {0x34, 0,           LW, false,  0x5566AABB, "Misaligned: Read 0x5566AABB from 0x34"},
+        {0x37, 0x0000BEEF,  LHU, true,  0x0000BEEF, "Misaligned: Write half 0xBEEF at 0x37"},
+        {0x34, 0,           LW, false,  0xEF66AABB, "Misaligned: Read 0xEF66AABB from 0x34"},
+        {0x38, 0,           LBU, false, 0x000000BE, "Misaligned: Read byte 0xBE from 0x38"},
+        {0x1FC, 0x12345678, LW, true,   0x12345678, "Last word: Write 0x12345678 at 0x1FC"},
+        {0x1FE, 0,          LW, false,  0x00001234, "Last word: Read at 0x1FE, past the end is 0"},
+        {0x1FF, 0x0000ABCD, LHU, true,  0x000000CD, "Last word: Write half at 0x1FF, high byte dropped"},
+        {0x1FC, 0,          LW, false,  0xCD345678, "Last word: Read 0xCD345678 from 0x1FC"},
+
         // --- Address Out of Bounds Test ---
         {0x200, 0,          LW, false,  0xDEADBEEF, "Out of bounds address (0x200)"},
         {0x200, 0x12345678, LW, true,   0xDEADBEEF, "Out of bounds address (0x200) with write"},
     };
 
-    printf("    Test Description\t\t\t\t||\tAddress\t\tWData\t\tMask\tWEN\t||\tRData\t\tExpected\n");
-    printf("--------------------------------------------------------------------------------------------------------------------------------------------\n");
-
-    for (auto& test : test_cases) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        dut->address = test.address;
-        dut->wdata = test.write_data;
-        dut->byte_mask = test.byte_mask;
-        dut->wen = test.write_enable;
-
-        dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
-        dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
-
-        printf("[%2lu] %-42s\t||\t0x%08X\t0x%08X\t%s\t%d\t||\t0x%08X\t0x%08X\n",
-            sim_time/2,
-            test.description,
-            test.address,
-            test.write_data,
-            loadTypeToString(test.byte_mask).c_str(),  // Display the byte mask as a string
-            test.write_enable,
-            dut->rdata,
-            test.expected_rdata
-        );
-
-        assert(dut->rdata == test.expected_rdata && "❌ Incorrect memory read value");
-    }
-
-    printf("✅ All DataMem test cases passed!\n");
-
-    m_trace->close();
-    delete dut;
-    return 0;
+    return tb::run<VDataMem>("DataMem", [&](tb::Sim<VDataMem>& sim, tb::Check& check) {
+        for (auto& test : test_cases) {
+            sim->address = test.address;
+            sim->wdata = test.write_data;
+            sim->byte_mask = test.byte_mask;
+            sim->wen = test.write_enable;
+            sim.tick();
+            check.expect_eq(sim->rdata, test.expected_rdata, "%s", test.description);
+        }
+    }, 1);
 }
@@ -0,0 +1,141 @@
+#include <verilated.h>
+#include "VDivider.h"
+#include "common/harness.h"
+
+#define RANDOM_VECTORS 400      // divisions per shard, override with +vectors+N
+
+// Divider ops (func3[1:0])
+enum DivOps {
+    DIV  = 0b00,
+    DIVU = 0b01,
+    REM  = 0b10,
+    REMU = 0b11,
+};
+
+const char* divOpNames[] = {"DIV", "DIVU", "REM", "REMU"};
+
+// HELPER FUNCTIONS
+// Results as the spec defines them, including divide-by-zero and overflow
+uint32_t calculateExpected(uint32_t src1, uint32_t src2, uint8_t op) {
+    int32_t s1 = (int32_t)src1, s2 = (int32_t)src2;
+
+    switch (op) {
+        case DIV:
+            if (src2 == 0) return 0xFFFFFFFF;
+            if (src1 == 0x80000000 && s2 == -1) return 0x80000000;
+            return (uint32_t)(s1 / s2);
+        case DIVU:
+            if (src2 == 0) return 0xFFFFFFFF;
+            return src1 / src2;
+        case REM:
+            if (src2 == 0) return src1;
+            if (src1 == 0x80000000 && s2 == -1) return 0;
+            return (uint32_t)(s1 % s2);
+        case REMU:
+            if (src2 == 0) return src1;
+            return src1 % src2;
+        default:
+            return 0;
+    }
+}
+
+// Stall cycles before `ready`: none for the early-out cases, otherwise one
+// setup cycle plus one per significant bit of |dividend|
+unsigned calculateStall(uint32_t src1, uint32_t src2, uint8_t op) {
+    bool is_signed = !(op & 1);
+    uint32_t abs1 = (is_signed && (int32_t)src1 < 0) ? 0u - src1 : src1;
+    uint32_t abs2 = (is_signed && (int32_t)src2 < 0) ? 0u - src2 : src2;
+
+    if (src2 == 0 || (is_signed && src1 == 0x80000000 && src2 == 0xFFFFFFFF) || abs1 < abs2)
+        return 0;
+
+    unsigned bits = 0;
+    while (bits < 32 && (abs1 >> bits) != 0) bits++;
+    return 1 + bits;
+}
+
+// Issue one division, wait for `ready`, check result and latency
+unsigned divide(tb::Sim<VDivider>& sim, tb::Check& check, uint32_t src1, uint32_t src2, uint8_t op) {
+    sim->req  = 1;
+    sim->op   = op;
+    sim->src1 = src1;
+    sim->src2 = src2;
+    sim->hold = 0;
+    sim->clk  = 0;
+    sim.eval();
+
+    unsigned stall = 0;
+    while (!sim->ready && stall <= 33) {
+        sim.tick();
+        stall++;
+    }
+
+    if (check.expect(sim->ready, "%-4s 0x%08X 0x%08X: never became ready", divOpNames[op], src1, src2)) {
+        check.expect_eq(sim->result, calculateExpected(src1, src2, op), "%-4s 0x%08X 0x%08X",
+                        divOpNames[op], src1, src2);
+        check.expect_eq(stall, calculateStall(src1, src2, op), "%-4s 0x%08X 0x%08X: stall cycles",
+                        divOpNames[op], src1, src2);
+    }
+
+    sim.tick();
+    return stall;
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    uint64_t vectors = tb::Options::get().vectors_or(RANDOM_VECTORS);
+
+    // Spec corner cases, then random operands
+    const uint32_t corners[][2] = {
+        {0x00000007, 0x00000000},   // divide by zero
+        {0x80000000, 0xFFFFFFFF},   // signed overflow
+        {0x80000000, 0x00000001},
+        {0xFFFFFFF9, 0x00000002},   // -7 / 2
+        {0x00000007, 0xFFFFFFFE},   // 7 / -2
+        {0xFFFFFFF9, 0xFFFFFFFE},   // -7 / -2
+        {0x00000003, 0x00000005},   // |dividend| < |divisor|
+        {0xFFFFFFFF, 0x00000001},
+    };
+
+    return tb::run<VDivider>("Divider", [&](tb::Sim<VDivider>& sim, tb::Check& check) {
+        sim->req  = 0;
+        sim->hold = 0;
+        sim.reset();
+
+        // Random divisors are shifted down so all quotient lengths come up
+        for (uint8_t op = DIV; op <= REMU; op++) {
+            if (check.shard() == 0)
+                for (auto& c : corners) divide(sim, check, c[0], c[1], op);
+            for (uint64_t i = 0; i < vectors / 4; i++)
+                divide(sim, check, check.rand32(), check.rand32() >> check.rand_below(32), op);
+        }
+        if (check.shard() != 0) return;
+
+        // A finished result is held while the core is stalled elsewhere
+        sim->req = 1; sim->op = DIVU; sim->src1 = 1000; sim->src2 = 7; sim->hold = 1;
+        sim->clk = 0; sim.eval();
+        for (int i = 0; i < 40 && !sim->ready; i++) sim.tick();
+        for (int i = 0; i < 3; i++) {
+            sim.tick();
+            check.expect(sim->ready && sim->result == 142, "hold cycle %d: result not held", i);
+        }
+        sim->hold = 0;
+        sim.tick();
+
+        // Early-out: latency follows the dividend's magnitude
+        printf("    Early-out\t\t\t\t||\tDivisions\tAvg stall cycles\n");
+        printf("-----------------------------------------------------------------------------\n");
+        const unsigned widths[] = {4, 8, 16, 32};
+        for (unsigned w : widths) {
+            uint64_t total = 0;
+            const int n = 200;
+            for (int i = 0; i < n; i++) {
+                uint32_t mask = w == 32 ? 0xFFFFFFFFu : (1u << w) - 1;
+                uint32_t src1 = check.rand32() & mask;
+                uint32_t src2 = check.rand_below(16) + 1;
+                total += divide(sim, check, src1, src2, DIVU);
+            }
+            printf("  %2u-bit dividend, 4-bit divisor\t||\t%d\t\t%.2f\n", w, n, (double)total / n);
+        }
+    });
+}
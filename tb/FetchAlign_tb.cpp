@@ -0,0 +1,163 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <verilated.h>
+#if VM_TRACE
+#include <verilated_vcd_c.h>
+#endif
+#include "VFetchAlign.h"
+
+#define MAX_SIM_TIME 20000
+vluint64_t sim_time = 0;
+
+#if VM_TRACE
+VerilatedVcdC* m_trace = nullptr;
+#endif
+
+// Little-endian byte image of the instruction stream
+std::vector<uint8_t> image(1024, 0);
+
+uint32_t mem_word(uint32_t addr) {
+    addr &= ~3u;
+    if (addr + 3 >= image.size()) return 0xDEADBEEF;
+    return image[addr] | (image[addr + 1] << 8) | (image[addr + 2] << 16) | ((uint32_t)image[addr + 3] << 24);
+}
+
+void put(uint32_t addr, uint32_t instr, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; i++)
+        image[addr + i] = (uint8_t)(instr >> (8 * i));
+}
+
+struct Instr {
+    uint32_t pc, bits;
+    unsigned bytes;
+};
+
+// Memory stalls: fetch_valid drops pseudo-randomly when enabled
+bool     mem_stalls = false;
+uint32_t seed = 1;
+
+void drive(VFetchAlign* dut) {
+    dut->fetch_word = mem_word(dut->fetch_addr);
+    if (mem_stalls) {
+        seed = seed * 1103515245u + 12345u;
+        dut->fetch_valid = ((seed >> 16) & 3) != 0;
+    } else {
+        dut->fetch_valid = 1;
+    }
+    dut->eval();
+    // fetch_addr does not depend on fetch_word/fetch_valid
+    dut->fetch_word = mem_word(dut->fetch_addr);
+    dut->eval();
+}
+
+void tick(VFetchAlign* dut) {
+    dut->clk = 0; dut->eval();
+#if VM_TRACE
+    m_trace->dump(sim_time);
+#endif
+    sim_time++;
+    dut->clk = 1; dut->eval();
+#if VM_TRACE
+    m_trace->dump(sim_time);
+#endif
+    sim_time++;
+}
+
+// Fetch one instruction: wait for `valid`, check the window and advance.
+// Returns the cycles spent.
+unsigned fetch(VFetchAlign* dut, const Instr& in) {
+    unsigned cycles = 0;
+    dut->pc = in.pc;
+    while (true) {
+        assert(sim_time < MAX_SIM_TIME && "❌ Simulation time limit reached");
+        dut->advance = 0;
+        drive(dut);
+        cycles++;
+        if (dut->valid) break;
+        assert(cycles < 64 && "❌ Window never became valid");
+        tick(dut);
+    }
+
+    uint32_t mask = in.bytes == 2 ? 0xFFFFu : 0xFFFFFFFFu;
+    if ((dut->window & mask) != in.bits) {
+        printf("❌ pc 0x%08X: window 0x%08X, expected 0x%08X\n", in.pc, dut->window, in.bits);
+        assert(false && "❌ Window mismatch");
+    }
+    dut->advance = 1;
+    tick(dut);
+    return cycles;
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    VFetchAlign* dut = new VFetchAlign;
+
+#if VM_TRACE
+    Verilated::traceEverOn(true);
+    m_trace = new VerilatedVcdC;
+    dut->trace(m_trace, 5);
+    m_trace->open("VCD/FetchAlign_waveform.vcd");
+#endif
+
+    // Mixed stream: 16-bit parcels have low bits != 11, 32-bit ones == 11
+    std::vector<Instr> prog;
+    uint32_t pc = 0;
+    unsigned straddles = 0;
+    uint32_t pattern = 0x2C7;   // length pattern, one bit per instruction
+    for (unsigned k = 0; k < 120; k++) {
+        bool wide = (pattern >> (k % 11)) & 1;
+        Instr in;
+        in.pc    = pc;
+        in.bytes = wide ? 4 : 2;
+        in.bits  = wide ? ((k << 20) | 0x00013u) : (((k << 2) & 0xFFFCu) | 0x1u);
+        if (wide && (pc & 2)) straddles++;
+        put(pc, in.bits, in.bytes);
+        prog.push_back(in);
+        pc += in.bytes;
+    }
+
+    // Reset
+    dut->rst = 0;
+    dut->pc = 0;
+    dut->advance = 0;
+    drive(dut);
+    tick(dut);
+    dut->rst = 1;
+
+    printf("    FetchAlign Test\t\t\t||\tInstrs\tStraddles\tCycles\tExpected\n");
+    printf("-------------------------------------------------------------------------------------\n");
+
+    // Sequential walk: one cycle per instruction, plus one per straddle
+    unsigned cycles = 0;
+    for (auto& in : prog)
+        cycles += fetch(dut, in);
+    printf("  %-32s\t||\t%zu\t%u\t\t%u\t%zu\n", "Sequential, ready memory",
+           prog.size(), straddles, cycles, prog.size() + straddles);
+    assert(cycles == prog.size() + straddles && "❌ Straddle should cost exactly one cycle");
+
+    // Jumps straight into halfword-aligned instructions
+    unsigned jumps = 0;
+    for (int i = (int)prog.size() - 1; i > 0; i -= 7) {
+        fetch(dut, prog[i]);
+        jumps++;
+    }
+    printf("  %-32s\t||\t%u\t-\t\t-\t-\n", "Backward jumps", jumps);
+
+    // A memory that is not always ready: same windows, more cycles
+    mem_stalls = true;
+    cycles = 0;
+    for (auto& in : prog)
+        cycles += fetch(dut, in);
+    printf("  %-32s\t||\t%zu\t%u\t\t%u\t>= %zu\n", "Sequential, stalling memory",
+           prog.size(), straddles, cycles, prog.size() + straddles);
+    assert(cycles >= prog.size() + straddles && "❌ Too few cycles with memory stalls");
+
+    printf("✅ All FetchAlign test cases passed!\n");
+
+#if VM_TRACE
+    m_trace->close();
+#endif
+    delete dut;
+    return 0;
+}
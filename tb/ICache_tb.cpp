@@ -0,0 +1,262 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <verilated.h>
+#if VM_TRACE
+#include <verilated_vcd_c.h>
+#endif
+#include "VICache.h"
+
+#define MAX_SIM_TIME 2000000
+vluint64_t sim_time = 0;
+
+#if VM_TRACE
+VerilatedVcdC* m_trace = nullptr;
+#endif
+
+// Geometry of the verilated model. The defaults match ICache.sv;
+// ICacheSweep.sh rebuilds with -G overrides and passes the same values here.
+struct Config {
+    unsigned sets = 8, ways = 2, line_words = 4, repl = 0, latency = 8;
+} cfg;
+
+const char* repl_names[] = {"LRU", "PLRU", "random"};
+
+unsigned plusarg(const char* name, unsigned fallback) {
+    const char* arg = Verilated::commandArgsPlusMatch(name);
+    if (!arg[0]) return fallback;
+    return (unsigned)strtoul(arg + strlen(name) + 1, nullptr, 0);
+}
+
+// Backing memory contents: any address-unique pattern will do
+uint32_t backing(uint32_t addr) {
+    return (addr * 2654435761u) ^ 0x00000013;
+}
+
+// Reference model with the same replacement rules as the RTL
+struct RefCache {
+    std::vector<bool>     valid;
+    std::vector<uint32_t> tags, age;
+    std::vector<uint32_t> plru;
+    unsigned way_bits = 0;
+
+    RefCache() : valid(cfg.sets * cfg.ways, false), tags(cfg.sets * cfg.ways, 0),
+                 age(cfg.sets * cfg.ways, 0), plru(cfg.sets, 0) {
+        while ((1u << way_bits) < cfg.ways) way_bits++;
+        for (unsigned s = 0; s < cfg.sets; s++)
+            for (unsigned w = 0; w < cfg.ways; w++)
+                age[s * cfg.ways + w] = w;
+    }
+
+    unsigned set_of(uint32_t addr) { return (addr / (cfg.line_words * 4)) % cfg.sets; }
+    uint32_t tag_of(uint32_t addr) { return addr / (cfg.line_words * 4 * cfg.sets); }
+
+    int lookup(uint32_t addr) {
+        unsigned s = set_of(addr);
+        for (unsigned w = 0; w < cfg.ways; w++)
+            if (valid[s * cfg.ways + w] && tags[s * cfg.ways + w] == tag_of(addr))
+                return (int)w;
+        return -1;
+    }
+
+    unsigned victim(unsigned s, uint16_t lfsr) {
+        unsigned v = 0;
+        if (cfg.repl == 1) {
+            unsigned node = 0;
+            for (unsigned l = 0; l < way_bits; l++) {
+                unsigned b = (plru[s] >> node) & 1;
+                v = (v << 1) | b;
+                node = 2 * node + 1 + b;
+            }
+        } else if (cfg.repl == 2) {
+            v = lfsr & (cfg.ways - 1);
+        } else {
+            for (unsigned w = 0; w < cfg.ways; w++)
+                if (age[s * cfg.ways + w] == cfg.ways - 1) v = w;
+        }
+        for (int w = (int)cfg.ways - 1; w >= 0; w--)
+            if (!valid[s * cfg.ways + w]) v = (unsigned)w;
+        return v;
+    }
+
+    void install(uint32_t addr, unsigned w) {
+        valid[set_of(addr) * cfg.ways + w] = true;
+        tags[set_of(addr) * cfg.ways + w]  = tag_of(addr);
+    }
+
+    void touch(unsigned s, unsigned hw) {
+        uint32_t* a = &age[s * cfg.ways];
+        for (unsigned w = 0; w < cfg.ways; w++)
+            if (a[w] < a[hw]) a[w]++;
+        a[hw] = 0;
+
+        unsigned node = 0;
+        for (unsigned l = 0; l < way_bits; l++) {
+            unsigned b = (hw >> (way_bits - 1 - l)) & 1;
+            plru[s] = (plru[s] & ~(1u << node)) | ((b ^ 1) << node);
+            node = 2 * node + 1 + b;
+        }
+    }
+};
+
+uint16_t lfsr = 0xACE1;   // mirrors ICache.lfsr
+
+void tick(VICache* dut) {
+    dut->mem_rdata = backing(dut->mem_addr);
+    dut->clk = 0; dut->eval();
+#if VM_TRACE
+    m_trace->dump(sim_time);
+#endif
+    sim_time++;
+    dut->clk = 1; dut->eval();
+#if VM_TRACE
+    m_trace->dump(sim_time);
+#endif
+    sim_time++;
+
+    if (dut->rst) {
+        unsigned bit = ((lfsr >> 15) ^ (lfsr >> 13) ^ (lfsr >> 12) ^ (lfsr >> 10)) & 1;
+        lfsr = (uint16_t)((lfsr << 1) | bit);
+    } else {
+        lfsr = 0xACE1;
+    }
+}
+
+struct Totals {
+    uint64_t accesses = 0, misses = 0, cycles = 0;
+};
+
+// Fetch one address: compare hit/miss with the reference model, wait out
+// the refill, check the data and return the cycles spent.
+unsigned fetch(VICache* dut, RefCache& ref, uint32_t addr, Totals& totals) {
+    assert(sim_time < MAX_SIM_TIME && "❌ Simulation time limit reached");
+
+    dut->req = 1;
+    dut->pc = addr;
+    dut->clk = 0; dut->eval();
+
+    unsigned set = ref.set_of(addr);
+    int way = ref.lookup(addr);
+    assert(dut->hit == (way >= 0) && "❌ Hit/miss differs from the reference model");
+
+    unsigned cycles = 1;
+    if (way < 0) {
+        way = (int)ref.victim(set, lfsr);
+        ref.install(addr, (unsigned)way);
+        totals.misses++;
+
+        unsigned penalty = 0;
+        while (!dut->hit) {
+            tick(dut);
+            penalty++;
+            assert(penalty <= 1 + cfg.latency + cfg.line_words && "❌ Refill took too long");
+        }
+        assert(penalty == 1 + cfg.latency + cfg.line_words && "❌ Unexpected miss penalty");
+        cycles += penalty;
+    }
+
+    assert(dut->instr == backing(addr) && "❌ Wrong instruction word");
+    ref.touch(set, (unsigned)way);
+    tick(dut);
+
+    totals.accesses++;
+    totals.cycles += cycles;
+    return cycles;
+}
+
+void report(const char* name, const Totals& t) {
+    printf("  %-28s %8lu %8lu %8.2f%% %10.2f\n", name,
+           (unsigned long)t.accesses, (unsigned long)t.misses,
+           100.0 * t.misses / t.accesses, (double)t.cycles / t.accesses);
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    cfg.sets       = plusarg("sets", cfg.sets);
+    cfg.ways       = plusarg("ways", cfg.ways);
+    cfg.line_words = plusarg("line", cfg.line_words);
+    cfg.repl       = plusarg("repl", cfg.repl);
+    cfg.latency    = plusarg("lat", cfg.latency);
+
+    VICache* dut = new VICache;
+
+#if VM_TRACE
+    Verilated::traceEverOn(true);
+    m_trace = new VerilatedVcdC;
+    dut->trace(m_trace, 5);
+    m_trace->open("VCD/ICache_waveform.vcd");
+#endif
+
+    RefCache ref;
+    const unsigned capacity = cfg.sets * cfg.ways * cfg.line_words;   // words
+    const uint32_t way_span = cfg.sets * cfg.line_words * 4;          // bytes per way
+
+    printf("🧮 ICache %u sets x %u ways x %u words (%u B), %s, %u-cycle miss latency\n",
+           cfg.sets, cfg.ways, cfg.line_words, capacity * 4,
+           repl_names[cfg.repl < 3 ? cfg.repl : 0], cfg.latency);
+    printf("  %-28s %8s %8s %9s %10s\n", "Trace", "Fetches", "Misses", "Miss rate", "Cycles/op");
+    printf("------------------------------------------------------------------------\n");
+
+    // Reset
+    dut->rst = 0;
+    dut->req = 0;
+    dut->pc = 0;
+    tick(dut);
+    dut->rst = 1;
+
+    Totals all;
+    auto run = [&](const char* name, auto&& addr_at, unsigned count) {
+        Totals t;
+        for (unsigned i = 0; i < count; i++)
+            fetch(dut, ref, addr_at(i), t);
+        report(name, t);
+        all.accesses += t.accesses;
+        all.misses   += t.misses;
+        all.cycles   += t.cycles;
+        return t;
+    };
+
+    // Straight-line loop of 64 words: only compulsory misses if it fits
+    Totals small = run("Loop, 64 words x8", [](unsigned i) { return 0x1000u + (i % 64) * 4; }, 64 * 8);
+    if (capacity >= 64)
+        assert(small.misses == 64 / cfg.line_words && "❌ Resident loop should only miss once per line");
+
+    // Loop 1.5x the default capacity: LRU thrashes, random keeps some lines
+    run("Loop, 96 words x8", [](unsigned i) { return 0x2000u + (i % 96) * 4; }, 96 * 8);
+
+    // Three lines competing for one set
+    run("Set conflict, 3 lines", [&](unsigned i) { return 0x4000u + (i % 3) * way_span; }, 96);
+
+    // Function calls: a hot loop calling two helpers in other sets
+    run("Call pattern", [&](unsigned i) {
+        unsigned step = i % 24;
+        if (step < 8)  return 0x5000u + step * 4;
+        if (step < 16) return 0x5000u + 3 * way_span + 0x40 + (step - 8) * 4;
+        return 0x5000u + 5 * way_span + 0x80 + (step - 16) * 4;
+    }, 24 * 16);
+
+    // Random word fetches over 1 KiB
+    uint32_t seed = 12345;
+    run("Random, 1 KiB", [&](unsigned) {
+        seed = seed * 1103515245u + 12345u;
+        return 0x8000u + ((seed >> 8) % 256) * 4;
+    }, 512);
+
+    printf("------------------------------------------------------------------------\n");
+    report("Total", all);
+
+    // Every fetch ends in exactly one hit cycle; every miss in one refill
+    assert(dut->stat_hits == all.accesses && "❌ Hit counter mismatch");
+    assert(dut->stat_misses == all.misses && "❌ Miss counter mismatch");
+    assert(dut->stat_refills == all.misses && "❌ Refill counter mismatch");
+
+    printf("✅ All ICache test cases passed!\n");
+
+#if VM_TRACE
+    m_trace->close();
+#endif
+    delete dut;
+    return 0;
+}
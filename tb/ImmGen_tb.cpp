@@ -1,23 +1,9 @@
-#include <iostream>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
-#include "VImmGen.h"  // Make sure this matches your compiled module name
-
-#define MAX_SIM_TIME 100
-vluint64_t sim_time = 0;
+#include "VImmGen.h"
+#include "common/harness.h"
 
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VImmGen* dut = new VImmGen;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/ImmGen_waveform.vcd");
-
-    // Flags
-    const bool expectedSignExtend = true;
-    const bool expectedZeroExtend = false;
 
     struct TestCase {
         uint32_t instr;
@@ -47,43 +33,21 @@ int main(int argc, char** argv, char** env) {
         {0b00000000000100100000000011100011, 0x00000800, "B-type: BEQ x1, x4, 0x800"},
         {0b01010100000100100100101011100011, 0x00000D54, "B-type: BLT x1, x4, 0xD54"},
         {0b11111110000100100001111111100011, 0xFFFFFFFE, "B-type: BGT x1, x4, -2"},
-        
+
         // J-type (JAL and JALR)
         {0b10101110101101011100010011101111, 0xFFF5CAEA, "J-type: JAL x9, 0xFFF5CAEA"},
         {0b11111110111110011000010011100111, 0xFFFFFFEF, "J-type: JALR x9, -17"},
-        
+
         // U-type (LUI and AUIPC)
         {0b11111111110010111011000100110111, 0xFFCBB000, "U-type: LUI x2, 0xFFCBB000"},
         {0b00000000010100000100000100010111, 0x00504000, "U-type: AUIPC x2, 0x504000"},
     };
 
-    printf("    Test\t\t\t||\tINSTR\t\tEXPECTED IMM\tACTUAL IMM\n");
-    printf("------------------------------------------------------------------------------------\n");
-
-
-    for (auto test : test_cases) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        dut->instr = test.instr;
-
-        dut->eval();
-        m_trace->dump(sim_time++);
-
-        printf("[%2lu] %-24s\t||\t0x%08X\t0x%08X\t0x%08X\n",
-            sim_time,
-            test.description,
-            test.instr,
-            test.expected_imm,
-            dut->immediate
-        );
-
-        // Assertions
-        assert(dut->immediate == test.expected_imm && "❌ Incorrect immediate value");
-    }
-
-    printf("✅ All ImmGen test cases passed!\n");
-
-    m_trace->close();
-    delete dut;
-    return 0;
+    return tb::run<VImmGen>("ImmGen", [&](tb::Sim<VImmGen>& sim, tb::Check& check) {
+        for (auto test : test_cases) {
+            sim->instr = test.instr;
+            sim.eval();
+            check.expect_eq(sim->immediate, test.expected_imm, "%s (0x%08X)", test.description, test.instr);
+        }
+    }, 1);
 }
@@ -0,0 +1,31 @@
+#include <verilated.h>
+#include "VMUXQuad.h"
+#include "common/harness.h"
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+
+    struct TestCase {
+        uint8_t sel;
+        uint32_t expected_out;
+        const char* description;
+    } test_cases[] = {
+        {0b00, 0xAAAAAAAA, "Select port A"},
+        {0b01, 0xBBBBBBBB, "Select port B"},
+        {0b10, 0xCCCCCCCC, "Select port C"},
+        {0b11, 0xDDDDDDDD, "Select port D"},
+        {0b00, 0xAAAAAAAA, "Back to port A"}
+    };
+
+    return tb::run<VMUXQuad>("MUXQuad", [&](tb::Sim<VMUXQuad>& sim, tb::Check& check) {
+        for (auto test : test_cases) {
+            sim->sel = test.sel;
+            sim->A = 0xAAAAAAAA;
+            sim->B = 0xBBBBBBBB;
+            sim->C = 0xCCCCCCCC;
+            sim->D = 0xDDDDDDDD;
+            sim.eval();
+            check.expect_eq(sim->OUT, test.expected_out, "%s", test.description);
+        }
+    }, 1);
+}
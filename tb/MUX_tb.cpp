@@ -1,23 +1,12 @@
-#include <stdlib.h>
-#include <iostream>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VMUX.h"
-
-#define MAX_SIM_TIME 200
-vluint64_t sim_time = 0;
+#include "common/harness.h"
 
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VMUX* dut = new VMUX;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/MUX_waveform.vcd");
 
     bool A = false;
-    bool B = true;    
+    bool B = true;
 
     struct TestCase {
         bool sel;
@@ -31,35 +20,13 @@ int main(int argc, char** argv, char** env) {
         {A, 0xABABABAB, 0xDEADBEEF, 0xABABABAB, "Select port A"}
     };
 
-    printf("    Test Case\t\t|| Select \tPort A\t\tPort B\t\t|| Output\n");
-    printf("---------------------------------------------------------------------------------------\n");
-
-    for (auto test : test_cases) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        dut->sel = test.sel;
-        dut->A = test.A;
-        dut->B = test.B;
-
-        dut->eval();
-        m_trace->dump(sim_time++);
-
-        // Print result
-        printf("[%lu] %-10s \t|| %c\t\t0x%08x\t0x%08x\t|| 0x%08x\n",
-               sim_time,
-               test.description,
-               test.sel ? 'B' : 'A',
-               test.A,
-               test.B,
-               dut->OUT);
-               
-        // Assert expected value
-        assert(dut->OUT == test.expected_out && "❌ Test case failed: Output mismatch!");
-    }
-
-    printf("✅ All test cases passed!\n");
-
-    m_trace->close();
-    delete dut;
-    return 0;
-}
\ No newline at end of file
+    return tb::run<VMUX>("MUX", [&](tb::Sim<VMUX>& sim, tb::Check& check) {
+        for (auto test : test_cases) {
+            sim->sel = test.sel;
+            sim->A = test.A;
+            sim->B = test.B;
+            sim.eval();
+            check.expect_eq(sim->OUT, test.expected_out, "%s", test.description);
+        }
+    }, 1);
+}
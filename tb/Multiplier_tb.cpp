@@ -0,0 +1,60 @@
+#include <verilated.h>
+#include "VMultiplier.h"
+#include "common/harness.h"
+
+#define RANDOM_VECTORS 2000     // per shard, override with +vectors+N
+
+// Multiplier ops (func3[1:0])
+enum MulOps {
+    MUL    = 0b00,
+    MULH   = 0b01,
+    MULHSU = 0b10,
+    MULHU  = 0b11,
+};
+
+const char* mulOpNames[] = {"MUL", "MULH", "MULHSU", "MULHU"};
+
+// HELPER FUNCTIONS
+uint32_t calculateExpected(uint32_t src1, uint32_t src2, uint8_t op) {
+    int64_t  s1 = (int32_t)src1, s2 = (int32_t)src2;
+    uint64_t u1 = src1, u2 = src2;
+
+    switch (op) {
+        case MUL:    return (uint32_t)(u1 * u2);
+        case MULH:   return (uint32_t)((uint64_t)(s1 * s2) >> 32);
+        case MULHSU: return (uint32_t)((uint64_t)(s1 * (int64_t)u2) >> 32);
+        case MULHU:  return (uint32_t)((u1 * u2) >> 32);
+        default:     return 0;
+    }
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    uint64_t vectors = tb::Options::get().vectors_or(RANDOM_VECTORS);
+
+    // Sign corners first, then random operands
+    const uint32_t corners[][2] = {
+        {0x80000000, 0x80000000},
+        {0xFFFFFFFF, 0xFFFFFFFF},
+        {0x80000000, 0xFFFFFFFF},
+        {0x7FFFFFFF, 0x80000000},
+    };
+
+    return tb::run<VMultiplier>("Multiplier", [&](tb::Sim<VMultiplier>& sim, tb::Check& check) {
+        auto test = [&](uint8_t op, uint32_t src1, uint32_t src2) {
+            sim->src1 = src1;
+            sim->src2 = src2;
+            sim->op   = op;
+            sim.eval();
+            check.expect_eq(sim->result, calculateExpected(src1, src2, op), "%-6s 0x%08X 0x%08X",
+                            mulOpNames[op], src1, src2);
+        };
+
+        for (uint8_t op = MUL; op <= MULHU; op++) {
+            if (check.shard() == 0)
+                for (auto& c : corners) test(op, c[0], c[1]);
+            for (uint64_t i = 0; i < vectors / 4; i++)
+                test(op, check.rand32(), check.rand32());
+        }
+    });
+}
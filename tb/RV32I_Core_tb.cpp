@@ -1,11 +1,60 @@
 #include <stdlib.h>
+#include <string.h>
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VRV32I_Core.h"
+#include "common/batch.h"
+#include "common/checkpoint.h"
+#include "common/clock.h"
+#include "common/commit_log.h"
+#include "common/fuzz.h"
+#include "common/program_loader.h"
+#include "common/rv32_iss.h"
+#include "common/sampling.h"
+#include "common/trace_ctl.h"
 
-#define MAX_SIM_TIME 200
+#define MAX_SIM_TIME 2000
 vluint64_t sim_time = 0;
+uint64_t cycle = 0;
+
+TraceCtl trace;
+
+// +commit_log+<path>: one binary record per retired instruction, gzip'd
+// when the path ends in .gz. ./CommitLog.sh turns it into Spike text.
+CommitLogWriter commit_log;
+
+// +checkpoint+<path> +checkpoint_at+<instret>: save the core's state once
+// instret reaches that count, then carry on. +restore+<path> starts a run
+// from it. Both need a build with checkpoint.vlt (common/checkpoint.h).
+const char* const CORE_SCOPE = "TOP.RV32I_Core";
+uint64_t checkpoint_at = UINT64_MAX;
+std::string checkpoint_path;
+
+void require_checkpoint_build() {
+    bool public_state = Checkpoint::variables(CORE_SCOPE).count(std::string(CORE_SCOPE) + ".u_pc.pc") > 0;
+    assert(public_state && "❌ Checkpoints need the core state public: VFLAGS=\"checkpoint.vlt\"");
+}
+
+void save_checkpoint(VRV32I_Core* dut) {
+    checkpoint_at = UINT64_MAX;
+    bool saved = Checkpoint::save(checkpoint_path, CORE_SCOPE, cycle);
+    assert(saved && "❌ Cannot write the +checkpoint file");
+    printf("💾 Checkpoint at instret %lu, cycle %lu, pc 0x%08X written to %s\n", (unsigned long)dut->debug_instret,
+           (unsigned long)cycle, dut->debug_pc, checkpoint_path.c_str());
+}
+
+void restore_checkpoint(VRV32I_Core* dut, const char* path) {
+    std::string error;
+    if (!Checkpoint::restore(path, CORE_SCOPE, cycle, error)) {
+        printf("❌ Cannot restore %s: %s\n", path, error.c_str());
+        assert(false && "❌ Checkpoint restore failed");
+    }
+    dut->eval();
+    printf("📂 Restored %s: instret %lu, cycle %lu, pc 0x%08X\n", path, (unsigned long)dut->debug_instret,
+           (unsigned long)cycle, dut->debug_pc);
+}
 
 // Test program expected values
 struct TestCase {
@@ -60,38 +109,904 @@ TestCase test_cases[] = {
     {0x0000006c, 0x04d00b93, 0, 0, 77, 77, 0x00000070, 0b0000, 0, 1},           // addi x23, x0, 77 (Jump target)
 };
 
-void advance_sim(VRV32I_Core* dut, VerilatedVcdC* trace) {
-    dut->clk = 0;
-    dut->eval();
-    trace->dump(sim_time);
-    sim_time++;
-    dut->clk = 1;
+void log_retire(VRV32I_Core* dut) {
+    CommitRecord r;
+    r.pc = dut->retire_pc;
+    r.instr = dut->retire_instr;
+    r.rd = dut->retire_rd;
+    r.rd_data = dut->retire_rd_wdata;
+    r.mem_bytes = __builtin_popcount(dut->retire_mem_mask);
+    r.mem_wen = dut->retire_mem_wen;
+    r.mem_addr = dut->retire_mem_addr;
+    r.mem_data = dut->retire_mem_wdata;
+    commit_log.write(r);
+}
+
+void advance_sim(VRV32I_Core* dut) {
+    if (dut->debug_instret >= checkpoint_at) save_checkpoint(dut);
+    trace.sample(cycle++, dut->debug_pc, dut->illegal_op);
+    if (dut->retire_valid && commit_log.is_open()) log_retire(dut);
+    tb::clock_cycle(dut, [] { trace.dump(sim_time++); });
+}
+
+// Hold the checks off while a cache refills (ICACHE=1 / DCACHE=1) or a
+// division runs
+void wait_stalls(VRV32I_Core* dut) {
+    while ((dut->debug_fetch_stall || dut->debug_mem_stall || dut->debug_div_stall) && sim_time < MAX_SIM_TIME)
+        advance_sim(dut);
+}
+
+// Free-running throughput run (+cycles+<N>). The test program is restarted
+// from reset each time it runs off its end, so the mix stays representative.
+void run_throughput(VRV32I_Core* dut, uint64_t cycles) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < cycles; i++) {
+        dut->rst = (dut->illegal_op || dut->sim_exit) ? 0 : 1;
+        advance_sim(dut);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("⏱️  %lu cycles in %.3f s -> %.0f cycles/sec (%s)\n",
+           (unsigned long)cycles, secs, cycles / secs,
+           VM_TRACE ? "trace on" : "trace off");
+}
+
+// Program exit (sim_exit): ECALL/EBREAK with the code in a0, or a store of
+// (code << 1) | 1 to the tohost word of a TOHOST=1 build. Clocks the exiting
+// instruction in so the counters include it, reports the exit and returns
+// the code.
+uint32_t finish_exit(VRV32I_Core* dut) {
+    uint32_t code = dut->sim_exit_code;
+    const char* cause = (dut->debug_instr & 0x7F) != 0x73 ? "tohost"
+                      : (dut->debug_instr >> 20) & 1 ? "EBREAK" : "ECALL";
+    uint32_t pc = dut->debug_pc;
+    advance_sim(dut);
+    printf("🏁 %s at 0x%08X: exit code %u after %lu cycles, %lu instructions\n", cause, pc, code,
+           (unsigned long)dut->debug_cycle, (unsigned long)dut->debug_instret);
+    return code;
+}
+
+// Whole-program run (+bench): execute the loaded image until it exits, or
+// up to the illegal instruction that ends it, and report cycles and the
+// final x12 (and the code size for an illegal-op halt). The exit code is the
+// process status. Used by RVCBench.sh to compare RV32I and RV32IC builds of
+// one program. +max_cycles+N raises the cycle limit.
+#define BENCH_MAX_CYCLES 1000000
+
+int run_bench(VRV32I_Core* dut) {
+    uint64_t max_cycles = strtoull(tb::plusarg_str("max_cycles+", "0"), nullptr, 0);
+    if (!max_cycles) max_cycles = BENCH_MAX_CYCLES;
+    uint32_t x12 = 0;
+    while (!dut->illegal_op && !dut->sim_exit) {
+        assert(cycle < max_cycles && "❌ Benchmark did not reach its halt; raise +max_cycles");
+        bool stalled = dut->debug_fetch_stall || dut->debug_mem_stall || dut->debug_div_stall;
+        if (!stalled && dut->debug_reg_wen && ((dut->debug_instr >> 7) & 0x1F) == 12)
+            x12 = dut->debug_reg_wdata;
+        advance_sim(dut);
+    }
+
+    int status = 0;
+    if (dut->sim_exit) {
+        status = (int)finish_exit(dut);
+    } else {
+        // The halt word directly follows the code
+        printf("📏 code size: %u bytes\n", dut->debug_pc);
+    }
+    printf("📊 cycles: %lu  instret: %lu  CPI: %.2f\n",
+           (unsigned long)dut->debug_cycle, (unsigned long)dut->debug_instret,
+           (double)dut->debug_cycle / dut->debug_instret);
+    if (dut->debug_ic_hits || dut->debug_ic_misses)
+        printf("🗃️  I-cache hits: %u  misses: %u  refills: %u\n",
+               dut->debug_ic_hits, dut->debug_ic_misses, dut->debug_ic_refills);
+    if (SparseMem::instance(0).pages())
+        printf("🗂️  DataMemSparse: %zu pages, %zu KiB\n",
+               SparseMem::instance(0).pages(), SparseMem::instance(0).footprint() / 1024);
+    printf("🧾 x12: %u\n", x12);
+
+    const char* expect_arg = Verilated::commandArgsPlusMatch("expect+");
+    if (expect_arg[0])
+        assert(x12 == (uint32_t)strtoul(expect_arg + strlen("+expect+"), nullptr, 0) && "❌ Wrong benchmark result");
+    printf("✅ Benchmark finished!\n");
+    return status;
+}
+
+// Interrupt latency (+irq): run a TRAPS=1 build (RV32I_Trap_TestProg.mem)
+// to its exit while raising irq_external at random, on average every
+// +irq_gap+N cycles (200; +seed+S, 1). The pin drops when the core takes
+// it, as an interrupt controller's claim would. For every interrupt the
+// latency is the cycles from its mip bit rising to the handler's first
+// instruction; the worst case and average are reported per source.
+// +expect+N and +max_cycles+N as for +bench.
+int run_irq(VRV32I_Core* dut) {
+    static const char* const sources[3] = {"software", "timer", "external"};
+    uint64_t max_cycles = strtoull(tb::plusarg_str("max_cycles+", "0"), nullptr, 0);
+    if (!max_cycles) max_cycles = BENCH_MAX_CYCLES;
+    uint64_t gap = strtoull(tb::plusarg_str("irq_gap+", "200"), nullptr, 0);
+    std::mt19937_64 rng(strtoull(tb::plusarg_str("seed+", "1"), nullptr, 0));
+    auto next_raise = [&]() { return cycle + 1 + rng() % (2 * gap); };
+
+    struct { uint64_t raised, taken, total, worst; bool high, waiting; } irq[3] = {};
+    uint64_t ext_at = next_raise();
+    uint32_t x12 = 0;
+    dut->irq_external = 0;
+
+    while (!dut->illegal_op && !dut->sim_exit) {
+        assert(cycle < max_cycles && "❌ Program did not reach its exit; raise +max_cycles");
+        if (!dut->irq_external && cycle >= ext_at) dut->irq_external = 1;
+        dut->eval();
+
+        for (unsigned s = 0; s < 3; s++) {
+            bool high = (dut->debug_mip >> s) & 1;
+            if (high && !irq[s].high) {
+                irq[s].raised = cycle;
+                irq[s].waiting = true;
+            }
+            irq[s].high = high;
+        }
+
+        // The handler's first instruction runs in the cycle after the trap
+        int taken = -1;
+        if (dut->debug_trap && (dut->debug_trap_cause >> 31)) {
+            uint32_t code = dut->debug_trap_cause & 0x1F;
+            taken = code == 3 ? 0 : code == 7 ? 1 : 2;
+        }
+
+        if (dut->retire_valid && dut->retire_rd == 12) x12 = dut->retire_rd_wdata;
+        advance_sim(dut);
+
+        if (taken >= 0 && irq[taken].waiting) {
+            uint64_t latency = cycle - irq[taken].raised;
+            irq[taken].waiting = false;
+            irq[taken].taken++;
+            irq[taken].total += latency;
+            if (latency > irq[taken].worst) irq[taken].worst = latency;
+        }
+        if (taken == 2) {
+            dut->irq_external = 0;
+            ext_at = next_raise();
+        }
+    }
+
+    bool exited = dut->sim_exit;
+    int status = 0;
+    if (exited) status = (int)finish_exit(dut);
+    else printf("🛑 Halted on an illegal instruction at pc 0x%08X\n", dut->debug_pc);
+
+    printf("⏱️  Interrupt latency, cycles from mip to the handler's first instruction:\n");
+    for (unsigned s = 0; s < 3; s++) {
+        if (!irq[s].taken) {
+            printf("\t%-8s  none taken\n", sources[s]);
+            continue;
+        }
+        printf("\t%-8s  %3lu taken  worst %3lu  average %.2f\n", sources[s], (unsigned long)irq[s].taken,
+               (unsigned long)irq[s].worst, (double)irq[s].total / irq[s].taken);
+    }
+    printf("🧾 x12: %u\n", x12);
+
+    const char* expect_arg = tb::plusarg_str("expect+", "");
+    if (expect_arg[0])
+        assert(x12 == (uint32_t)strtoul(expect_arg, nullptr, 0) && "❌ Wrong trap test result");
+    assert(exited && "❌ The trap test halted");
+    printf("✅ Trap test finished!\n");
+    return status;
+}
+
+// Lockstep co-simulation (+cosim): Rv32Iss runs the same image beside the
+// RTL, and every retired instruction's PC, register write and store are
+// compared. The first divergence stops the run. The ISS has no RV32C, and
+// is told what the core was built with:
+//   +imem+<path>  +dmem+<path>            the images (loaded into both)
+//   +imem_words+N  +dmem_words+N          IMEM_WORDS / DMEM_WORDS (128)
+//   +imem_le                              COMPRESSED=1 (little-endian image)
+//   +tohost+<addr>                        TOHOST=1 with this TOHOST_ADDR
+// or loads the same +elf/+bin/+dbin program as the core.
+Rv32Iss* make_iss() {
+    Rv32Iss* iss = new Rv32Iss(strtoul(tb::plusarg_str("imem_words+", "128"), nullptr, 0),
+                               strtoul(tb::plusarg_str("dmem_words+", "128"), nullptr, 0),
+                               Verilated::commandArgsPlusMatch("imem_le")[0] != '\0');
+    const char* imem = tb::plusarg_str("imem+", "./src/RV32I_TestProg.mem");
+    const char* dmem = tb::plusarg_str("dmem+", "");
+    bool loaded;
+    if (ProgramLoader::requested()) {
+        ProgramLoader loader;
+        loaded = loader.load_plusargs({iss->imem_data(), iss->imem_size(), iss->imem_big_endian()},
+                                      {iss->dmem_data(), iss->dmem_size(), false});
+        iss->invalidate();
+    } else {
+        loaded = iss->load_imem(imem) && (!dmem[0] || iss->load_dmem(dmem));
+    }
+    assert(loaded && "❌ Cannot read the +imem/+dmem image");
+    const char* tohost = tb::plusarg_str("tohost+", "");
+    if (tohost[0]) iss->set_tohost(strtoul(tohost, nullptr, 0));
+    return iss;
+}
+
+// +elf / +bin / +dbin replace the $readmemh images (common/program_loader.h).
+// +imem / +dmem load other src/*.mem images than IMEM_INIT / DMEM_INIT, so
+// one build runs any of them. A DMEM_SPARSE=1 core has no DataMem array;
+// its data goes to SparseMem 0. Returns whether it loaded anything.
+bool load_program() {
+    const char* imem = tb::plusarg_str("imem+", "");
+    const char* dmem = tb::plusarg_str("dmem+", "");
+    if (!ProgramLoader::requested() && !imem[0] && !dmem[0]) return false;
+
+    bool le = Verilated::commandArgsPlusMatch("imem_le")[0] != '\0';
+    bool sparse = Verilated::threadContextp()->scopeFind("TOP.RV32I_Core.g_dataMem.u_dataMem") == nullptr;
+    MemPort imem_port = verilated_mem("TOP.RV32I_Core.u_instrMem", !le);
+    MemPort dmem_port = sparse ? sparse_mem_port(0) : verilated_mem("TOP.RV32I_Core.g_dataMem.u_dataMem", false);
+
+    ProgramLoader loader;
+    bool loaded = (!imem[0] || loader.load_memh(imem, imem_port)) &&
+                  (!dmem[0] || loader.load_memh(dmem, dmem_port)) &&
+                  (!ProgramLoader::requested() || loader.load_plusargs(imem_port, dmem_port));
+    assert(loaded && "❌ Cannot load the program");
+    return loaded;
+}
+
+void report_divergence(const char* what, uint64_t n, VRV32I_Core* dut, const Rv32Iss* iss,
+                       const Rv32Iss::Commit& c, bool iss_retired) {
+    uint32_t rd = (dut->debug_instr >> 7) & 0x1F;
+    printf("❌ Divergence at instruction %lu (cycle %lu): %s\n", (unsigned long)n, (unsigned long)cycle, what);
+    printf("\t\tRTL: pc 0x%08X  instr 0x%08X", dut->debug_pc, dut->debug_instr);
+    if (dut->illegal_op) printf("  illegal");
+    if (dut->sim_exit) printf("  exit %u", dut->sim_exit_code);
+    if (dut->debug_reg_wen && rd) printf("  x%u <= 0x%08X", rd, dut->debug_reg_wdata);
+    if (dut->debug_mem_wen)
+        printf("  mem[0x%08X] <= 0x%08X (%u B)", dut->debug_alu_result, dut->debug_reg_rdata2,
+               Rv32Iss::store_bytes(dut->debug_instr >> 12));
+    printf("\n\t\tISS: pc 0x%08X  instr 0x%08X", c.pc, c.instr);
+    if (!iss_retired) printf("  illegal");
+    if (iss_retired && iss->exited()) printf("  exit %u", iss->exit_code());
+    if (c.rd) printf("  x%u <= 0x%08X", c.rd, c.rd_data);
+    if (c.mem_wen) printf("  mem[0x%08X] <= 0x%08X (%u B)", c.mem_addr, c.mem_data, c.mem_bytes);
+    printf("\n");
+    trace.fail();
+}
+
+void run_cosim(VRV32I_Core* dut) {
+    Rv32Iss* iss = make_iss();
+    Rv32Iss::Commit c;
+    uint64_t n = 0;
+    const char* what = nullptr;
+    bool retired = false;
+
+    while (!what) {
+        assert(cycle < BENCH_MAX_CYCLES && "❌ Co-simulation did not reach a halt");
+        if (dut->debug_fetch_stall || dut->debug_mem_stall || dut->debug_div_stall) {
+            advance_sim(dut);
+            continue;
+        }
+
+        retired = iss->step(c);
+        if (dut->illegal_op) {
+            // The ISS does not model CSR legality, only the RTL knows
+            if (retired && !c.csr) what = "RTL raised illegal_op, ISS retired";
+            break;
+        }
+
+        uint32_t rd = (dut->debug_instr >> 7) & 0x1F;
+        uint8_t rtl_rd = dut->debug_reg_wen ? rd : 0;
+        uint8_t bytes = Rv32Iss::store_bytes(dut->debug_instr >> 12);
+        uint32_t rtl_store = bytes < 4 ? dut->debug_reg_rdata2 & ((1u << (8 * bytes)) - 1) : dut->debug_reg_rdata2;
+
+        if (!retired)
+            what = "ISS hit an illegal instruction, RTL retired";
+        else if (c.pc != dut->debug_pc)
+            what = "PC";
+        else if (c.rd != rtl_rd || (!c.csr && rtl_rd && c.rd_data != dut->debug_reg_wdata))
+            what = "register write";
+        else if (c.mem_wen != (bool)dut->debug_mem_wen ||
+                 (c.mem_wen && (c.mem_addr != dut->debug_alu_result || c.mem_bytes != bytes || c.mem_data != rtl_store)))
+            what = "memory write";
+        else if (iss->exited() != (bool)dut->sim_exit || (dut->sim_exit && iss->exit_code() != dut->sim_exit_code))
+            what = "program exit";
+        if (what) break;
+
+        // Both sides agree the program is done
+        if (dut->sim_exit) {
+            n++;
+            finish_exit(dut);
+            break;
+        }
+
+        // Counter values come from the RTL
+        if (c.csr) iss->set_reg(c.rd, dut->debug_reg_wdata);
+        n++;
+        advance_sim(dut);
+    }
+
+    if (what) report_divergence(what, n, dut, iss, c, retired);
+    printf("🔁 %lu instructions in lockstep, %lu cycles\n", (unsigned long)n, (unsigned long)cycle);
+    delete iss;
+    assert(!what && "❌ RTL and ISS diverged");
+    printf("✅ RTL matches the ISS!\n");
+}
+
+// ISS-only throughput (+iss_mips+<N>): N instructions of the +imem image,
+// restarted from reset whenever it halts
+void run_iss_mips(uint64_t count) {
+    Rv32Iss* iss = make_iss();
+    uint64_t done = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (done < count) {
+        uint64_t ran = iss->run(count - done);
+        done += ran;
+        if (!ran) break;
+        if (iss->halted()) iss->reset();
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("⏱️  ISS: %lu instructions in %.3f s -> %.1f MIPS\n",
+           (unsigned long)done, secs, done / secs / 1e6);
+    delete iss;
+}
+
+// Simulation throughput (+kips+<cycles>, see SimBench.sh): run the loaded
+// kernel for that many cycles, restarting it from reset whenever it halts
+// or exits.
+// Every completed pass must end with the +expect x12. Reports simulated
+// instructions per host second and appends one JSON object per run to
+// +json+<path>; +kernel+ and +profile+ label it.
+void run_kips(VRV32I_Core* dut, uint64_t cycles) {
+    const char* expect_arg = tb::plusarg_str("expect+", "");
+    uint32_t expect = strtoul(expect_arg, nullptr, 0);
+    uint64_t instret = 0, passes = 0;
+    uint32_t x12 = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < cycles; i++) {
+        if (dut->illegal_op || dut->sim_exit) {
+            assert((!expect_arg[0] || x12 == expect) && "❌ Wrong kernel result");
+            // The exiting instruction retires, the halt word does not
+            instret += dut->debug_instret + (dut->sim_exit ? 1 : 0);
+            passes++;
+            tb::reset(dut, advance_sim);
+            continue;
+        }
+        bool stalled = dut->debug_fetch_stall || dut->debug_mem_stall || dut->debug_div_stall;
+        if (!stalled && dut->debug_reg_wen && ((dut->debug_instr >> 7) & 0x1F) == 12)
+            x12 = dut->debug_reg_wdata;
+        advance_sim(dut);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    instret += dut->debug_instret;
+    assert((!expect_arg[0] || passes > 0) && "❌ Kernel never halted; raise +kips");
+
+    // "idle": tracing compiled in but no dump window open (+trace+start_cycle+ past the run)
+    const char* tracing = !VM_TRACE ? "off" : trace.active() ? "on" : "idle";
+    const char* kernel = tb::plusarg_str("kernel+", "");
+    const char* profile = tb::plusarg_str("profile+", "");
+    unsigned threads = dut->contextp()->threads();
+    printf("⏱️  %s: %lu cycles, %lu instructions (%lu passes) in %.3f s -> %.1f KIPS, %.0f cycles/sec, %.1f ns/instr (trace %s, %u threads)\n",
+           kernel[0] ? kernel : "kernel", (unsigned long)cycles, (unsigned long)instret, (unsigned long)passes,
+           secs, instret / secs / 1e3, cycles / secs, secs * 1e9 / instret, tracing, threads);
+
+    const char* json = tb::plusarg_str("json+", "");
+    if (json[0]) {
+        FILE* fp = fopen(json, "a");
+        assert(fp && "❌ Cannot open the +json file");
+        fprintf(fp, "{\"kernel\": \"%s\", \"profile\": \"%s\", \"trace\": \"%s\", \"threads\": %u, "
+                    "\"cycles\": %lu, \"instret\": %lu, \"passes\": %lu, \"host_seconds\": %.6f, "
+                    "\"kips\": %.1f, \"cycles_per_sec\": %.0f, \"ns_per_instr\": %.2f}\n",
+                kernel, profile, tracing, threads, (unsigned long)cycles, (unsigned long)instret,
+                (unsigned long)passes, secs, instret / secs / 1e3, cycles / secs, secs * 1e9 / instret);
+        fclose(fp);
+    }
+    printf("✅ Benchmark finished!\n");
+}
+
+// Sampled simulation (+sample+periodic or +sample+phases, see
+// common/sampling.h): the ISS runs the program, and only the sampling
+// units run on the core. Before each unit the ISS's registers, PC and
+// DataMem are copied into the reset core (PC and RegFile are public with
+// checkpoint.vlt). The core runs +sample_warmup+W instructions to warm its
+// caches and predictor, then the unit is measured. The ISS then runs the
+// same instructions to stay in step, and the run checks that both PCs
+// still agree.
+//   +sample_period+P      period / phase interval, instructions   (10000)
+//   +sample_unit+U        periodic unit, instructions              (1000)
+//   +sample_warmup+W                                               (1000)
+//   +sample_k+K  +sample_per_cluster+M  +sample_seed+S    phases (8, 2, 1)
+//   +sample_max+N         stop the ISS after N instructions       (10^10)
+// The ISS has no RV32C and does not model CSR reads (a COMPRESSED=0 build;
+// programs that branch on rdcycle diverge). +tohost+<addr> as for +cosim.
+struct SampleCore {
+    MemPort imem, dmem;
+    uint32_t* regs = nullptr;
+    uint32_t* pc = nullptr;
+    uint32_t* imem_rword = nullptr;     // InstrMem's read register (IMEM_SYNC=1)
+    uint8_t* imem_rvalid = nullptr;
+};
+
+Rv32Iss* make_sample_iss(const SampleCore& core, const std::vector<uint8_t>& imem0,
+                         const std::vector<uint8_t>& dmem0) {
+    Rv32Iss* iss = new Rv32Iss(core.imem.size / 4, core.dmem.size / 4, false);
+    memcpy(iss->imem_data(), imem0.data(), imem0.size());
+    memcpy(iss->dmem_data(), dmem0.data(), dmem0.size());
+    iss->invalidate();
+    const char* tohost = tb::plusarg_str("tohost+", "");
+    if (tohost[0]) iss->set_tohost(strtoul(tohost, nullptr, 0));
+    return iss;
+}
+
+// Reset the core and give it the ISS's architectural state. The caches
+// and predictor start cold.
+void transfer_state(VRV32I_Core* dut, const SampleCore& core, Rv32Iss& iss) {
+    tb::reset(dut, advance_sim);
+    memcpy(core.dmem.data, iss.dmem_data(), core.dmem.size);
+    for (unsigned i = 0; i < 32; i++) core.regs[i] = iss.reg(i);
+    *core.pc = iss.pc();
+    // A synchronous InstrMem already holds the word at the new PC
+    *core.imem_rword = iss.fetch(iss.pc());
+    *core.imem_rvalid = iss.pc() < core.imem.size;
     dut->eval();
-    trace->dump(sim_time);
-    sim_time++;
+}
+
+// Run `warmup` instructions, then measure the unit's. Ends early if the
+// program does (returns true), or if the core stops retiring.
+bool measure_unit(VRV32I_Core* dut, uint64_t warmup, sampling::Unit& u) {
+    uint64_t guard = cycle + 64 * (warmup + u.length) + 1000;
+    auto stop = [&]() { return dut->illegal_op || dut->sim_exit || cycle >= guard; };
+    while (dut->debug_instret < warmup && !stop()) advance_sim(dut);
+    uint64_t c0 = dut->debug_cycle, i0 = dut->debug_instret;
+    while (dut->debug_instret < warmup + u.length && !stop()) advance_sim(dut);
+    bool ended = dut->illegal_op || dut->sim_exit;
+    if (dut->sim_exit) advance_sim(dut);    // the exiting instruction retires
+    u.cycles = dut->debug_cycle - c0;
+    u.instructions = dut->debug_instret - i0;
+    return ended;
+}
+
+int run_sampled(VRV32I_Core* dut, const char* mode) {
+    bool phases = !strcmp(mode, "phases");
+    assert((phases || !strcmp(mode, "periodic")) && "❌ +sample+periodic or +sample+phases");
+    uint64_t period = strtoull(tb::plusarg_str("sample_period+", "10000"), nullptr, 0);
+    uint64_t unit = strtoull(tb::plusarg_str("sample_unit+", "1000"), nullptr, 0);
+    uint64_t warmup = strtoull(tb::plusarg_str("sample_warmup+", "1000"), nullptr, 0);
+    unsigned k = strtoul(tb::plusarg_str("sample_k+", "8"), nullptr, 0);
+    unsigned per_cluster = strtoul(tb::plusarg_str("sample_per_cluster+", "2"), nullptr, 0);
+    uint64_t seed = strtoull(tb::plusarg_str("sample_seed+", "1"), nullptr, 0);
+    uint64_t max_instr = strtoull(tb::plusarg_str("sample_max+", "10000000000"), nullptr, 0);
+    assert(period > 0 && unit > 0 && unit <= period && "❌ Need 0 < +sample_unit <= +sample_period");
+
+    require_checkpoint_build();
+    bool sparse = Verilated::threadContextp()->scopeFind("TOP.RV32I_Core.g_dataMem.u_dataMem") == nullptr;
+    assert(!sparse && !Verilated::commandArgsPlusMatch("imem_le")[0] && "❌ Sampling needs DataMem (DMEM_SPARSE=0) and COMPRESSED=0");
+    SampleCore core;
+    core.imem = verilated_mem("TOP.RV32I_Core.u_instrMem", true);
+    core.dmem = verilated_mem("TOP.RV32I_Core.g_dataMem.u_dataMem", false);
+    auto vars = Checkpoint::variables(CORE_SCOPE);
+    core.regs = static_cast<uint32_t*>(vars.at(std::string(CORE_SCOPE) + ".u_regFile.regs")->datap());
+    core.pc = static_cast<uint32_t*>(vars.at(std::string(CORE_SCOPE) + ".u_pc.pc")->datap());
+    core.imem_rword = static_cast<uint32_t*>(vars.at(std::string(CORE_SCOPE) + ".u_instrMem.rword")->datap());
+    core.imem_rvalid = static_cast<uint8_t*>(vars.at(std::string(CORE_SCOPE) + ".u_instrMem.rvalid")->datap());
+    std::vector<uint8_t> imem0(core.imem.data, core.imem.data + core.imem.size);
+    std::vector<uint8_t> dmem0(core.dmem.data, core.dmem.data + core.dmem.size);
+
+    // Pass 1, ISS only: the program's length and, for phases, its BBVs
+    auto start = std::chrono::steady_clock::now();
+    Rv32Iss* iss = make_sample_iss(core, imem0, dmem0);
+    sampling::BbvProfiler bbv(period);
+    if (phases) {
+        Rv32Iss::Commit c;
+        uint32_t block = iss->pc();
+        uint64_t len = 0;
+        while (iss->instret() < max_instr && iss->step(c)) {
+            len++;
+            if (c.next_pc != c.pc + 4 || iss->halted()) {
+                bbv.block(block, len);
+                block = c.next_pc;
+                len = 0;
+            }
+        }
+        if (len) bbv.block(block, len);
+        bbv.finish();
+    } else {
+        while (!iss->halted() && iss->instret() < max_instr) iss->run(std::min<uint64_t>(1 << 20, max_instr - iss->instret()));
+    }
+    uint64_t total = iss->instret();
+    bool ended = iss->halted();
+    delete iss;
+    double profile_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> weights{1.0};
+    std::vector<sampling::Unit> plan = phases ? sampling::phase_plan(bbv, k, per_cluster, seed, weights)
+                                              : sampling::periodic_plan(total, period, unit);
+    printf("🔎 %lu instructions%s in the ISS (%.3f s); %zu units planned%s\n", (unsigned long)total,
+           ended ? "" : " (stopped at +sample_max)", profile_secs, plan.size(),
+           phases ? (", " + std::to_string(weights.size()) + " phases").c_str() : "");
+    assert(!plan.empty() && "❌ Nothing to sample: the program is shorter than +sample_period");
+
+    // Pass 2: fast-forward in the ISS, measure each unit on the core
+    iss = make_sample_iss(core, imem0, dmem0);
+    uint64_t detailed = 0, diverged = 0;
+    for (auto& u : plan) {
+        uint64_t from = std::max(iss->instret(), u.start > warmup ? u.start - warmup : 0);
+        if (from > u.start) continue;   // overlaps the last unit's
+        iss->run(from - iss->instret());
+        if (iss->halted()) break;
+
+        transfer_state(dut, core, *iss);
+        uint64_t warm = u.start - from;
+        bool ended = measure_unit(dut, warm, u);
+        detailed += warm + u.instructions;
+
+        iss->run(u.start + u.length - iss->instret());
+        if ((!ended && u.instructions < u.length) || (ended && !iss->halted()) ||
+            (!ended && !iss->halted() && dut->debug_pc != iss->pc()))
+            diverged++;
+    }
+    delete iss;
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    sampling::Estimate e = sampling::estimate(plan, weights, total);
+    printf("🧪 %zu units measured, %lu instructions on the RTL (%.2f%% of the program)\n", e.units,
+           (unsigned long)detailed, 100.0 * detailed / total);
+    if (e.cpi_ci95 >= 0)
+        printf("📊 estimated CPI %.4f ± %.4f, cycles %.0f ± %.0f (95%% CI, %.2f%%)\n", e.cpi, e.cpi_ci95, e.cycles,
+               e.cycles_ci95, 100.0 * e.cpi_ci95 / e.cpi);
+    else
+        printf("📊 estimated CPI %.4f, cycles %.0f (no error estimate: measure 2+ units of a phase)\n", e.cpi, e.cycles);
+    printf("⏱️  %.3f s in total\n", secs);
+    if (diverged) printf("⚠️  %lu units ended with the core and the ISS at different PCs (CSR reads?)\n", (unsigned long)diverged);
+
+    const char* json = tb::plusarg_str("json+", "");
+    if (json[0]) {
+        FILE* fp = fopen(json, "a");
+        assert(fp && "❌ Cannot open the +json file");
+        fprintf(fp, "{\"sample\": \"%s\", \"instructions\": %lu, \"units\": %zu, \"detailed\": %lu, "
+                    "\"cpi\": %.6f, \"cpi_ci95\": %.6f, \"cycles\": %.0f, \"cycles_ci95\": %.0f, "
+                    "\"diverged\": %lu, \"host_seconds\": %.6f}\n",
+                mode, (unsigned long)total, e.units, (unsigned long)detailed, e.cpi, e.cpi_ci95, e.cycles,
+                e.cycles_ci95, (unsigned long)diverged, secs);
+        fclose(fp);
+    }
+    printf("✅ Sampled simulation finished!\n");
+    return 0;
+}
+
+// Batch mode (+batch+<list>, common/batch.h): run every program of the job
+// list on a pool of models, +batch_threads+N of them (default: hardware
+// threads), and report them together; +json+<path> appends the per-job
+// results. Each line is one program and what it must end with:
+//   +imem+ +dmem+ ($readmemh), +elf+ +bin+ +dbin+ +dmem_base+   the program
+//   +exit+N      it must exit (ECALL/EBREAK/tohost) with code N (default 0)
+//   +exit+halt   it must halt on an illegal instruction instead
+//   +max_cycles+N                                                 (1000000)
+// Build with the default DataMem (not DMEM_SPARSE) and THREADS=1: the pool
+// supplies the parallelism. Traces, commit logs and checkpoints are off.
+struct BatchOptions {
+    bool imem_le = false;
+};
+
+void run_batch_job(VRV32I_Core& dut, VerilatedContext& context, const batch::Job& job, batch::Result& result,
+                   const BatchOptions& opts) {
+    auto tick = [&dut]() { tb::clock_cycle(&dut); };
+
+    // Reset (the first eval also runs the initial blocks), then replace
+    // both memories: nothing of the last job is left
+    dut.rst = 0;
+    tick();
+    if (!context.scopeFind("TOP.RV32I_Core.g_dataMem.u_dataMem")) {
+        result.status = "batch mode needs DataMem (DMEM_SPARSE=0)";
+        return;
+    }
+    MemPort imem = verilated_mem("TOP.RV32I_Core.u_instrMem", !opts.imem_le, &context);
+    MemPort dmem = verilated_mem("TOP.RV32I_Core.g_dataMem.u_dataMem", false, &context);
+    imem.clear();
+    dmem.clear();
+
+    ProgramLoader loader;
+    loader.verbose = false;
+    std::string elf = job.arg("elf+"), bin = job.arg("bin+"), dbin = job.arg("dbin+");
+    std::string imem_path = job.arg("imem+"), dmem_path = job.arg("dmem+");
+    uint32_t dmem_base = strtoul(job.arg("dmem_base+", "0").c_str(), nullptr, 0);
+    if (elf.empty() && bin.empty() && imem_path.empty()) {
+        result.status = "no program (+imem, +elf or +bin)";
+        return;
+    }
+    bool loaded = (elf.empty() || loader.load_elf(elf, imem, dmem, dmem_base)) &&
+                  (bin.empty() || loader.load_bin(bin, imem)) &&
+                  (dbin.empty() || loader.load_bin(dbin, dmem)) &&
+                  (imem_path.empty() || loader.load_memh(imem_path, imem)) &&
+                  (dmem_path.empty() || loader.load_memh(dmem_path, dmem));
+    if (!loaded) {
+        result.status = "cannot load the program";
+        return;
+    }
+
+    tick();     // a synchronous-read InstrMem reads the new first word
+    uint64_t max_cycles = strtoull(job.arg("max_cycles+", "0").c_str(), nullptr, 0);
+    if (!max_cycles) max_cycles = BENCH_MAX_CYCLES;
+    dut.rst = 1;
+    dut.eval();
+    for (uint64_t i = 0; i < max_cycles && !dut.illegal_op && !dut.sim_exit; i++) tick();
+
+    std::string expect = job.arg("exit+", "0");
+    char status[64];
+    if (dut.sim_exit) {
+        uint32_t code = dut.sim_exit_code;
+        tick();     // retire the exiting instruction, as finish_exit() does
+        snprintf(status, sizeof(status), "exit %u", code);
+        result.passed = expect != "halt" && code == strtoul(expect.c_str(), nullptr, 0);
+    } else if (dut.illegal_op) {
+        snprintf(status, sizeof(status), "halt at 0x%08X", dut.debug_pc);
+        result.passed = expect == "halt";
+    } else {
+        snprintf(status, sizeof(status), "timeout at 0x%08X", dut.debug_pc);
+    }
+    result.status = status;
+    if (!result.passed) result.status += " (expected " + (expect == "halt" ? expect : "exit " + expect) + ")";
+    result.cycles = dut.debug_cycle;
+    result.instret = dut.debug_instret;
+}
+
+int run_batch(const char* list) {
+    std::vector<batch::Job> jobs;
+    if (!batch::read_jobs(list, jobs)) {
+        printf("❌ Cannot read the +batch job list %s\n", list);
+        return 1;
+    }
+    BatchOptions opts;
+    opts.imem_le = Verilated::commandArgsPlusMatch("imem_le")[0] != '\0';
+    unsigned threads = strtoul(tb::plusarg_str("batch_threads+", "0"), nullptr, 0);
+    if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    return batch::run<VRV32I_Core>("RV32I_Core batch", jobs, threads, tb::plusarg_str("json+", ""),
+        [&opts](VRV32I_Core& dut, VerilatedContext& context, const batch::Job& job, batch::Result& result) {
+            run_batch_job(dut, context, job, result, opts);
+        });
+}
+
+// Fuzzing (+fuzz+N, common/fuzz.h): N constrained-random programs, seeds
+// +seed+S (1) to S+N-1, each run on the RTL and on Rv32Iss from the same
+// image and compared at the end: exit, instret and all of DataMem, which
+// holds the registers after the program's epilogue. Runs on a pool of
+// models like +batch (+batch_threads+N, +json+<path>; THREADS=1 builds).
+//   +fuzz_len+N        body instructions per program (200)
+//   +fuzz_mix+<spec>   class weights, e.g. alu=40,muldiv=0,zb=0 (fuzz::Mix)
+//   +fuzz_dir+<dir>    where failing programs go (fuzz)
+// A failing program is minimized against the RTL and written to
+// <dir>/<seed>.mem and <seed>_data.mem; the report has the +cosim command
+// that replays it instruction by instruction. Build with DataMem (not
+// DMEM_SPARSE), COMPRESSED=0 and TRAPS=0, and with room for the programs,
+// e.g. VFLAGS="-GIMEM_WORDS=1024 -GDMEM_WORDS=512".
+struct FuzzOptions {
+    unsigned length = 200;
+    fuzz::Mix mix;
+    std::string dir = "fuzz";
+};
+
+// Run one image on the RTL and the ISS. Returns "" if they agree, or the
+// first difference.
+std::string fuzz_run(VRV32I_Core& dut, const MemPort& imem, const MemPort& dmem, const std::vector<uint32_t>& words,
+                     const fuzz::Program& prog, batch::Result* result) {
+    auto tick = [&dut]() { tb::clock_cycle(&dut); };
+
+    assert(4 * words.size() <= imem.size && prog.data.size() <= dmem.size && "❌ Fuzz program larger than the memories");
+    Rv32Iss iss(imem.size / 4, dmem.size / 4);
+    memcpy(iss.imem_data(), words.data(), 4 * words.size());
+    memcpy(iss.dmem_data(), prog.data.data(), prog.data.size());
+    iss.invalidate();
+    iss.run(BENCH_MAX_CYCLES);
+
+    dut.rst = 0;
+    tick();
+    imem.clear();
+    dmem.clear();
+    bool loaded = imem.write(0, reinterpret_cast<const uint8_t*>(words.data()), 4 * words.size()) &&
+                  dmem.write(0, prog.data.data(), prog.data.size());
+    assert(loaded && "❌ Cannot load the fuzz program");
+    tick();
+    dut.rst = 1;
+    dut.eval();
+    // The programs have no long-latency loops: a few cycles per instruction is plenty
+    uint64_t max_cycles = 64 * iss.instret() + 1000;
+    for (uint64_t i = 0; i < max_cycles && !dut.illegal_op && !dut.sim_exit; i++) tick();
+    bool exited = dut.sim_exit;
+    uint32_t code = dut.sim_exit_code;
+    if (exited) tick();
+    if (result) {
+        result->cycles = dut.debug_cycle;
+        result->instret = dut.debug_instret;
+    }
+
+    char diff[96];
+    if (!iss.exited()) return "the ISS did not reach the ECALL";
+    if (!exited) {
+        snprintf(diff, sizeof(diff), "%s at 0x%08X", dut.illegal_op ? "halt" : "timeout", dut.debug_pc);
+        return diff;
+    }
+    if (code != iss.exit_code()) {
+        snprintf(diff, sizeof(diff), "exit code RTL %u, ISS %u", code, iss.exit_code());
+        return diff;
+    }
+    const uint8_t* rtl = dmem.data;
+    const uint8_t* ref = iss.dmem_data();
+    for (uint32_t a = 0; a + 4 <= dmem.size; a += 4) {
+        uint32_t x, y;
+        memcpy(&x, rtl + a, 4);
+        memcpy(&y, ref + a, 4);
+        if (x == y) continue;
+        if (a > prog.dump_addr && a < prog.dump_addr + 128)
+            snprintf(diff, sizeof(diff), "x%u RTL 0x%08X, ISS 0x%08X", (a - prog.dump_addr) / 4, x, y);
+        else
+            snprintf(diff, sizeof(diff), "mem[0x%X] RTL 0x%08X, ISS 0x%08X", a, x, y);
+        return diff;
+    }
+    if (dut.debug_instret != iss.instret()) {
+        snprintf(diff, sizeof(diff), "instret RTL %lu, ISS %lu", (unsigned long)dut.debug_instret,
+                 (unsigned long)iss.instret());
+        return diff;
+    }
+    return "";
+}
+
+void run_fuzz_job(VRV32I_Core& dut, VerilatedContext& context, const batch::Job& job, batch::Result& result,
+                  const FuzzOptions& opts) {
+    dut.rst = 0;
+    dut.clk = 0;
+    dut.eval();
+    if (!context.scopeFind("TOP.RV32I_Core.g_dataMem.u_dataMem")) {
+        result.status = "fuzzing needs DataMem (DMEM_SPARSE=0)";
+        return;
+    }
+    MemPort imem = verilated_mem("TOP.RV32I_Core.u_instrMem", true, &context);
+    MemPort dmem = verilated_mem("TOP.RV32I_Core.g_dataMem.u_dataMem", false, &context);
+    if (imem.size < 1024 || dmem.size < 512) {
+        result.status = "fuzzing needs IMEM_WORDS >= 256 and DMEM_WORDS >= 128";
+        return;
+    }
+
+    uint64_t seed = strtoull(job.arg("seed+").c_str(), nullptr, 0);
+    fuzz::Program prog = fuzz::generate(seed, imem.size, dmem.size, opts.length, opts.mix);
+    std::string diff = fuzz_run(dut, imem, dmem, prog.encode(prog.all()), prog, &result);
+    if (diff.empty()) {
+        result.passed = true;
+        result.status = "ok";
+        return;
+    }
+
+    std::vector<bool> keep = fuzz::minimize(prog, [&](const std::vector<bool>& k) {
+        return !fuzz_run(dut, imem, dmem, prog.encode(k), prog, nullptr).empty();
+    });
+    std::string base = opts.dir + "/" + std::to_string(seed);
+    mkdir(opts.dir.c_str(), 0755);
+    if (!prog.write_mem(base + ".mem", base + "_data.mem", keep)) {
+        result.status = diff + " (cannot write " + base + ".mem)";
+        return;
+    }
+    result.status = diff + "; " + std::to_string(prog.body_words(keep)) + " of " +
+                    std::to_string(prog.body_words(prog.all())) + " body instructions kept, replay with +cosim +imem+" +
+                    base + ".mem +dmem+" + base + "_data.mem +imem_words+" + std::to_string(imem.size / 4) +
+                    " +dmem_words+" + std::to_string(dmem.size / 4);
+}
+
+int run_fuzz(uint64_t count) {
+    FuzzOptions opts;
+    opts.length = strtoul(tb::plusarg_str("fuzz_len+", "200"), nullptr, 0);
+    opts.dir = tb::plusarg_str("fuzz_dir+", "fuzz");
+    const char* mix = tb::plusarg_str("fuzz_mix+", "");
+    if (mix[0] && !opts.mix.parse(mix)) {
+        printf("❌ Bad +fuzz_mix+%s (classes: alu muldiv zb load store branch jump loop)\n", mix);
+        return 1;
+    }
+    uint64_t seed = strtoull(tb::plusarg_str("seed+", "1"), nullptr, 0);
+    std::vector<batch::Job> jobs(count);
+    for (uint64_t i = 0; i < count; i++) jobs[i].args.push_back("+seed+" + std::to_string(seed + i));
+    unsigned threads = strtoul(tb::plusarg_str("batch_threads+", "0"), nullptr, 0);
+    if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    return batch::run<VRV32I_Core>("RV32I_Core fuzz", jobs, threads, tb::plusarg_str("json+", ""),
+        [&opts](VRV32I_Core& dut, VerilatedContext& context, const batch::Job& job, batch::Result& result) {
+            run_fuzz_job(dut, context, job, result, opts);
+        });
+}
+
+void close_logs() {
+    trace.close();
+    if (commit_log.is_open()) {
+        commit_log.close();
+        printf("🧾 commit log: %lu instructions, %.1f MB before compression\n",
+               (unsigned long)commit_log.records(), commit_log.bytes() / 1e6);
+    }
 }
 
 int main(int argc, char** argv, char** env) {
+    // +fork+<file>: this process only waits for one child per line
+    int fork_status = 0;
+    if (fork_runs(argc, argv, fork_status)) return fork_status;
+
     Verilated::commandArgs(argc, argv);
+    const char* batch_list = tb::plusarg_str("batch+", "");
+    if (batch_list[0]) return run_batch(batch_list);
+    const char* fuzz_count = tb::plusarg_str("fuzz+", "");
+    if (fuzz_count[0]) return run_fuzz(strtoull(fuzz_count, nullptr, 0));
+
     VRV32I_Core* dut = new VRV32I_Core;
 
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/RV32I_Core_waveform.vcd");
+    std::string trace_base = "VCD/RV32I_Core_waveform";
+    if (fork_index() >= 0) trace_base += "_fork" + std::to_string(fork_index());
+    trace.open(dut, "RV32I_Core", trace_base);
+    const char* log_path = tb::plusarg_str("commit_log+", "");
+    if (log_path[0]) {
+        bool opened = commit_log.open(log_path);
+        assert(opened && "❌ Cannot open the +commit_log file");
+    }
 
     // Initialize
     dut->clk = 0;
     dut->rst = 0;
-    advance_sim(dut, m_trace);
+    advance_sim(dut);
+    // A synchronous-read InstrMem (IMEM_SYNC=1) read its first word at the
+    // reset edge: one more reset cycle fetches it from the loaded program
+    if (load_program()) advance_sim(dut);
+
+    const char* restore_path = tb::plusarg_str("restore+", "");
+    const char* save_path = tb::plusarg_str("checkpoint+", "");
+    if (restore_path[0] || save_path[0]) require_checkpoint_build();
+    if (restore_path[0]) {
+        assert(!Verilated::commandArgsPlusMatch("cosim")[0] && "❌ +cosim starts the ISS from reset; it cannot +restore");
+        restore_checkpoint(dut, restore_path);
+    }
+    if (save_path[0]) {
+        checkpoint_path = save_path;
+        checkpoint_at = strtoull(tb::plusarg_str("checkpoint_at+", "0"), nullptr, 0);
+    }
     dut->rst = 1;
-    // advance_sim(dut, m_trace);
+    // advance_sim(dut);
+
+    if (Verilated::commandArgsPlusMatch("bench")[0]) {
+        int status = run_bench(dut);
+        close_logs();
+        delete dut;
+        return status;
+    }
+
+    if (Verilated::commandArgsPlusMatch("irq")[0]) {
+        int status = run_irq(dut);
+        close_logs();
+        delete dut;
+        return status;
+    }
+
+    const char* sample_mode = tb::plusarg_str("sample+", "");
+    if (sample_mode[0]) {
+        int status = run_sampled(dut, sample_mode);
+        close_logs();
+        delete dut;
+        return status;
+    }
+
+    const char* kips_arg = Verilated::commandArgsPlusMatch("kips+");
+    if (kips_arg[0]) {
+        run_kips(dut, strtoull(kips_arg + strlen("+kips+"), nullptr, 0));
+        close_logs();
+        delete dut;
+        return 0;
+    }
+
+    if (Verilated::commandArgsPlusMatch("cosim")[0]) {
+        run_cosim(dut);
+        close_logs();
+        delete dut;
+        return 0;
+    }
+
+    const char* iss_arg = Verilated::commandArgsPlusMatch("iss_mips+");
+    if (iss_arg[0]) {
+        run_iss_mips(strtoull(iss_arg + strlen("+iss_mips+"), nullptr, 0));
+        close_logs();
+        delete dut;
+        return 0;
+    }
 
     int test_case_idx = 0;
     int max_test_cases = sizeof(test_cases)/sizeof(TestCase);
     
     while (sim_time < MAX_SIM_TIME && test_case_idx < max_test_cases) {
         TestCase expected = test_cases[test_case_idx];
+        wait_stalls(dut);
         
         // Print actual values
         printf("[PC: 0x%08X]\n", dut->debug_pc);
@@ -116,13 +1031,64 @@ int main(int argc, char** argv, char** env) {
         assert(dut->debug_reg_wen == expected.reg_wen && "Register write enable mismatch");
         
         printf("✅ Test case %d passed\n\n", test_case_idx);
-        advance_sim(dut, m_trace);
+        advance_sim(dut);
         test_case_idx++;
     }
 
+    // Performance counters read back by the program itself (CSRRS)
+    struct CsrCase {
+        uint32_t pc;
+        uint32_t instr;
+        uint32_t wdata;
+        const char* description;
+    } csr_cases[] = {
+        {0x00000070, 0xc0002c73, 26, "rdcycle x24"},
+        {0x00000074, 0xc0202cf3, 27, "rdinstret x25"},
+        {0x00000078, 0xc0302d73, 1,  "csrr x26, hpmcounter3 (taken branches)"},
+        {0x0000007c, 0xc0402df3, 3,  "csrr x27, hpmcounter4 (loads)"},
+    };
+
+    for (auto& test : csr_cases) {
+        wait_stalls(dut);
+        printf("[PC: 0x%08X] %s\n", dut->debug_pc, test.description);
+        printf("\t\treg_wdata: %u (expected: %u)\n", dut->debug_reg_wdata, test.wdata);
+
+        assert(dut->debug_pc == test.pc && "PC mismatch");
+        assert(dut->debug_instr == test.instr && "Instruction mismatch");
+        assert(dut->debug_reg_wen && !dut->illegal_op && "CSR read not written back");
+        // rdcycle includes refill stalls when a cache is enabled
+        if (test.instr != 0xc0002c73 || (dut->debug_ic_misses == 0 && dut->debug_dc_misses == 0))
+            assert(dut->debug_reg_wdata == test.wdata && "CSR value mismatch");
+        advance_sim(dut);
+    }
+
+    printf("📊 cycles: %lu  instret: %lu  CPI: %.2f\n",
+           (unsigned long)dut->debug_cycle, (unsigned long)dut->debug_instret,
+           (double)dut->debug_cycle / dut->debug_instret);
+
+    // Only populated when the core is built with BPRED=1
+    if (dut->debug_bp_branches || dut->debug_bp_jumps)
+        printf("🔮 branches: %u (%u mispredicted)  jumps: %u (%u mispredicted)\n",
+               dut->debug_bp_branches, dut->debug_bp_branch_miss,
+               dut->debug_bp_jumps, dut->debug_bp_jump_miss);
+
+    // Only populated when the core is built with ICACHE=1
+    if (dut->debug_ic_hits || dut->debug_ic_misses)
+        printf("🗃️  I-cache hits: %u  misses: %u  refills: %u\n",
+               dut->debug_ic_hits, dut->debug_ic_misses, dut->debug_ic_refills);
+
+    // Only populated when the core is built with DCACHE=1
+    if (dut->debug_dc_hits || dut->debug_dc_misses)
+        printf("🗃️  D-cache hits: %u  misses: %u  writebacks: %u\n",
+               dut->debug_dc_hits, dut->debug_dc_misses, dut->debug_dc_writebacks);
+
     printf("✅ All test cases passed!\n");
 
-    m_trace->close();
+    const char* cycles_arg = Verilated::commandArgsPlusMatch("cycles+");
+    if (cycles_arg[0])
+        run_throughput(dut, strtoull(cycles_arg + strlen("+cycles+"), nullptr, 0));
+
+    close_logs();
     delete dut;
     return 0;
 }
\ No newline at end of file
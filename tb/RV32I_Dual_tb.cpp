@@ -0,0 +1,188 @@
+#include <stdlib.h>
+#include <string.h>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <verilated.h>
+#include "VRV32I_Dual.h"
+#include "common/clock.h"
+#include "common/program_loader.h"
+#include "common/rv32_iss.h"
+#include "common/trace_ctl.h"
+
+// Runs a program on RV32I_Dual in lockstep with the ISS: every instruction
+// either lane retires must match the ISS's next one (PC, register write,
+// store). At the end it prints the IPC and why bundles did not pair.
+//   +imem+<path> +dmem+<path>   another program than IMEM_INIT / DMEM_INIT
+//                               (the default is src/RV32I_TestProg.mem)
+//   +imem_words+N +dmem_words+N IMEM_WORDS / DMEM_WORDS, for the ISS (128)
+//   +expect+N                   x12 must hold N at the end (SimBench kernels)
+//   +max_cycles+N               give up after N cycles (default 10000000)
+//   +json+<path>                append the results as one JSON line
+//   +kernel+<name> +profile+<name>   labels for the JSON line
+// The program ends with ECALL/EBREAK or on an illegal instruction.
+// ./DualBench.sh compares the issue modes on the SimBench kernels.
+vluint64_t sim_time = 0;
+uint64_t cycle = 0;
+
+TraceCtl trace;
+
+void advance_sim(VRV32I_Dual* dut) {
+    trace.sample(cycle++, dut->debug_pc, dut->illegal_op);
+    tb::clock_cycle(dut, [] { trace.dump(sim_time++); });
+}
+
+// One lane's retirement, as the ISS's Commit
+struct Retired {
+    uint32_t pc, instr, rd, rd_wdata;
+    bool mem_wen;
+    uint32_t mem_addr, mem_wdata;
+};
+
+Retired lane0(const VRV32I_Dual* dut) {
+    return {dut->retire0_pc, dut->retire0_instr, dut->retire0_rd, dut->retire0_rd_wdata,
+            dut->retire0_mem_wen != 0, dut->retire0_mem_addr, dut->retire0_mem_wdata};
+}
+
+Retired lane1(const VRV32I_Dual* dut) {
+    return {dut->retire1_pc, dut->retire1_instr, dut->retire1_rd, dut->retire1_rd_wdata,
+            dut->retire1_mem_wen != 0, dut->retire1_mem_addr, dut->retire1_mem_wdata};
+}
+
+// Step the ISS over the instruction `r` retired on `lane`; nullptr if they
+// agree, else what differs
+const char* compare(unsigned lane, const Retired& r, Rv32Iss& iss, uint64_t n) {
+    Rv32Iss::Commit c;
+    const char* what = nullptr;
+    if (!iss.step(c)) what = "the ISS does not retire this instruction";
+    else if (r.pc != c.pc) what = "PC";
+    else if (r.instr != c.instr) what = "instruction";
+    else if (r.rd != c.rd || (!c.csr && c.rd && r.rd_wdata != c.rd_data)) what = "register write";
+    if (!what && (r.mem_wen != c.mem_wen || (c.mem_wen && (r.mem_addr != c.mem_addr || r.mem_wdata != c.mem_data))))
+        what = "store";
+    if (what) {
+        printf("❌ Divergence at instruction %lu (cycle %lu, lane %u): %s\n", (unsigned long)n,
+               (unsigned long)cycle, lane, what);
+        printf("\t\tRTL: pc 0x%08X  instr 0x%08X", r.pc, r.instr);
+        if (r.rd) printf("  x%u <= 0x%08X", r.rd, r.rd_wdata);
+        if (r.mem_wen) printf("  mem[0x%08X] <= 0x%08X", r.mem_addr, r.mem_wdata);
+        printf("\n\t\tISS: pc 0x%08X  instr 0x%08X", c.pc, c.instr);
+        if (c.rd) printf("  x%u <= 0x%08X", c.rd, c.rd_data);
+        if (c.mem_wen) printf("  mem[0x%08X] <= 0x%08X", c.mem_addr, c.mem_data);
+        printf("\n");
+        trace.fail();
+    }
+    // Counter values come from the RTL
+    if (!what && c.csr) iss.set_reg(c.rd, r.rd_wdata);
+    return what;
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    VRV32I_Dual* dut = new VRV32I_Dual;
+
+    trace.open(dut, "RV32I_Dual", "VCD/RV32I_Dual_waveform");
+
+    const char* imem = tb::plusarg_str("imem+", "");
+    const char* dmem = tb::plusarg_str("dmem+", "");
+    const char* expect = tb::plusarg_str("expect+", "");
+    uint64_t max_cycles = strtoull(tb::plusarg_str("max_cycles+", "10000000"), nullptr, 0);
+
+    Rv32Iss iss(strtoul(tb::plusarg_str("imem_words+", "128"), nullptr, 0),
+                strtoul(tb::plusarg_str("dmem_words+", "128"), nullptr, 0));
+    bool iss_loaded = iss.load_imem(imem[0] ? imem : "./src/RV32I_TestProg.mem") && (!dmem[0] || iss.load_dmem(dmem));
+    assert(iss_loaded && "❌ Cannot read the +imem/+dmem image");
+
+    // Initialize (the first eval runs the initial blocks), then load
+    dut->clk = 0;
+    dut->rst = 0;
+    advance_sim(dut);
+    if (imem[0] || dmem[0]) {
+        ProgramLoader loader;
+        bool loaded = (!imem[0] || loader.load_memh(imem, verilated_mem("TOP.RV32I_Dual.u_instrMem", true))) &&
+                      (!dmem[0] || loader.load_memh(dmem, verilated_mem("TOP.RV32I_Dual.u_dataMem", false)));
+        assert(loaded && "❌ Cannot load the program");
+    }
+    dut->rst = 1;
+    dut->eval();
+
+    uint64_t n = 0, paired = 0, split[4] = {}, div_cycles = 0;
+    uint32_t x12 = 0;
+    const char* what = nullptr;
+    bool exited = false;
+
+    auto start = std::chrono::steady_clock::now();
+    while (!what && !dut->illegal_op && cycle < max_cycles) {
+        if (dut->retire0_valid) {
+            Retired r0 = lane0(dut);
+            what = compare(0, r0, iss, n++);
+            if (r0.rd == 12) x12 = r0.rd_wdata;
+            if (!what && (iss.exited() != (bool)dut->sim_exit ||
+                          (dut->sim_exit && iss.exit_code() != dut->sim_exit_code))) {
+                printf("❌ Divergence at instruction %lu: program exit\n", (unsigned long)n);
+                what = "program exit";
+            }
+            if (!what && dut->retire1_valid) {
+                Retired r1 = lane1(dut);
+                what = compare(1, r1, iss, n++);
+                if (r1.rd == 12) x12 = r1.rd_wdata;
+                paired++;
+            }
+            split[dut->debug_split]++;
+        } else if (dut->debug_div_stall) {
+            div_cycles++;
+        }
+        if (dut->sim_exit) {
+            printf("🏁 ECALL at pc 0x%08X, exit code %u\n", dut->debug_pc, dut->sim_exit_code);
+            exited = true;
+            advance_sim(dut);   // the exiting instruction retires
+            break;
+        }
+        if (!what) advance_sim(dut);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    assert(!what && "❌ RTL and ISS diverged");
+    if (!exited && dut->illegal_op) {
+        // The ISS does not model CSR legality, only the RTL knows
+        Rv32Iss::Commit c;
+        bool iss_halts = iss.step(c) ? c.csr && c.pc == dut->debug_pc : iss.pc() == dut->debug_pc;
+        if (!iss_halts) printf("❌ RTL halted at pc 0x%08X, the ISS at 0x%08X\n", dut->debug_pc, iss.pc());
+        assert(iss_halts && "❌ RTL and ISS halt at different PCs");
+        printf("🛑 Halted on an illegal instruction at pc 0x%08X\n", dut->debug_pc);
+    }
+    assert((exited || dut->illegal_op) && "❌ The program did not end (+max_cycles+N?)");
+    if (expect[0]) {
+        uint32_t want = strtoul(expect, nullptr, 0);
+        if (x12 != want) printf("❌ x12 = %u, expected %u\n", x12, want);
+        assert(x12 == want && "❌ Wrong kernel result");
+    }
+
+    uint64_t cycles = dut->debug_cycle, instret = dut->debug_instret;
+    uint64_t bundles = split[0] + split[1] + split[2] + split[3];
+    double ipc = cycles ? (double)instret / cycles : 0;
+    printf("✅ %lu instructions match the ISS\n", (unsigned long)n);
+    printf("📊 %lu cycles, %lu instructions, IPC %.3f\n", (unsigned long)cycles, (unsigned long)instret, ipc);
+    printf("📊 %lu bundles: %lu paired (%.1f%%), alone after a redirect %lu, structural %lu, dependency %lu; "
+           "%lu divider cycles\n",
+           (unsigned long)bundles, (unsigned long)paired, bundles ? 100.0 * paired / bundles : 0.0,
+           (unsigned long)split[1], (unsigned long)split[2], (unsigned long)split[3], (unsigned long)div_cycles);
+    printf("⏱️  %.0f cycles/sec\n", cycle / (secs > 0 ? secs : 1e-9));
+
+    const char* json = tb::plusarg_str("json+", "");
+    if (json[0]) {
+        FILE* fp = fopen(json, "a");
+        assert(fp && "❌ Cannot open the +json file");
+        fprintf(fp, "{\"kernel\": \"%s\", \"profile\": \"%s\", \"cycles\": %lu, \"instret\": %lu, \"ipc\": %.4f, "
+                    "\"paired\": %lu, \"split_redirect\": %lu, \"split_struct\": %lu, \"split_dep\": %lu}\n",
+                tb::plusarg_str("kernel+", ""), tb::plusarg_str("profile+", ""), (unsigned long)cycles,
+                (unsigned long)instret, ipc, (unsigned long)paired, (unsigned long)split[1],
+                (unsigned long)split[2], (unsigned long)split[3]);
+        fclose(fp);
+    }
+
+    trace.close();
+    dut->final();
+    delete dut;
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include <iostream>
+#include <verilated.h>
+#include "VRV32I_Pipe.h"
+#include "common/clock.h"
+#include "common/trace_ctl.h"
+
+#define MAX_SIM_TIME 4000
+vluint64_t sim_time = 0;
+uint64_t cycle = 0;
+
+TraceCtl trace;
+
+// Expected retirement order of RV32I_TestProg.mem.
+// Counter reads depend on pipeline timing, so their value is not checked.
+struct RetireCase {
+    uint32_t pc;
+    bool reg_wen;
+    uint8_t rd;
+    uint32_t wdata;
+    bool check_wdata;
+    const char* description;
+};
+
+RetireCase retire_cases[] = {
+    {0x00, 1,  1, 5,          1, "addi x1, x0, 5"},
+    {0x04, 1,  2, 3,          1, "addi x2, x0, 3"},
+    {0x08, 1,  3, 0x100,      1, "addi x3, x0, 0x100"},
+    {0x0c, 1,  4, 8,          1, "add x4, x1, x2"},
+    {0x10, 1,  5, 2,          1, "sub x5, x1, x2"},
+    {0x14, 1,  6, 1,          1, "and x6, x1, x2"},
+    {0x18, 1,  7, 7,          1, "or x7, x1, x2"},
+    {0x1c, 1,  8, 6,          1, "xor x8, x1, x2"},
+    {0x20, 1,  9, 40,         1, "sll x9, x1, x2"},
+    {0x24, 1, 10, 0x20,       1, "srl x10, x3, x2"},
+    {0x28, 1, 11, 0,          1, "sra x11, x1, x2"},
+    {0x2c, 1, 12, 0,          1, "slt x12, x1, x2"},
+    {0x30, 1, 13, 0,          1, "sltu x13, x1, x2"},
+    {0x34, 1, 14, 0xfffffffc, 1, "addi x14, x0, -4"},
+    {0x38, 1, 15, 1,          1, "slti x15, x1, 6"},
+    {0x3c, 1, 16, 1,          1, "sltiu x16, x1, 6"},
+    {0x40, 0,  0, 0,          0, "sw x1, 0(x3)"},
+    {0x44, 1, 17, 5,          1, "lw x17, 0(x3)"},
+    {0x48, 0,  0, 0,          0, "sh x1, 4(x3)"},
+    {0x4c, 1, 18, 5,          1, "lh x18, 4(x3)"},
+    {0x50, 0,  0, 0,          0, "sb x1, 8(x3)"},
+    {0x54, 1, 19, 5,          1, "lb x19, 8(x3)"},
+    {0x58, 0,  0, 0,          0, "beq x1, x17, +8 (taken)"},
+    {0x60, 1, 21, 10,         1, "addi x21, x0, 10"},
+    {0x64, 1, 21, 0x68,       1, "jal x21, +8"},
+    {0x6c, 1, 23, 77,         1, "addi x23, x0, 77"},
+    {0x70, 1, 24, 0,          0, "rdcycle x24"},
+    {0x74, 1, 25, 0,          0, "rdinstret x25"},
+    {0x78, 1, 26, 1,          1, "csrr x26, hpmcounter3 (taken branches)"},
+    {0x7c, 1, 27, 3,          1, "csrr x27, hpmcounter4 (loads)"},
+    {0x80, 1, 28, 7,          1, "addi x28, x0, 7"},
+    {0x84, 1, 29, 8,          1, "addi x29, x28, 1 (EX/MEM fwd)"},
+    {0x88, 1, 30, 15,         1, "add x30, x28, x29 (MEM/WB + EX/MEM fwd)"},
+    {0x8c, 0,  0, 0,          0, "sw x30, 0x10(x0) (store data fwd)"},
+    {0x90, 1, 31, 15,         1, "lw x31, 0x10(x0)"},
+    {0x94, 1, 31, 16,         1, "addi x31, x31, 1 (load-use stall)"},
+    {0x98, 0,  0, 0,          0, "beq x31, x31, +8 (taken, flush)"},
+    {0xa0, 1, 22, 0xa4,       1, "jal x22, +8 (flush)"},
+    {0xa8, 1, 20, 0xa4,       1, "addi x20, x22, 0 (link fwd)"},
+};
+
+void advance_sim(VRV32I_Pipe* dut) {
+    trace.sample(cycle++, dut->debug_pc, dut->illegal_op);
+    tb::clock_cycle(dut, [] { trace.dump(sim_time++); });
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    VRV32I_Pipe* dut = new VRV32I_Pipe;
+
+    trace.open(dut, "RV32I_Pipe", "VCD/RV32I_Pipe_waveform");
+
+    // Initialize
+    tb::reset(dut, advance_sim);
+
+    size_t retire_idx = 0;
+    size_t max_retire = sizeof(retire_cases) / sizeof(RetireCase);
+    uint64_t stalls = 0, flushes = 0, fetch_stalls = 0, mem_stalls = 0;
+
+    // Run until the program falls off its end into an illegal instruction
+    while (sim_time < MAX_SIM_TIME && !dut->illegal_op) {
+        if (dut->debug_retire && retire_idx < max_retire) {
+            RetireCase expected = retire_cases[retire_idx];
+
+            printf("[PC: 0x%08X] %-42s wen: %d  x%-2d <- 0x%08X\n",
+                   dut->debug_pc, expected.description,
+                   dut->debug_reg_wen, dut->debug_reg_wdest, dut->debug_reg_wdata);
+
+            assert(dut->debug_pc == expected.pc && "Retire order mismatch");
+            assert(dut->debug_reg_wen == expected.reg_wen && "Register write enable mismatch");
+            if (expected.reg_wen)
+                assert(dut->debug_reg_wdest == expected.rd && "Destination register mismatch");
+            if (expected.check_wdata)
+                assert(dut->debug_reg_wdata == expected.wdata && "Write-back value mismatch");
+            retire_idx++;
+        }
+
+        stalls += dut->debug_stall;
+        flushes += dut->debug_flush;
+        fetch_stalls += dut->debug_fetch_stall;
+        mem_stalls += dut->debug_mem_stall;
+        advance_sim(dut);
+    }
+
+    assert(retire_idx == max_retire && "Program did not retire every checked instruction");
+    printf("✅ All %zu retirements matched\n", max_retire);
+
+    printf("📊 cycles: %lu  instret: %lu  CPI: %.2f  load-use stalls: %lu  mispredict flushes: %lu\n",
+           (unsigned long)dut->debug_cycle, (unsigned long)dut->debug_instret,
+           (double)dut->debug_cycle / dut->debug_instret,
+           (unsigned long)stalls, (unsigned long)flushes);
+    printf("🔮 branches: %u (%u mispredicted)  jumps: %u (%u mispredicted)\n",
+           dut->debug_bp_branches, dut->debug_bp_branch_miss,
+           dut->debug_bp_jumps, dut->debug_bp_jump_miss);
+
+    // Only populated when the pipe is built with ICACHE=1
+    if (dut->debug_ic_hits || dut->debug_ic_misses)
+        printf("🗃️  I-cache hits: %u  misses: %u  refills: %u  fetch stall cycles: %lu\n",
+               dut->debug_ic_hits, dut->debug_ic_misses, dut->debug_ic_refills,
+               (unsigned long)fetch_stalls);
+
+    // Only populated when the pipe is built with DCACHE=1
+    if (dut->debug_dc_hits || dut->debug_dc_misses)
+        printf("🗃️  D-cache hits: %u  misses: %u  writebacks: %u  memory stall cycles: %lu\n",
+               dut->debug_dc_hits, dut->debug_dc_misses, dut->debug_dc_writebacks,
+               (unsigned long)mem_stalls);
+
+    trace.close();
+    delete dut;
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <verilated.h>
+#include "VRV32I_SoC.h"
+#include "common/clock.h"
+#include "common/program_loader.h"
+#include "common/trace_ctl.h"
+
+// Runs src/RV32I_SoC_TestProg.mem on every hart until all of them have
+// exited with ECALL, then checks each hart's exit code and its word of the
+// shared DataMem, and prints what the sharing cost each hart.
+//   +max_cycles+N   give up after N cycles (default 100000)
+// Other hart counts: VFLAGS="-GNUM_HARTS=4" ./Verilatte.sh RV32I_SoC.
+// Each hart is a separate block of logic, so `fast` builds spread them over
+// the model threads: THREADS=4 ./Verilatte.sh RV32I_SoC fast.
+#define SLOT_BASE  0x40     // hart i increments the word at SLOT_BASE + 4 * i
+#define ITERATIONS 64
+vluint64_t sim_time = 0;
+uint64_t cycle = 0;
+
+TraceCtl trace;
+
+// Trace triggers follow hart 0's PC (dbg_hart 0)
+void advance_sim(VRV32I_SoC* dut) {
+    trace.sample(cycle++, dut->dbg_pc, dut->illegal_op != 0);
+    tb::clock_cycle(dut, [] { trace.dump(sim_time++); });
+}
+
+struct HartResult {
+    bool exited = false;
+    uint32_t exit_code = 0;
+    uint64_t cycles = 0, instret = 0, mem_wait = 0;
+};
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    VRV32I_SoC* dut = new VRV32I_SoC;
+
+    trace.open(dut, "RV32I_SoC", "VCD/RV32I_SoC_waveform");
+
+    unsigned harts = dut->num_harts;
+    std::vector<HartResult> result(harts);
+    unsigned exited = 0;
+    uint64_t max_cycles = strtoull(tb::plusarg_str("max_cycles+", "100000"), nullptr, 0);
+
+    // Initialize
+    tb::reset(dut, advance_sim);
+
+    auto start = std::chrono::steady_clock::now();
+    while (exited < harts && cycle < max_cycles && !dut->illegal_op) {
+        dut->eval();
+        uint64_t exits = dut->sim_exit;
+        for (unsigned i = 0; i < harts; i++) {
+            if (!(exits >> i & 1) || result[i].exited) continue;
+            dut->dbg_hart = i;
+            dut->eval();
+            result[i].exited = true;
+            result[i].exit_code = dut->dbg_exit_code;
+            result[i].cycles = dut->dbg_cycle;
+            result[i].instret = dut->dbg_instret;
+            exited++;
+            printf("🏁 hart %u: ECALL at pc 0x%08X, exit code 0x%X, cycle %lu\n", i, dut->dbg_pc,
+                   dut->dbg_exit_code, (unsigned long)cycle);
+        }
+        if (dut->dbg_hart) {
+            dut->dbg_hart = 0;
+            dut->eval();
+        }
+        advance_sim(dut);
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (dut->illegal_op) printf("❌ Illegal instruction on harts 0x%lX\n", (unsigned long)dut->illegal_op);
+    assert(!dut->illegal_op && "❌ A hart hit an illegal instruction");
+    if (exited < harts) printf("❌ Only %u of %u harts exited in %lu cycles\n", exited, harts, (unsigned long)max_cycles);
+    assert(exited == harts && "❌ Not every hart exited (+max_cycles+N?)");
+
+    MemPort dmem = verilated_mem("TOP.RV32I_SoC.u_dataMem", false);
+    uint64_t total_wait = 0;
+    printf("hart\texit code\tslot\tcycles\tinstret\tCPI\tmem wait\n");
+    for (unsigned i = 0; i < harts; i++) {
+        dut->dbg_hart = i;
+        dut->eval();
+        result[i].mem_wait = dut->dbg_wait_cycles;
+        total_wait += result[i].mem_wait;
+
+        uint32_t addr = SLOT_BASE + 4 * i, slot = 0;
+        assert(dmem.data && addr + 4 <= dmem.size && "❌ Slot outside the shared DataMem");
+        memcpy(&slot, dmem.data + addr, 4);
+        printf("%u\t0x%08X\t%u\t%lu\t%lu\t%.2f\t%lu\n", i, result[i].exit_code, slot,
+               (unsigned long)result[i].cycles, (unsigned long)result[i].instret,
+               (double)result[i].cycles / result[i].instret, (unsigned long)result[i].mem_wait);
+
+        assert(result[i].exit_code == (i << 8) + ITERATIONS && "❌ Exit code mismatch (mhartid or shared memory)");
+        assert(slot == ITERATIONS && "❌ Shared memory slot mismatch");
+    }
+
+    printf("✅ %u harts passed\n", harts);
+    printf("📊 %lu cycles, %lu cycles waiting on the shared memory (%.1f%% of hart-cycles), %.0f cycles/sec\n",
+           (unsigned long)cycle, (unsigned long)total_wait, 100.0 * total_wait / ((double)cycle * harts),
+           cycle / (secs > 0 ? secs : 1e-9));
+
+    trace.close();
+    dut->final();
+    delete dut;
+    return 0;
+}
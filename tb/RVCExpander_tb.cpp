@@ -0,0 +1,75 @@
+#include <verilated.h>
+#include "VRVCExpander.h"
+#include "common/harness.h"
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+
+    // Expected values are the RV32I encodings of the equivalent instruction
+    struct TestCase {
+        uint16_t cinstr;
+        uint32_t expected_instr;
+        const char* description;
+    } test_cases[] = {
+        // Quadrant 0
+        {0x0800, 0x01010413, "C.ADDI4SPN x8, sp, 16"},
+        {0x1FFC, 0x3FC10793, "C.ADDI4SPN x15, sp, 1020"},
+        {0x4144, 0x00452483, "C.LW x9, 4(x10)"},
+        {0x5C7C, 0x07C42783, "C.LW x15, 124(x8)"},
+        {0xC22C, 0x04B62023, "C.SW x11, 64(x12)"},
+
+        // Quadrant 1
+        {0x0001, 0x00000013, "C.NOP"},
+        {0x157D, 0xFFF50513, "C.ADDI x10, -1"},
+        {0x02FD, 0x01F28293, "C.ADDI x5, 31"},
+        {0x3FFD, 0xFFFFF0EF, "C.JAL -2"},
+        {0x2FFD, 0x7FE000EF, "C.JAL 2046"},
+        {0x3001, 0x801FF0EF, "C.JAL -2048"},
+        {0xAB99, 0x5560006F, "C.J 0x556"},
+        {0x5501, 0xFE000513, "C.LI x10, -32"},
+        {0x7101, 0xE0010113, "C.ADDI16SP -512"},
+        {0x617D, 0x1F010113, "C.ADDI16SP 496"},
+        {0x75FD, 0xFFFFF5B7, "C.LUI x11, 0xFFFFF"},
+        {0x6585, 0x000015B7, "C.LUI x11, 0x1"},
+        {0x808D, 0x0034D493, "C.SRLI x9, 3"},
+        {0x84FD, 0x41F4D493, "C.SRAI x9, 31"},
+        {0x9A41, 0xFF067613, "C.ANDI x12, -16"},
+        {0x8C05, 0x40940433, "C.SUB x8, x9"},
+        {0x8D2D, 0x00B54533, "C.XOR x10, x11"},
+        {0x8E55, 0x00D66633, "C.OR x12, x13"},
+        {0x8F7D, 0x00F77733, "C.AND x14, x15"},
+        {0xD001, 0xF00400E3, "C.BEQZ x8, -256"},
+        {0xEFFD, 0x0E079F63, "C.BNEZ x15, 254"},
+        {0xF975, 0xFE051AE3, "C.BNEZ x10, -12"},
+
+        // Quadrant 2
+        {0x0F9E, 0x007F9F93, "C.SLLI x31, 7"},
+        {0x50FE, 0x0FC12083, "C.LWSP ra, 252(sp)"},
+        {0x8082, 0x00008067, "C.JR ra"},
+        {0x852E, 0x00B00533, "C.MV x10, x11"},
+        {0x9002, 0x00100073, "C.EBREAK"},
+        {0x9282, 0x000280E7, "C.JALR x5"},
+        {0x9636, 0x00D60633, "C.ADD x12, x13"},
+        {0xDFFE, 0x0FF12E23, "C.SWSP x31, 252(sp)"},
+
+        // Illegal / reserved (expand to 0)
+        {0x0000, 0x00000000, "All-zero parcel"},
+        {0x0004, 0x00000000, "C.ADDI4SPN x9, imm 0"},
+        {0x6101, 0x00000000, "C.ADDI16SP, imm 0"},
+        {0x6581, 0x00000000, "C.LUI, imm 0"},
+        {0x4012, 0x00000000, "C.LWSP, rd x0"},
+        {0x8002, 0x00000000, "C.JR x0"},
+        {0x908D, 0x00000000, "C.SRLI, shamt[5] (RV64)"},
+        {0x2000, 0x00000000, "C.FLD"},
+        {0xE002, 0x00000000, "C.FSWSP"},
+        {0x9C05, 0x00000000, "C.SUBW (RV64)"},
+    };
+
+    return tb::run<VRVCExpander>("RVCExpander", [&](tb::Sim<VRVCExpander>& sim, tb::Check& check) {
+        for (auto test : test_cases) {
+            sim->cinstr = test.cinstr;
+            sim.eval();
+            check.expect_eq(sim->instr, test.expected_instr, "%s (0x%04X)", test.description, test.cinstr);
+        }
+    }, 1);
+}
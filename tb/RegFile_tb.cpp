@@ -1,19 +1,13 @@
-#include <iostream>
+#include <algorithm>
 #include <verilated.h>
-#include <verilated_vcd_c.h>
 #include "VRegFile.h"
+#include "common/harness.h"
 
-#define MAX_SIM_TIME 300
-vluint64_t sim_time = 0;
+#define RANDOM_VECTORS 2000     // per shard, override with +vectors+N
 
 int main(int argc, char** argv, char** env) {
     Verilated::commandArgs(argc, argv);
-    VRegFile* dut = new VRegFile;
-
-    Verilated::traceEverOn(true);
-    VerilatedVcdC* m_trace = new VerilatedVcdC;
-    dut->trace(m_trace, 5);
-    m_trace->open("VCD/RegFile_waveform.vcd");
+    uint64_t vectors = tb::Options::get().vectors_or(RANDOM_VECTORS);
 
     bool reset = false;
     bool write_enable = true;
@@ -38,38 +32,43 @@ int main(int argc, char** argv, char** env) {
         {reset, !write_enable, 16, 2, 16, 0xDEADBEEF, 0x00000000, 0x00000000, "Verify reset priority"},
     };
 
-    printf("    RegFile Test\t\t\t||\trsrc1\trsrc2\twdest\twdata\t\trdata1\t\trdata2\n");
-    printf("---------------------------------------------------------------------------------------------------------------------\n");
-
-    for (auto test : test_cases) {
-        if (sim_time >= MAX_SIM_TIME) break;
-
-        dut->rst = test.reset;
-        dut->wen = test.write_enable;
-        dut->rsrc1 = test.rsrc1;
-        dut->rsrc2 = test.rsrc2;
-        dut->wdest = test.wdest;
-        dut->wdata = test.wdata;
-
-        // Simulate a clock edge
-        dut->clk = 0; dut->eval(); m_trace->dump(sim_time++);
-        dut->clk = 1; dut->eval(); m_trace->dump(sim_time++);
+    return tb::run<VRegFile>("RegFile", [&](tb::Sim<VRegFile>& sim, tb::Check& check) {
+        auto cycle = [&](bool rst, bool wen, uint8_t rsrc1, uint8_t rsrc2, uint8_t wdest, uint32_t wdata) {
+            sim->rst = rst;
+            sim->wen = wen;
+            sim->rsrc1 = rsrc1;
+            sim->rsrc2 = rsrc2;
+            sim->wdest = wdest;
+            sim->wdata = wdata;
+            sim.tick();
+        };
 
-        printf("[%lu] %-30s\t||\tx%-2d\tx%-2d\tx%-2d\t0x%08X\t0x%08X\t0x%08X\n",
-               sim_time / 2,
-               test.description,
-               test.rsrc1, test.rsrc2, test.wdest,
-               test.wdata,
-               dut->rdata1, dut->rdata2);
+        if (check.shard() == 0) {
+            for (auto test : test_cases) {
+                cycle(test.reset, test.write_enable, test.rsrc1, test.rsrc2, test.wdest, test.wdata);
+                check.expect_eq(sim->rdata1, test.expected_rdata1, "%s: rdata1", test.description);
+                check.expect_eq(sim->rdata2, test.expected_rdata2, "%s: rdata2", test.description);
+            }
+        }
 
-        // Assertions
-        assert(dut->rdata1 == test.expected_rdata1 && "❌ rdata1 mismatch");
-        assert(dut->rdata2 == test.expected_rdata2 && "❌ rdata2 mismatch");
-    }
+        // Random traffic against a reference register file, with an
+        // occasional reset
+        uint32_t regs[32] = {};
+        sim.reset();
+        for (uint64_t i = 0; i < vectors; i++) {
+            bool rst = check.rand_below(64) != 0;
+            bool wen = check.rand32() & 1;
+            uint8_t rsrc1 = check.rand_below(32), rsrc2 = check.rand_below(32), wdest = check.rand_below(32);
+            uint32_t wdata = check.rand32();
 
-    printf("✅ All RegFile test cases passed!\n");
+            cycle(rst, wen, rsrc1, rsrc2, wdest, wdata);
+            if (!rst) std::fill(regs, regs + 32, 0);
+            else if (wen && wdest != 0) regs[wdest] = wdata;
 
-    m_trace->close();
-    delete dut;
-    return 0;
+            // WRITE_FWD: the write port still drives the reads after the edge
+            auto expected = [&](uint8_t rsrc) { return (wen && rsrc == wdest && wdest != 0) ? wdata : regs[rsrc]; };
+            check.expect_eq(sim->rdata1, expected(rsrc1), "vector %lu: rdata1 x%u", (unsigned long)i, rsrc1);
+            check.expect_eq(sim->rdata2, expected(rsrc2), "vector %lu: rdata2 x%u", (unsigned long)i, rsrc2);
+        }
+    });
 }
@@ -0,0 +1,157 @@
+// Batch runs: many independent programs through a pool of models in one
+// process, instead of one process (and one model build) per program.
+//
+// Each worker thread owns one model in its own VerilatedContext, built once,
+// and takes jobs off a shared queue. Between jobs the testbench resets the
+// model and reloads its memories. Results are kept in job order and printed
+// as one report: the failures, then totals and throughput.
+//
+// A job list has one job per non-empty line: that job's plusargs, as in a
+// +fork file. Lines starting with '#' are comments.
+//   +imem+./src/SimBench_crc.mem +exit+halt
+//   +elf+build/rv32ui-p-add.elf
+//
+// The job body runs on a worker thread: it must not touch globals or the
+// command line (Verilated::commandArgsPlusMatch reads another context).
+// Parse options in main() and capture them.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <verilated.h>
+
+namespace batch {
+
+struct Job {
+    size_t line = 0;                    // in the job list
+    std::vector<std::string> args;
+
+    // Value of +<name><value> (name includes its trailing '+'), or fallback
+    std::string arg(const char* name, const char* fallback = "") const {
+        size_t len = strlen(name);
+        for (const auto& a : args)
+            if (a.size() > len && a[0] == '+' && a.compare(1, len, name) == 0) return a.substr(len + 1);
+        return fallback;
+    }
+    bool flag(const char* name) const {
+        for (const auto& a : args)
+            if (a.size() > 1 && a[0] == '+' && a.compare(1, std::string::npos, name) == 0) return true;
+        return false;
+    }
+    std::string label() const {
+        std::string s;
+        for (const auto& a : args) s += (s.empty() ? "" : " ") + a;
+        return s;
+    }
+};
+
+struct Result {
+    bool passed = false;
+    std::string status;                 // e.g. "exit 0", "halt", "timeout at 0x00000040"
+    uint64_t cycles = 0, instret = 0;
+    double secs = 0;                    // host time, reset and load included
+};
+
+inline bool read_jobs(const std::string& path, std::vector<Job>& jobs) {
+    std::ifstream in(path);
+    if (!in) return false;
+    size_t n = 0;
+    for (std::string line; std::getline(in, line);) {
+        n++;
+        std::istringstream ss(line);
+        Job job;
+        for (std::string a; ss >> a;) job.args.push_back(a);
+        if (job.args.empty() || job.args[0][0] == '#') continue;
+        job.line = n;
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+// Run every job on `threads` workers (capped at the number of jobs) as
+// body(model, context, job, result). A model is first evaluated by its
+// first job, so its initial blocks run there. Appends one JSON
+// object per job, and one with the totals, to `json` if set. Returns
+// main()'s exit status.
+template <class Model, class Body>
+int run(const char* name, const std::vector<Job>& jobs, unsigned threads, const std::string& json, Body body) {
+    if (jobs.empty()) {
+        printf("❌ %s: the job list is empty\n", name);
+        return 1;
+    }
+    threads = std::max(1u, std::min<unsigned>(threads, (unsigned)jobs.size()));
+
+    std::vector<Result> results(jobs.size());
+    std::atomic<size_t> next{0};
+    std::mutex print;
+
+    auto start = std::chrono::steady_clock::now();
+    auto worker = [&]() {
+        std::unique_ptr<VerilatedContext> context(new VerilatedContext);
+        std::unique_ptr<Model> model(new Model(context.get(), "TOP"));
+        for (size_t i; (i = next++) < jobs.size();) {
+            auto t0 = std::chrono::steady_clock::now();
+            body(*model, *context, jobs[i], results[i]);
+            results[i].secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            if (!results[i].passed) {
+                std::lock_guard<std::mutex> lock(print);
+                printf("❌ job %zu (line %zu) %s: %s\n", i, jobs[i].line, jobs[i].label().c_str(),
+                       results[i].status.c_str());
+            }
+        }
+        model->final();
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t passed = 0;
+    uint64_t cycles = 0, instret = 0;
+    for (const auto& r : results) {
+        passed += r.passed;
+        cycles += r.cycles;
+        instret += r.instret;
+    }
+    size_t failed = jobs.size() - passed;
+
+    printf("%s %s: %zu of %zu jobs passed on %u models, %.3f s\n", failed ? "❌" : "✅", name, passed, jobs.size(),
+           threads, secs);
+    printf("📊 %lu cycles, %lu instructions -> %.1f jobs/s, %.1f KIPS aggregate\n", (unsigned long)cycles,
+           (unsigned long)instret, jobs.size() / secs, instret / secs / 1e3);
+
+    if (!json.empty()) {
+        FILE* fp = fopen(json.c_str(), "a");
+        if (!fp) {
+            printf("❌ Cannot open %s\n", json.c_str());
+            return 1;
+        }
+        for (size_t i = 0; i < jobs.size(); i++) {
+            std::string label = jobs[i].label();
+            for (size_t p = 0; (p = label.find_first_of("\"\\", p)) != std::string::npos; p += 2) label.insert(p, "\\");
+            fprintf(fp, "{\"job\": %zu, \"args\": \"%s\", \"passed\": %s, \"status\": \"%s\", \"cycles\": %lu, "
+                        "\"instret\": %lu, \"host_seconds\": %.6f}\n",
+                    i, label.c_str(), results[i].passed ? "true" : "false", results[i].status.c_str(),
+                    (unsigned long)results[i].cycles, (unsigned long)results[i].instret, results[i].secs);
+        }
+        fprintf(fp, "{\"batch\": \"%s\", \"jobs\": %zu, \"passed\": %zu, \"models\": %u, \"cycles\": %lu, "
+                    "\"instret\": %lu, \"host_seconds\": %.6f, \"jobs_per_sec\": %.1f, \"kips\": %.1f}\n",
+                name, jobs.size(), passed, threads, (unsigned long)cycles, (unsigned long)instret, secs,
+                jobs.size() / secs, instret / secs / 1e3);
+        fclose(fp);
+    }
+    return failed ? 1 : 0;
+}
+
+}  // namespace batch
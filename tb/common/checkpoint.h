@@ -0,0 +1,237 @@
+// Checkpoint/restore of a Verilated model through its public variables.
+//
+// A checkpoint holds every public variable under one scope (the model's
+// top instance) by name, and the pages of SparseMem 0 (DataMemSparse).
+// InstrMem/DataMem are always public. checkpoint.vlt makes the rest of the
+// core's state public: PC, RegFile, the CSR counters, and the
+// microarchitectural state (caches, branch predictor, divider, fetch
+// alignment). So a restored run continues cycle for cycle as the original.
+// Build with it for both the save and the restore:
+//   VFLAGS="checkpoint.vlt" ./Verilatte.sh RV32I_Core fast ...
+// Restore only into a build with the same parameters: the variable names
+// and sizes must all match, or restore() fails.
+//
+// File (gzip when the path ends in .gz; reading accepts both):
+//   "RV32CKPT", u32 version, u64 cycle, u32 vars
+//   per variable: u16 name length, name, u32 bytes, data
+//   u32 pages, per page: u32 address, SparseMem::PAGE_SIZE bytes
+//
+// fork_runs() starts several runs from one checkpoint in parallel: one
+// child process per line of a file, each with that line's plusargs.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include <verilated.h>
+#include <verilated_syms.h>
+#include <zlib.h>
+
+#include "sparse_mem.h"
+
+static const char CHECKPOINT_MAGIC[8] = {'R', 'V', '3', '2', 'C', 'K', 'P', 'T'};
+
+class Checkpoint {
+public:
+    // Public variables of every scope under `scope`, by full name
+    static std::map<std::string, VerilatedVar*> variables(const std::string& scope) {
+        std::map<std::string, VerilatedVar*> vars;
+        const VerilatedScopeNameMap* scopes = Verilated::threadContextp()->scopeNameMap();
+        if (!scopes) return vars;
+        for (const auto& s : *scopes) {
+            std::string name = s.first;
+            if (name != scope && name.compare(0, scope.size() + 1, scope + ".") != 0) continue;
+            VerilatedVarNameMap* vp = s.second->varsp();
+            if (!vp) continue;
+            for (auto& v : *vp) vars[name + "." + v.first] = &v.second;
+        }
+        return vars;
+    }
+
+    static bool save(const std::string& path, const std::string& scope, uint64_t cycle) {
+        gzFile f = gzopen(path.c_str(), is_gz(path) ? "wb1" : "wbT");
+        if (!f) return false;
+        auto vars = variables(scope);
+        bool ok = gzwrite(f, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) == sizeof(CHECKPOINT_MAGIC) &&
+                  put<uint32_t>(f, VERSION) && put<uint64_t>(f, cycle) && put<uint32_t>(f, (uint32_t)vars.size());
+        for (auto& v : vars) {
+            uint32_t bytes = (uint32_t)v.second->totalSize();
+            ok = ok && put<uint16_t>(f, (uint16_t)v.first.size()) &&
+                 gzwrite(f, v.first.data(), (unsigned)v.first.size()) == (int)v.first.size() &&
+                 put<uint32_t>(f, bytes) && gzwrite(f, v.second->datap(), bytes) == (int)bytes;
+        }
+
+        const SparseMem& sparse = SparseMem::instance(0);
+        ok = ok && put<uint32_t>(f, (uint32_t)sparse.pages());
+        sparse.for_each_page([&](uint32_t addr, const uint8_t* data) {
+            ok = ok && put<uint32_t>(f, addr) && gzwrite(f, data, SparseMem::PAGE_SIZE) == (int)SparseMem::PAGE_SIZE;
+        });
+        return gzclose(f) == Z_OK && ok;
+    }
+
+    // Overwrite the model's state; eval() afterwards to settle. Returns the
+    // saved cycle count in `cycle`. On failure `error` says why and the
+    // model may be partly written.
+    static bool restore(const std::string& path, const std::string& scope, uint64_t& cycle, std::string& error) {
+        gzFile f = gzopen(path.c_str(), "rb");
+        if (!f) {
+            error = "cannot open " + path;
+            return false;
+        }
+        bool ok = restore_from(f, scope, cycle, error);
+        gzclose(f);
+        return ok;
+    }
+
+private:
+    static constexpr uint32_t VERSION = 1;
+
+    static bool is_gz(const std::string& path) {
+        return path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+    }
+
+    template <class T>
+    static bool put(gzFile f, T v) { return gzwrite(f, &v, sizeof(v)) == (int)sizeof(v); }
+    template <class T>
+    static bool get(gzFile f, T& v) { return gzread(f, &v, sizeof(v)) == (int)sizeof(v); }
+
+    static bool restore_from(gzFile f, const std::string& scope, uint64_t& cycle, std::string& error) {
+        char magic[sizeof(CHECKPOINT_MAGIC)];
+        uint32_t version = 0, count = 0;
+        if (gzread(f, magic, sizeof(magic)) != (int)sizeof(magic) || memcmp(magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+            !get(f, version) || version != VERSION) {
+            error = "not a checkpoint (or another version)";
+            return false;
+        }
+        if (!get(f, cycle) || !get(f, count)) {
+            error = "truncated header";
+            return false;
+        }
+
+        auto vars = variables(scope);
+        if (count != vars.size()) {
+            error = "the build has " + std::to_string(vars.size()) + " public variables, the checkpoint " +
+                    std::to_string(count) + " (other parameters, or not built with checkpoint.vlt?)";
+            return false;
+        }
+        std::string name;
+        for (uint32_t i = 0; i < count; i++) {
+            uint16_t len = 0;
+            uint32_t bytes = 0;
+            if (!get(f, len)) break;
+            name.resize(len);
+            if (gzread(f, &name[0], len) != len || !get(f, bytes)) break;
+            auto it = vars.find(name);
+            if (it == vars.end() || it->second->totalSize() != bytes) {
+                error = name + (it == vars.end() ? " is not in this build" : " has another size in this build");
+                return false;
+            }
+            if (gzread(f, it->second->datap(), bytes) != (int)bytes) break;
+            vars.erase(it);
+        }
+        if (!vars.empty()) {
+            error = "truncated variable data";
+            return false;
+        }
+
+        uint32_t pages = 0;
+        if (!get(f, pages)) {
+            error = "truncated SparseMem pages";
+            return false;
+        }
+        SparseMem& sparse = SparseMem::instance(0);
+        sparse.clear();
+        std::vector<uint8_t> page(SparseMem::PAGE_SIZE);
+        for (uint32_t i = 0; i < pages; i++) {
+            uint32_t addr = 0;
+            if (!get(f, addr) || gzread(f, page.data(), SparseMem::PAGE_SIZE) != (int)SparseMem::PAGE_SIZE) {
+                error = "truncated SparseMem pages";
+                return false;
+            }
+            sparse.write_block(addr, page.data(), SparseMem::PAGE_SIZE);
+        }
+        return true;
+    }
+};
+
+// +fork+<file>: run one child process per non-empty line of <file>, each
+// with that line's plusargs ahead of the command line's (so they take
+// precedence), typically all restoring one +restore checkpoint. Child i
+// writes its output to <dir>/fork<i>.log (+fork_dir+<dir>, default
+// "fork"). Call first in main(), before Verilated::commandArgs() and any
+// model: Verilator's worker threads do not survive fork().
+//
+// Returns true in the parent once every child has exited, with `status` 0
+// if all succeeded. Returns false in a child, with argc/argv replaced and
+// fork_index() set, and when there is no +fork.
+inline int& fork_index() {
+    static int index = -1;
+    return index;
+}
+
+inline bool fork_runs(int& argc, char**& argv, int& status) {
+    std::string list, dir = "fork";
+    std::vector<char*> rest{argv[0]};
+    for (int i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "+fork+", 6)) list = argv[i] + 6;
+        else if (!strncmp(argv[i], "+fork_dir+", 10)) dir = argv[i] + 10;
+        else rest.push_back(argv[i]);
+    }
+    if (list.empty()) return false;
+
+    std::ifstream in(list);
+    if (!in) {
+        fprintf(stderr, "❌ Cannot read the +fork file %s\n", list.c_str());
+        status = 1;
+        return true;
+    }
+    std::vector<std::vector<std::string>> runs;
+    for (std::string line; std::getline(in, line);) {
+        std::istringstream ss(line);
+        std::vector<std::string> args;
+        for (std::string arg; ss >> arg;) args.push_back(arg);
+        if (!args.empty()) runs.push_back(args);
+    }
+    mkdir(dir.c_str(), 0755);
+    fflush(stdout);
+
+    std::vector<pid_t> pids;
+    for (size_t i = 0; i < runs.size(); i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            std::string log = dir + "/fork" + std::to_string(i) + ".log";
+            if (!freopen(log.c_str(), "w", stdout)) _exit(1);
+            dup2(fileno(stdout), fileno(stderr));
+
+            // Leaked on purpose: argv lives as long as the process
+            auto* args = new std::vector<char*>{rest[0]};
+            for (auto& a : runs[i]) args->push_back(strdup(a.c_str()));
+            args->insert(args->end(), rest.begin() + 1, rest.end());
+            args->push_back(nullptr);
+            argc = (int)args->size() - 1;
+            argv = args->data();
+            fork_index() = (int)i;
+            return false;
+        }
+        pids.push_back(pid);
+    }
+
+    status = 0;
+    printf("🍴 %zu runs forked, output in %s/\n", pids.size(), dir.c_str());
+    for (size_t i = 0; i < pids.size(); i++) {
+        int ws = 0;
+        bool ok = pids[i] > 0 && waitpid(pids[i], &ws, 0) == pids[i] && WIFEXITED(ws) && WEXITSTATUS(ws) == 0;
+        printf("%s fork %zu: %s\n", ok ? "✅" : "❌", i, ok ? "passed" :
+               pids[i] <= 0 ? "fork() failed" : WIFEXITED(ws) ? "nonzero exit status" : "killed by a signal");
+        if (!ok) status = 1;
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+// Clock, reset and plusarg helpers for the integration testbenches (the
+// cores and the SoC). Those drive one model through a whole program with
+// TraceCtl watching it, so they do not use the sharded tb::Sim of
+// harness.h, but they clock and reset it the same way.
+//
+//   void advance_sim(VRV32I_Pipe* dut) {
+//       trace.sample(cycle++, dut->debug_pc, dut->illegal_op);
+//       tb::clock_cycle(dut, [] { trace.dump(sim_time++); });
+//   }
+//   ...
+//   tb::reset(dut, advance_sim);
+#pragma once
+
+#include <cstring>
+#include <verilated.h>
+
+namespace tb {
+
+// +<name><value>: the value, or `fallback` if the plusarg is not given.
+// `name` includes the trailing '+' (e.g. "max_cycles+").
+inline const char* plusarg_str(const char* name, const char* fallback) {
+    const char* arg = Verilated::commandArgsPlusMatch(name);
+    return arg[0] ? arg + strlen(name) + 1 : fallback;
+}
+
+// One clock cycle on `clk`: low, then the rising edge. `after_eval()` runs
+// after each of the two evals (the waveform dump).
+template <class Model, class AfterEval>
+inline void clock_cycle(Model* dut, AfterEval after_eval) {
+    dut->clk = 0;
+    dut->eval();
+    after_eval();
+    dut->clk = 1;
+    dut->eval();
+    after_eval();
+}
+
+template <class Model>
+inline void clock_cycle(Model* dut) {
+    clock_cycle(dut, [] {});
+}
+
+// Hold the active-low `rst` for `cycles` calls of `advance(dut)`
+template <class Model, class Advance>
+inline void reset(Model* dut, Advance advance, unsigned cycles = 1) {
+    dut->clk = 0;
+    dut->rst = 0;
+    for (unsigned i = 0; i < cycles; i++) advance(dut);
+    dut->rst = 1;
+}
+
+}  // namespace tb
@@ -0,0 +1,263 @@
+// Binary commit log: one compact record per retired instruction, taken from
+// the core's retire_* port, for runs too long for printf tables or VCDs.
+// The converter (tb/tools/commitlog2spike.cpp) turns a log into Spike's
+// --log-commits text, so it diffs against Spike or another simulator.
+//
+// Records go into 1 MiB buffers. A path ending in ".gz" is gzip-compressed
+// (level 1) on a background thread, so the simulation only pays for the
+// encoding; otherwise full buffers are written directly. CommitLogReader
+// reads both (gzread passes plain files through).
+//
+// Layout (little-endian): the 8-byte magic "RV32CLOG", then per record
+//   u8  flags       PC | RD | MEM | STORE | size (log2 bytes) << 4 | RVC
+//   u16/u32 instr   u16 when RVC (16-bit encoding)
+//   u32 pc          only if PC: it is not the previous pc + its length
+//   u8 rd, u32 data if RD (rd != 0)
+//   u32 addr        if MEM (load or store)
+//   u32 data        if STORE, masked to the access size
+// A typical ALU instruction takes 10 bytes, a load 14.
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+struct CommitRecord {
+    uint32_t pc = 0, instr = 0;
+    uint8_t  rd = 0;            // register written, 0 if none
+    uint32_t rd_data = 0;
+    uint8_t  mem_bytes = 0;     // bytes loaded/stored, 0 if no access
+    bool     mem_wen = false;
+    uint32_t mem_addr = 0;
+    uint32_t mem_data = 0;      // store data
+};
+
+namespace commit_fmt {
+static const char MAGIC[8] = {'R', 'V', '3', '2', 'C', 'L', 'O', 'G'};
+enum : uint8_t { F_PC = 1, F_RD = 2, F_MEM = 4, F_STORE = 8, F_SIZE_SHIFT = 4, F_RVC = 0x40 };
+
+inline bool is_rvc(uint32_t instr) { return (instr & 3) != 3; }
+}  // namespace commit_fmt
+
+class CommitLogWriter {
+public:
+    ~CommitLogWriter() { close(); }
+
+    bool open(const std::string& path) {
+        m_gz = path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+        if (m_gz) {
+            m_gzf = gzopen(path.c_str(), "wb1");
+            if (!m_gzf) return false;
+            gzbuffer(m_gzf, 256 * 1024);
+            m_thread = std::thread(&CommitLogWriter::compress_loop, this);
+        } else {
+            m_fp = fopen(path.c_str(), "wb");
+            if (!m_fp) return false;
+        }
+        m_buf = take_buffer();
+        m_buf.insert(m_buf.end(), commit_fmt::MAGIC, commit_fmt::MAGIC + sizeof(commit_fmt::MAGIC));
+        return true;
+    }
+
+    bool is_open() const { return m_fp || m_gzf; }
+    uint64_t records() const { return m_records; }
+    uint64_t bytes() const { return m_bytes + m_buf.size(); }     // before compression
+
+    void write(const CommitRecord& r) {
+        using namespace commit_fmt;
+        uint8_t buf[32];
+        size_t n = 1;
+        uint8_t flags = 0;
+
+        if (is_rvc(r.instr)) {
+            flags |= F_RVC;
+            put16(buf + n, (uint16_t)r.instr); n += 2;
+        } else {
+            put32(buf + n, r.instr); n += 4;
+        }
+        if (r.pc != m_next_pc) {
+            flags |= F_PC;
+            put32(buf + n, r.pc); n += 4;
+        }
+        if (r.rd) {
+            flags |= F_RD;
+            buf[n++] = r.rd;
+            put32(buf + n, r.rd_data); n += 4;
+        }
+        if (r.mem_bytes) {
+            flags |= F_MEM | (r.mem_bytes == 1 ? 0 : r.mem_bytes == 2 ? 1 : 2) << F_SIZE_SHIFT;
+            put32(buf + n, r.mem_addr); n += 4;
+            if (r.mem_wen) {
+                flags |= F_STORE;
+                put32(buf + n, r.mem_data); n += 4;
+            }
+        }
+        buf[0] = flags;
+        m_next_pc = r.pc + (is_rvc(r.instr) ? 2 : 4);
+        m_records++;
+
+        m_buf.insert(m_buf.end(), buf, buf + n);
+        if (m_buf.size() >= BUFFER_BYTES) flush();
+    }
+
+    void close() {
+        if (!is_open()) return;
+        flush();
+        if (m_gz) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+            gzclose(m_gzf);
+            m_gzf = nullptr;
+        } else {
+            fclose(m_fp);
+            m_fp = nullptr;
+        }
+    }
+
+private:
+    static constexpr size_t BUFFER_BYTES = 1 << 20;
+    static constexpr size_t MAX_QUEUED = 8;     // buffers waiting for the compressor
+
+    static void put16(uint8_t* p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+    static void put32(uint8_t* p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+
+    std::vector<uint8_t> take_buffer() {
+        std::vector<uint8_t> buf;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free.empty()) {
+            buf.swap(m_free.back());
+            m_free.pop_back();
+        }
+        buf.clear();
+        buf.reserve(BUFFER_BYTES + 32);
+        return buf;
+    }
+
+    // Hand the current buffer to the compressor, or write it out
+    void flush() {
+        if (m_buf.empty()) return;
+        m_bytes += m_buf.size();
+        if (!m_gz) {
+            fwrite(m_buf.data(), 1, m_buf.size(), m_fp);
+            m_buf.clear();
+            return;
+        }
+        {
+            // The simulation waits only if the compressor falls MAX_QUEUED buffers behind
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_queue.size() < MAX_QUEUED; });
+            m_queue.push_back(std::move(m_buf));
+        }
+        m_cv.notify_all();
+        m_buf = take_buffer();
+    }
+
+    void compress_loop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_cv.wait(lock, [this] { return m_done || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            std::vector<uint8_t> buf = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            m_cv.notify_all();
+            gzwrite(m_gzf, buf.data(), (unsigned)buf.size());
+            lock.lock();
+            m_free.push_back(std::move(buf));
+        }
+    }
+
+    bool m_gz = false;
+    FILE* m_fp = nullptr;
+    gzFile m_gzf = nullptr;
+    std::vector<uint8_t> m_buf;
+    uint32_t m_next_pc = 0;
+    uint64_t m_records = 0, m_bytes = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::vector<uint8_t>> m_queue;
+    std::vector<std::vector<uint8_t>> m_free;
+    bool m_done = false;
+};
+
+class CommitLogReader {
+public:
+    ~CommitLogReader() { if (m_gzf) gzclose(m_gzf); }
+
+    // False if the file is missing or not a commit log
+    bool open(const std::string& path) {
+        m_gzf = gzopen(path.c_str(), "rb");
+        if (!m_gzf) return false;
+        gzbuffer(m_gzf, 256 * 1024);
+        char magic[sizeof(commit_fmt::MAGIC)];
+        return read(magic, sizeof(magic)) && memcmp(magic, commit_fmt::MAGIC, sizeof(magic)) == 0;
+    }
+
+    // Next record; false at the end of the log (or a truncated record)
+    bool next(CommitRecord& r) {
+        using namespace commit_fmt;
+        uint8_t flags;
+        if (!read(&flags, 1)) return false;
+        r = CommitRecord();
+        r.instr = (flags & F_RVC) ? get16() : get32();
+        r.pc = (flags & F_PC) ? get32() : m_next_pc;
+        if (flags & F_RD) {
+            read(&r.rd, 1);
+            r.rd_data = get32();
+        }
+        if (flags & F_MEM) {
+            r.mem_bytes = 1 << ((flags >> F_SIZE_SHIFT) & 3);
+            r.mem_addr = get32();
+            if (flags & F_STORE) {
+                r.mem_wen = true;
+                r.mem_data = get32();
+            }
+        }
+        m_next_pc = r.pc + (is_rvc(r.instr) ? 2 : 4);
+        return m_ok;
+    }
+
+    // One line of Spike's --log-commits output (RV32, machine mode)
+    static void print_spike(FILE* out, const CommitRecord& r) {
+        fprintf(out, "core   0: 3 0x%08x (0x%0*x)", r.pc, commit_fmt::is_rvc(r.instr) ? 4 : 8, r.instr);
+        if (r.rd) fprintf(out, " x%-2u 0x%08x", r.rd, r.rd_data);
+        if (r.mem_bytes) {
+            fprintf(out, " mem 0x%08x", r.mem_addr);
+            if (r.mem_wen) fprintf(out, " 0x%0*x", 2 * r.mem_bytes, r.mem_data);
+        }
+        fputc('\n', out);
+    }
+
+private:
+    bool read(void* dst, unsigned len) {
+        if (gzread(m_gzf, dst, len) != (int)len) m_ok = false;
+        return m_ok;
+    }
+    uint32_t get16() {
+        uint8_t b[2] = {0, 0};
+        read(b, 2);
+        return b[0] | b[1] << 8;
+    }
+    uint32_t get32() {
+        uint8_t b[4] = {0, 0, 0, 0};
+        read(b, 4);
+        return b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24;
+    }
+
+    gzFile m_gzf = nullptr;
+    uint32_t m_next_pc = 0;
+    bool m_ok = true;
+};
@@ -0,0 +1,472 @@
+// Constrained-random programs for differential testing of the cores
+// against Rv32Iss (RV32I_Core_tb +fuzz), and a minimizer for the programs
+// that fail.
+//
+// A program is a list of items of one or two instructions:
+//   prologue  random values (biased to 0, +-1, INT_MIN, ...) in x1..x29,
+//             x31 = the data base
+//   body      RV32I ALU ops, RV32M and Zba/Zbb/Zbs ops, loads and stores,
+//             forward branches and jumps (JAL, AUIPC + JALR) and counted
+//             loops, drawn by the weights in Mix
+//   epilogue  FENCE (a D-cache writes back), x1..x31 stored to the dump
+//             area at the top of the data region, ECALL
+// so the final DataMem holds both the memory and the registers.
+//
+// Every program ends: branches and jumps only go forward, except the BNE
+// closing a loop, whose counter x30 only the loop's own items write (1..4
+// iterations), and nothing outside a loop branches into its body. Loads
+// and stores use x31 + imm and stay in the data region below the dump
+// area. x30 and x31 are never random destinations.
+//
+// Items are addressed by index, so the minimizer can drop any subset of
+// the body: a branch whose target was dropped goes to the next item kept,
+// and a loop's two ends are dropped together.
+//
+//   fuzz::Program p = fuzz::generate(seed, imem_bytes, dmem_bytes, 200, mix);
+//   std::vector<uint32_t> words = p.encode(p.all());
+//   std::vector<bool> keep = fuzz::minimize(p, [&](const std::vector<bool>& k) { return fails(p.encode(k)); });
+#pragma once
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fuzz {
+
+// Relative weights of the instruction classes; 0 leaves a class out
+struct Mix {
+    unsigned alu = 40, muldiv = 6, zb = 6, load = 14, store = 14, branch = 12, jump = 4, loop = 4;
+
+    unsigned* weight(const std::string& name) {
+        if (name == "alu") return &alu;
+        if (name == "muldiv") return &muldiv;
+        if (name == "zb") return &zb;
+        if (name == "load") return &load;
+        if (name == "store") return &store;
+        if (name == "branch") return &branch;
+        if (name == "jump") return &jump;
+        if (name == "loop") return &loop;
+        return nullptr;
+    }
+    unsigned total() const { return alu + muldiv + zb + load + store + branch + jump + loop; }
+
+    // "alu=40,load=10": the classes named change, the others keep their weight
+    bool parse(const std::string& spec) {
+        for (size_t pos = 0; pos < spec.size();) {
+            size_t end = std::min(spec.find(',', pos), spec.size());
+            std::string kv = spec.substr(pos, end - pos);
+            size_t eq = kv.find('=');
+            unsigned* w = eq == std::string::npos ? nullptr : weight(kv.substr(0, eq));
+            if (!w) return false;
+            *w = strtoul(kv.c_str() + eq + 1, nullptr, 0);
+            pos = end + 1;
+        }
+        return total() > 0;
+    }
+};
+
+struct Item {
+    enum Kind : uint8_t { INSN, BRANCH, JAL, JALR, LOOP, LOOP_END };
+    Kind kind = INSN;
+    uint32_t word = 0;          // INSN; BRANCH/JAL/JALR without the offset; LOOP: the counter load
+    std::string text;           // INSN/LOOP: disassembly; BRANCH/JAL/JALR: up to the target
+    size_t target = 0;          // BRANCH/JAL/JALR: item index
+    size_t partner = 0;         // LOOP <-> LOOP_END
+
+    unsigned words() const { return kind == JALR || kind == LOOP_END ? 2 : 1; }
+};
+
+inline std::string format(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+inline std::string format(const char* fmt, ...) {
+    char buf[96];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    return buf;
+}
+
+inline uint32_t r_type(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+    return f7 << 25 | rs2 << 20 | rs1 << 15 | f3 << 12 | rd << 7 | op;
+}
+inline uint32_t i_type(int32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+    return (uint32_t)(imm & 0xFFF) << 20 | rs1 << 15 | f3 << 12 | rd << 7 | op;
+}
+inline uint32_t s_type(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3) {
+    return (uint32_t)(imm >> 5 & 0x7F) << 25 | rs2 << 20 | rs1 << 15 | f3 << 12 | (uint32_t)(imm & 0x1F) << 7 | 0x23;
+}
+inline uint32_t b_offset(int32_t imm) {
+    return (uint32_t)(imm >> 12 & 1) << 31 | (uint32_t)(imm >> 5 & 0x3F) << 25 |
+           (uint32_t)(imm >> 1 & 0xF) << 8 | (uint32_t)(imm >> 11 & 1) << 7;
+}
+inline uint32_t j_offset(int32_t imm) {
+    return (uint32_t)(imm >> 20 & 1) << 31 | (uint32_t)(imm >> 1 & 0x3FF) << 21 |
+           (uint32_t)(imm >> 11 & 1) << 20 | (uint32_t)(imm >> 12 & 0xFF) << 12;
+}
+
+struct Program {
+    uint64_t seed = 0;
+    std::vector<Item> items;
+    size_t body_begin = 0, body_end = 0;    // the minimizer only drops these
+    std::vector<uint8_t> data;              // initial DataMem bytes from address 0
+    uint32_t dump_addr = 0;                 // x1..x31 end up at dump_addr + 4 * i
+
+    std::vector<bool> all() const { return std::vector<bool>(items.size(), true); }
+
+    size_t body_words(const std::vector<bool>& keep) const {
+        size_t n = 0;
+        for (size_t i = body_begin; i < body_end; i++)
+            if (keep[i]) n += items[i].words();
+        return n;
+    }
+
+    // The instruction words of the kept items from address 0, and their
+    // disassembly if `text` is given
+    std::vector<uint32_t> encode(const std::vector<bool>& keep, std::vector<std::string>* text = nullptr) const {
+        // A dropped item's address is the next kept item's
+        std::vector<uint32_t> addr(items.size() + 1);
+        uint32_t a = 0;
+        for (size_t i = 0; i < items.size(); i++) {
+            addr[i] = a;
+            if (keep[i]) a += 4 * items[i].words();
+        }
+        addr[items.size()] = a;
+
+        std::vector<uint32_t> out;
+        auto emit = [&](uint32_t word, const std::string& s) {
+            out.push_back(word);
+            if (text) text->push_back(s);
+        };
+        for (size_t i = 0; i < items.size(); i++) {
+            if (!keep[i]) continue;
+            const Item& it = items[i];
+            int32_t off = (int32_t)(addr[it.target] - addr[i]);
+            switch (it.kind) {
+                case Item::INSN:
+                case Item::LOOP:
+                    emit(it.word, it.text);
+                    break;
+                case Item::BRANCH:
+                    emit(it.word | b_offset(off), it.text + format("%+d", off));
+                    break;
+                case Item::JAL:
+                    emit(it.word | j_offset(off), it.text + format("%+d", off));
+                    break;
+                case Item::JALR:
+                    emit(0x00000E97, "auipc x29, 0");   // x29 = pc
+                    emit(it.word | (uint32_t)(off & 0xFFF) << 20, it.text + format("%d(x29)", off));
+                    break;
+                case Item::LOOP_END: {
+                    // Back to the loop's first body item (or this decrement)
+                    int32_t back = (int32_t)(addr[it.partner + 1] - (addr[i] + 4));
+                    emit(i_type(-1, 30, 0, 30, 0x13), "addi x30, x30, -1");
+                    emit(0x000F1063 | b_offset(back), format("bne x30, x0, %+d", back));
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    // $readmemh images: InstrMem words MSB first with their disassembly,
+    // DataMem one byte per line
+    bool write_mem(const std::string& imem_path, const std::string& dmem_path, const std::vector<bool>& keep) const {
+        std::vector<std::string> text;
+        std::vector<uint32_t> words = encode(keep, &text);
+        FILE* fp = fopen(imem_path.c_str(), "w");
+        if (!fp) return false;
+        fprintf(fp, "// fuzz seed %lu: %zu of %zu body instructions kept\n", (unsigned long)seed,
+                body_words(keep), body_words(all()));
+        for (size_t i = 0; i < words.size(); i++)
+            fprintf(fp, "%02x %02x %02x %02x // %04zx %s\n", words[i] >> 24, words[i] >> 16 & 0xFF, words[i] >> 8 & 0xFF,
+                    words[i] & 0xFF, 4 * i, text[i].c_str());
+        fclose(fp);
+
+        fp = fopen(dmem_path.c_str(), "w");
+        if (!fp) return false;
+        for (uint8_t b : data) fprintf(fp, "%02x\n", b);
+        fclose(fp);
+        return true;
+    }
+};
+
+// A program of about `length` body instructions (fewer when InstrMem
+// cannot hold them) for an InstrMem/DataMem of these sizes. The same seed
+// and sizes always give the same program.
+inline Program generate(uint64_t seed, uint32_t imem_bytes, uint32_t dmem_bytes, unsigned length, const Mix& mix) {
+    static const uint32_t SPECIAL[] = {0, 1, 2, 0xFFFFFFFF, 0x80000000, 0x7FFFFFFF, 0x0000FFFF,
+                                       0x00008000, 0x000000FF, 0x00000080, 31, 32, 0xAAAAAAAA};
+    std::mt19937_64 rng(seed);
+    auto below = [&rng](uint32_t n) { return (uint32_t)(rng() % n); };
+    auto value = [&]() -> uint32_t {
+        switch (below(4)) {
+            case 0:  return SPECIAL[below(sizeof(SPECIAL) / sizeof(SPECIAL[0]))];
+            case 1:  return below(64) - 32;
+            default: return (uint32_t)rng();
+        }
+    };
+    auto imm12 = [&]() -> int32_t {
+        switch (below(6)) {
+            case 0:  return below(2) ? -2048 : 2047;
+            case 1:  return (int32_t)below(32) - 16;
+            default: return (int32_t)below(4096) - 2048;
+        }
+    };
+    auto rd = [&]() { return below(16) ? 1 + below(29) : 0; };     // x0..x29
+    auto rs = [&]() { return below(32); };
+
+    Program p;
+    p.seed = seed;
+    uint32_t region = std::min<uint32_t>(dmem_bytes, 2048) & ~3u;  // x0-relative stores reach the dump
+    p.dump_addr = region - 128;
+    uint32_t base = p.dump_addr / 2 & ~3u;
+    p.data.assign(region, 0);
+    for (uint32_t a = 0; a < p.dump_addr; a++) p.data[a] = (uint8_t)rng();
+
+    auto insn = [&p](uint32_t word, std::string text) {
+        Item it;
+        it.word = word;
+        it.text = std::move(text);
+        p.items.push_back(it);
+    };
+    auto li = [&](uint32_t r, uint32_t v) {
+        int32_t lo = (int32_t)(v << 20) >> 20;
+        uint32_t hi = v - (uint32_t)lo;
+        if (hi == 0) {
+            insn(i_type(lo, 0, 0, r, 0x13), format("addi x%u, x0, %d", r, lo));
+            return;
+        }
+        insn(hi | r << 7 | 0x37, format("lui x%u, 0x%x", r, hi >> 12));
+        if (lo) insn(i_type(lo, r, 0, r, 0x13), format("addi x%u, x%u, %d", r, r, lo));
+    };
+
+    for (uint32_t r = 1; r < 30; r++) li(r, value());
+    li(31, base);
+    uint32_t words = (uint32_t)p.items.size();
+    const uint32_t EPILOGUE = 33;                   // FENCE, 31 stores, ECALL
+
+    // The body, with the branch and jump targets chosen once its layout is known
+    p.body_begin = p.items.size();
+    struct Loop { size_t begin, end; };
+    std::vector<Loop> loops;
+    std::vector<std::pair<size_t, int>> control;     // item, loop it sits in (-1: none)
+    int in_loop = -1;
+    unsigned loop_left = 0;
+    const unsigned weights[] = {mix.alu, mix.muldiv, mix.zb, mix.load, mix.store, mix.branch, mix.jump, mix.loop};
+
+    // `words` counts an open loop's LOOP_END from the moment its LOOP is
+    // emitted, so closing the loop never overruns InstrMem
+    for (unsigned n = 0; n < length; n++) {
+        unsigned pick = below(mix.total()), cls = 0;
+        while (pick >= weights[cls]) pick -= weights[cls++];
+        if (cls == 7 && in_loop >= 0) cls = 0;
+        // An item is at most 2 words; a loop is its own word plus its LOOP_END
+        if (words + (cls == 7 ? 3 : 2) + EPILOGUE > imem_bytes / 4) break;
+
+        uint32_t d = rd(), s1 = rs(), s2 = rs();
+        switch (cls) {
+            case 0: {   // RV32I ALU
+                static const char* const R_OPS[] = {"add", "sub", "sll", "slt", "sltu", "xor", "srl", "sra", "or", "and"};
+                static const uint8_t R_F3[] = {0, 0, 1, 2, 3, 4, 5, 5, 6, 7};
+                static const char* const I_OPS[] = {"addi", "slti", "sltiu", "xori", "ori", "andi", "slli", "srli", "srai"};
+                static const uint8_t I_F3[] = {0, 2, 3, 4, 6, 7, 1, 5, 5};
+                uint32_t k = below(21);
+                if (k < 10) {
+                    uint32_t f7 = (k == 1 || k == 7) ? 0x20 : 0;
+                    insn(r_type(f7, s2, s1, R_F3[k], d, 0x33), format("%s x%u, x%u, x%u", R_OPS[k], d, s1, s2));
+                } else if (k < 19) {
+                    k -= 10;
+                    int32_t imm = k >= 6 ? (int32_t)below(32) | (k == 8 ? 0x400 : 0) : imm12();
+                    insn(i_type(imm, s1, I_F3[k], d, 0x13),
+                         format("%s x%u, x%u, %d", I_OPS[k], d, s1, k >= 6 ? imm & 31 : imm));
+                } else {
+                    uint32_t hi = (uint32_t)rng() & 0xFFFFF000;
+                    bool auipc = k == 20;
+                    insn(hi | d << 7 | (auipc ? 0x17 : 0x37), format("%s x%u, 0x%x", auipc ? "auipc" : "lui", d, hi >> 12));
+                }
+                break;
+            }
+            case 1: {   // RV32M
+                static const char* const OPS[] = {"mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu"};
+                uint32_t f3 = below(8);
+                insn(r_type(1, s2, s1, f3, d, 0x33), format("%s x%u, x%u, x%u", OPS[f3], d, s1, s2));
+                break;
+            }
+            case 2: {   // Zba/Zbb/Zbs
+                struct Op { const char* name; uint16_t f7; uint8_t f3; };
+                static const Op R_OPS[] = {
+                    {"sh1add", 0x10, 2}, {"sh2add", 0x10, 4}, {"sh3add", 0x10, 6}, {"andn", 0x20, 7},
+                    {"orn", 0x20, 6}, {"xnor", 0x20, 4}, {"min", 5, 4}, {"minu", 5, 5}, {"max", 5, 6},
+                    {"maxu", 5, 7}, {"rol", 0x30, 1}, {"ror", 0x30, 5}, {"bclr", 0x24, 1}, {"bext", 0x24, 5},
+                    {"binv", 0x34, 1}, {"bset", 0x14, 1}};
+                // Shift-immediate forms (imm[11:5] in f7) and the unary ops (f7 and rs2 in the immediate)
+                static const Op I_OPS[] = {
+                    {"rori", 0x600, 5}, {"bclri", 0x480, 1}, {"bexti", 0x480, 5}, {"binvi", 0x680, 1}, {"bseti", 0x280, 1}};
+                static const Op UNARY[] = {
+                    {"clz", 0x600, 1}, {"ctz", 0x601, 1}, {"cpop", 0x602, 1}, {"sext.b", 0x604, 1},
+                    {"sext.h", 0x605, 1}, {"rev8", 0x698, 5}, {"orc.b", 0x287, 5}};
+                uint32_t k = below(29);
+                if (k < 16) {
+                    const Op& op = R_OPS[k];
+                    insn(r_type(op.f7, s2, s1, op.f3, d, 0x33), format("%s x%u, x%u, x%u", op.name, d, s1, s2));
+                } else if (k < 21) {
+                    const Op& op = I_OPS[k - 16];
+                    uint32_t sh = below(32);
+                    insn(i_type(op.f7 | sh, s1, op.f3, d, 0x13), format("%s x%u, x%u, %u", op.name, d, s1, sh));
+                } else if (k < 28) {
+                    const Op& op = UNARY[k - 21];
+                    insn(i_type(op.f7, s1, op.f3, d, 0x13), format("%s x%u, x%u", op.name, d, s1));
+                } else {
+                    insn(r_type(4, 0, s1, 4, d, 0x33), format("zext.h x%u, x%u", d, s1));
+                }
+                break;
+            }
+            case 3:     // loads
+            case 4: {   // stores
+                static const char* const LOADS[] = {"lb", "lh", "lw", "?", "lbu", "lhu"};
+                static const char* const STORES[] = {"sb", "sh", "sw"};
+                static const uint8_t LOAD_F3[] = {0, 1, 2, 4, 5};
+                uint32_t f3 = cls == 3 ? LOAD_F3[below(5)] : below(3);
+                uint32_t size = 1u << (f3 & 3);
+                // Mostly aligned; the rest cross into the next word (DataMem splits them)
+                uint32_t a = below(p.dump_addr - size + 1);
+                if (below(8)) a &= ~(size - 1);
+                int32_t imm = (int32_t)a - (int32_t)base;
+                if (cls == 3)
+                    insn(i_type(imm, 31, f3, d, 0x03), format("%s x%u, %d(x31)", LOADS[f3], d, imm));
+                else
+                    insn(s_type(imm, s2, 31, f3), format("%s x%u, %d(x31)", STORES[f3], s2, imm));
+                break;
+            }
+            case 5: {   // conditional branches
+                static const char* const OPS[] = {"beq", "bne", "?", "?", "blt", "bge", "bltu", "bgeu"};
+                static const uint8_t BRANCH_F3[] = {0, 1, 4, 5, 6, 7};
+                uint32_t f3 = BRANCH_F3[below(6)];
+                if (!below(4)) s2 = s1;
+                Item it;
+                it.kind = Item::BRANCH;
+                it.word = r_type(0, s2, s1, f3, 0, 0x63);
+                it.text = format("%s x%u, x%u, ", OPS[f3], s1, s2);
+                control.push_back({p.items.size(), in_loop});
+                p.items.push_back(it);
+                break;
+            }
+            case 6: {   // JAL / JALR
+                Item it;
+                if (below(3)) d = below(2) ? d : below(2);      // often x0 or x1
+                if (below(3)) {
+                    it.kind = Item::JAL;
+                    it.word = d << 7 | 0x6F;
+                    it.text = format("jal x%u, ", d);
+                } else {
+                    it.kind = Item::JALR;
+                    it.word = i_type(0, 29, 0, d, 0x67);
+                    it.text = format("jalr x%u, ", d);
+                }
+                control.push_back({p.items.size(), in_loop});
+                p.items.push_back(it);
+                break;
+            }
+            case 7: {   // counted loop: its body is the next 2..9 items
+                uint32_t iterations = 1 + below(4);
+                Item it;
+                it.kind = Item::LOOP;
+                it.word = i_type((int32_t)iterations, 0, 0, 30, 0x13);
+                it.text = format("addi x30, x0, %u", iterations);
+                in_loop = (int)loops.size();
+                loops.push_back({p.items.size(), 0});
+                p.items.push_back(it);
+                loop_left = 2 + below(8);
+                words += 2;     // its LOOP_END
+                break;
+            }
+        }
+        words += p.items.back().words();
+
+        if (in_loop >= 0 && cls != 7 && --loop_left == 0) {
+            Item it;
+            it.kind = Item::LOOP_END;
+            it.partner = loops[in_loop].begin;
+            loops[in_loop].end = p.items.size();
+            p.items[it.partner].partner = p.items.size();
+            p.items.push_back(it);
+            in_loop = -1;
+        }
+    }
+    if (in_loop >= 0) {
+        Item it;
+        it.kind = Item::LOOP_END;
+        it.partner = loops[in_loop].begin;
+        loops[in_loop].end = p.items.size();
+        p.items[it.partner].partner = p.items.size();
+        p.items.push_back(it);
+    }
+    p.body_end = p.items.size();
+
+    // Forward targets, at most 16 items ahead: inside a loop up to its
+    // closing item, outside never into a loop body (its start instead)
+    for (auto& c : control) {
+        size_t i = c.first, t;
+        if (c.second >= 0) {
+            size_t end = loops[c.second].end;
+            t = i + 1 + below((uint32_t)std::min<size_t>(16, end - i));
+        } else {
+            t = std::min(i + 1 + below(16), p.body_end);
+            for (const Loop& l : loops)
+                if (t > l.begin && t <= l.end) t = l.begin;
+        }
+        p.items[i].target = t;
+    }
+
+    insn(0x0FF0000F, "fence");
+    for (uint32_t r = 1; r < 32; r++)
+        insn(s_type((int32_t)(p.dump_addr + 4 * r), r, 0, 2), format("sw x%u, %u(x0)", r, p.dump_addr + 4 * r));
+    insn(0x00000073, "ecall");
+    return p;
+}
+
+// Shrink a failing program: drop chunks of body items, halving the chunk
+// size down to single items, as long as fails(keep) stays true. A loop's
+// two ends go together. Returns the smallest failing keep mask found in
+// at most max_tries calls of fails.
+template <class Fails>
+std::vector<bool> minimize(const Program& p, Fails fails, unsigned max_tries = 2000) {
+    std::vector<bool> keep = p.all();
+    auto drop = [&p](std::vector<bool>& k, size_t i) {
+        k[i] = false;
+        if (p.items[i].kind == Item::LOOP || p.items[i].kind == Item::LOOP_END) k[p.items[i].partner] = false;
+    };
+
+    unsigned tries = 0;
+    size_t chunk = std::max<size_t>(1, (p.body_end - p.body_begin) / 2);
+    while (tries < max_tries) {
+        std::vector<size_t> live;
+        for (size_t i = p.body_begin; i < p.body_end; i++)
+            if (keep[i]) live.push_back(i);
+        if (live.empty()) break;
+        chunk = std::min(chunk, live.size());
+
+        bool shrunk = false;
+        for (size_t start = 0; start < live.size() && tries < max_tries; start += chunk) {
+            std::vector<bool> trial = keep;
+            for (size_t j = start; j < std::min(start + chunk, live.size()); j++) drop(trial, live[j]);
+            if (trial == keep) continue;
+            tries++;
+            if (fails(trial)) {
+                keep = trial;
+                shrunk = true;
+            }
+        }
+        if (shrunk) continue;
+        if (chunk == 1) break;
+        chunk = (chunk + 1) / 2;
+    }
+    return keep;
+}
+
+}  // namespace fuzz
@@ -0,0 +1,252 @@
+// Shared harness for the unit testbenches. It owns a model with its own
+// VerilatedContext, drives the clock, reset and waveform dump, and collects
+// checks into one summary line instead of a printf table per vector.
+// Randomized tests run as shards: one thread, one model and one seed each.
+//
+//   +seed+N      base seed (default 1); shard i uses seed N+i
+//   +shards+N    shards for randomized tests (default: hardware threads)
+//   +vectors+N   random vectors per shard (each testbench has a default)
+//   +verbose     print every check, not only the failures
+//
+// Only shard 0 dumps VCD/<name>_waveform.vcd (trace builds). To look at a
+// failing shard, rerun with +seed+<its seed> +shards+1.
+//
+//   int main(int argc, char** argv) {
+//       Verilated::commandArgs(argc, argv);
+//       return tb::run<VALU>("ALU", [](tb::Sim<VALU>& sim, tb::Check& check) {
+//           sim->src1 = check.rand32(); ...; sim.eval();
+//           check.expect_eq(sim->result, expected, "ADD 0x%08X", ...);
+//       });
+//   }
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <verilated.h>
+
+#if VM_TRACE
+#include <verilated_vcd_c.h>
+#endif
+
+namespace tb {
+
+struct Options {
+    uint64_t seed = 1;
+    unsigned shards = 1;
+    uint64_t vectors = 0;       // 0: the testbench's default
+    bool verbose = false;
+
+    // Parsed once, after Verilated::commandArgs()
+    static const Options& get() {
+        static const Options opts = parse();
+        return opts;
+    }
+
+    uint64_t vectors_or(uint64_t fallback) const { return vectors ? vectors : fallback; }
+
+private:
+    static Options parse() {
+        Options o;
+        o.shards = std::max(1u, std::thread::hardware_concurrency());
+        const char* arg;
+        if ((arg = Verilated::commandArgsPlusMatch("seed+"))[0]) o.seed = strtoull(arg + strlen("+seed+"), nullptr, 0);
+        if ((arg = Verilated::commandArgsPlusMatch("shards+"))[0]) o.shards = std::max(1ul, strtoul(arg + strlen("+shards+"), nullptr, 0));
+        if ((arg = Verilated::commandArgsPlusMatch("vectors+"))[0]) o.vectors = strtoull(arg + strlen("+vectors+"), nullptr, 0);
+        o.verbose = Verilated::commandArgsPlusMatch("verbose")[0] != '\0';
+        return o;
+    }
+};
+
+inline std::mutex& print_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+// Checks of one shard, and its random stream
+class Check {
+public:
+    Check(unsigned shard, uint64_t seed) : m_shard(shard), m_seed(seed), m_rng(seed) {}
+
+    // Record one check; the printf-style description identifies it in the
+    // report. Returns `ok`.
+    bool expect(bool ok, const char* fmt, ...) __attribute__((format(printf, 3, 4))) {
+        va_list ap;
+        va_start(ap, fmt);
+        record(ok, format(fmt, ap));
+        va_end(ap);
+        return ok;
+    }
+
+    // expect(actual == expected), with both values in the report
+    bool expect_eq(uint64_t actual, uint64_t expected, const char* fmt, ...) __attribute__((format(printf, 4, 5))) {
+        va_list ap;
+        va_start(ap, fmt);
+        std::string what = format(fmt, ap);
+        va_end(ap);
+        char vals[64];
+        snprintf(vals, sizeof(vals), ": got 0x%lX, expected 0x%lX", (unsigned long)actual, (unsigned long)expected);
+        record(actual == expected, what + vals);
+        return actual == expected;
+    }
+
+    uint32_t rand32() { return (uint32_t)m_rng(); }
+    uint32_t rand_below(uint32_t n) { return n ? rand32() % n : 0; }
+
+    unsigned shard() const { return m_shard; }
+    uint64_t seed() const { return m_seed; }
+    uint64_t checks() const { return m_checks; }
+    uint64_t failures() const { return m_failures; }
+    const std::vector<std::string>& messages() const { return m_messages; }
+
+private:
+    static constexpr size_t MAX_MESSAGES = 8;
+
+    static std::string format(const char* fmt, va_list ap) {
+        char buf[256];
+        vsnprintf(buf, sizeof(buf), fmt, ap);
+        return buf;
+    }
+
+    void record(bool ok, const std::string& what) {
+        m_checks++;
+        if (!ok) {
+            m_failures++;
+            if (m_messages.size() < MAX_MESSAGES) m_messages.push_back(what);
+        }
+        if (Options::get().verbose) {
+            std::lock_guard<std::mutex> lock(print_mutex());
+            printf("[%u] %s %s\n", m_shard, ok ? "✅" : "❌", what.c_str());
+        }
+    }
+
+    unsigned m_shard;
+    uint64_t m_seed;
+    std::mt19937_64 m_rng;
+    uint64_t m_checks = 0, m_failures = 0;
+    std::vector<std::string> m_messages;
+};
+
+// One model in its own context, with clock/reset helpers and an optional
+// waveform
+template <class Model>
+class Sim {
+public:
+    Sim(const std::string& name, bool trace) : m_ctx(new VerilatedContext) {
+#if VM_TRACE
+        if (trace) m_ctx->traceEverOn(true);
+#endif
+        m_dut.reset(new Model(m_ctx.get(), "TOP"));
+#if VM_TRACE
+        if (trace) {
+            m_trace.reset(new VerilatedVcdC);
+            m_dut->trace(m_trace.get(), 5);
+            m_trace->open(("VCD/" + name + "_waveform.vcd").c_str());
+        }
+#else
+        (void)name; (void)trace;
+#endif
+    }
+
+    ~Sim() {
+#if VM_TRACE
+        if (m_trace) m_trace->close();
+#endif
+        m_dut->final();
+    }
+
+    Model* operator->() { return m_dut.get(); }
+    Model* dut() { return m_dut.get(); }
+    uint64_t time() const { return m_time; }
+
+    // Settle combinational logic and dump one time step
+    void eval() {
+        m_dut->eval();
+#if VM_TRACE
+        if (m_trace) m_trace->dump(m_time);
+#endif
+        m_time++;
+    }
+
+    // One clock cycle on `clk`: low, then the rising edge
+    void tick() {
+        m_dut->clk = 0;
+        eval();
+        m_dut->clk = 1;
+        eval();
+    }
+
+    // Hold the active-low `rst` for `cycles` clocks
+    void reset(unsigned cycles = 1) {
+        m_dut->rst = 0;
+        for (unsigned i = 0; i < cycles; i++) tick();
+        m_dut->rst = 1;
+    }
+
+private:
+    std::unique_ptr<VerilatedContext> m_ctx;
+    std::unique_ptr<Model> m_dut;
+#if VM_TRACE
+    std::unique_ptr<VerilatedVcdC> m_trace;
+#endif
+    uint64_t m_time = 0;
+};
+
+// Run `body(sim, check)` once per shard, each on its own thread with a
+// fresh model, then print the summary line. `shards` = 0 takes +shards;
+// directed-only testbenches pass 1. Returns main()'s exit status.
+template <class Model, class Body>
+int run(const char* name, Body body, unsigned shards = 0) {
+    const Options& opts = Options::get();
+    if (shards == 0) shards = opts.shards;
+
+    std::vector<std::unique_ptr<Check>> checks;
+    for (unsigned i = 0; i < shards; i++) checks.emplace_back(new Check(i, opts.seed + i));
+
+    auto start = std::chrono::steady_clock::now();
+    auto shard = [&](unsigned i) {
+        Sim<Model> sim(name, i == 0);
+        body(sim, *checks[i]);
+    };
+    if (shards == 1) {
+        shard(0);
+    } else {
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < shards; i++) threads.emplace_back(shard, i);
+        for (auto& t : threads) t.join();
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t total = 0, failed = 0;
+    for (auto& c : checks) {
+        total += c->checks();
+        failed += c->failures();
+    }
+
+    char seeds[64];
+    if (shards == 1) snprintf(seeds, sizeof(seeds), "seed %lu", (unsigned long)opts.seed);
+    else snprintf(seeds, sizeof(seeds), "%u shards, seeds %lu-%lu", shards,
+                  (unsigned long)opts.seed, (unsigned long)(opts.seed + shards - 1));
+
+    if (failed == 0 && total > 0) {
+        printf("✅ %s: all %lu checks passed (%s, %.3f s)\n", name, (unsigned long)total, seeds, secs);
+        return 0;
+    }
+    printf("❌ %s: %lu of %lu checks failed (%s, %.3f s)\n", name, (unsigned long)failed, (unsigned long)total, seeds, secs);
+    for (auto& c : checks)
+        for (auto& msg : c->messages())
+            printf("   seed %lu: %s\n", (unsigned long)c->seed(), msg.c_str());
+    return 1;
+}
+
+}  // namespace tb
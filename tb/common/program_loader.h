@@ -0,0 +1,236 @@
+// Program loading for the Verilator testbenches: RV32 ELF files and flat
+// binaries are mmap'd and copied straight into the InstrMem/DataMem byte
+// arrays, with no $readmemh text in between.
+//
+//   +elf+<path>         PT_LOAD segments by address: executable ones into
+//                       InstrMem, the rest (and their .bss) into DataMem
+//   +bin+<path>         flat binary into InstrMem at 0
+//   +dbin+<path>        flat binary into DataMem at 0
+//   +dmem_base+<addr>   address of DataMem[0] in the ELF (default 0)
+//
+// load_memh() takes a $readmemh image instead, for testbenches that switch
+// src/*.mem programs at run time rather than rebuilding with IMEM_INIT.
+//
+// The arrays are reached through their public names (InstrMem and DataMem
+// declare `mem` public_flat_rw), so loading is a memcpy. DataMemSparse is
+// loaded through its SparseMem instead (sparse_mem_port). Load after the
+// first eval(): the memories' initial blocks would overwrite it otherwise.
+// Both arrays are 32-bit words, which a little-endian host sees as the
+// program's bytes in order. InstrMem's $readmemh images list each word MSB
+// first unless it is built with LITTLE_ENDIAN=1 (COMPRESSED=1), so
+// load_memh() byte-swaps them; MemPort::big_endian says so.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <verilated.h>
+#include <verilated_syms.h>
+
+#include "sparse_mem.h"
+
+#ifndef EM_RISCV
+#define EM_RISCV 243
+#endif
+
+// A byte-addressed memory to load into: an array, or a SparseMem
+struct MemPort {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    bool big_endian = false;    // $readmemh images list each word MSB first (InstrMem)
+    SparseMem* sparse = nullptr;
+
+    // Copy little-endian program bytes to address `addr`. False if they do
+    // not fit.
+    bool write(uint32_t addr, const uint8_t* src, size_t len) const {
+        if ((!data && !sparse) || addr > size || len > size - addr) return false;
+        if (sparse) sparse->write_block(addr, src, len);
+        else memcpy(data + addr, src, len);
+        return true;
+    }
+
+    bool fill(uint32_t addr, uint8_t value, size_t len) const {
+        if ((!data && !sparse) || addr > size || len > size - addr) return false;
+        if (sparse) sparse->fill(addr, value, len);
+        else memset(data + addr, value, len);
+        return true;
+    }
+
+    void clear() const {
+        if (sparse) sparse->clear();
+        else if (data) memset(data, 0, size);
+    }
+};
+
+// The `mem` array of a Verilated InstrMem/DataMem instance, by scope name,
+// e.g. "TOP.RV32I_Core.u_instrMem". `context` is the model's, when it is
+// not this thread's.
+inline MemPort verilated_mem(const char* scope, bool big_endian, VerilatedContext* context = nullptr) {
+    MemPort port;
+    const VerilatedScope* s = (context ? context : Verilated::threadContextp())->scopeFind(scope);
+    VerilatedVar* var = s ? s->varFind("mem") : nullptr;
+    if (var) {
+        port.data = static_cast<uint8_t*>(var->datap());
+        port.size = var->totalSize();
+        port.big_endian = big_endian;
+    } else {
+        printf("❌ No public memory in scope %s\n", scope);
+    }
+    return port;
+}
+
+// DataMemSparse's storage (MEM_ID `id`): the whole 32-bit space
+inline MemPort sparse_mem_port(int id) {
+    MemPort port;
+    port.size = (size_t)1 << 32;
+    port.sparse = &SparseMem::instance(id);
+    return port;
+}
+
+class ProgramLoader {
+public:
+    ~ProgramLoader() { unmap(); }
+
+    bool verbose = true;        // print a line per image loaded; errors always print
+
+    static bool requested() {
+        return Verilated::commandArgsPlusMatch("elf+")[0] || Verilated::commandArgsPlusMatch("bin+")[0] ||
+               Verilated::commandArgsPlusMatch("dbin+")[0];
+    }
+
+    // Load whatever the plusargs ask for. A loaded memory is cleared first,
+    // so nothing of its $readmemh image is left over.
+    bool load_plusargs(const MemPort& imem, const MemPort& dmem) {
+        const char* elf = Verilated::commandArgsPlusMatch("elf+");
+        const char* bin = Verilated::commandArgsPlusMatch("bin+");
+        const char* dbin = Verilated::commandArgsPlusMatch("dbin+");
+        const char* base = Verilated::commandArgsPlusMatch("dmem_base+");
+        uint32_t dmem_base = base[0] ? strtoul(base + strlen("+dmem_base+"), nullptr, 0) : 0;
+
+        if (elf[0] || bin[0]) imem.clear();
+        if (elf[0] || dbin[0]) dmem.clear();
+
+        bool ok = true;
+        if (elf[0]) ok = ok && load_elf(elf + strlen("+elf+"), imem, dmem, dmem_base);
+        if (bin[0]) ok = ok && load_bin(bin + strlen("+bin+"), imem);
+        if (dbin[0]) ok = ok && load_bin(dbin + strlen("+dbin+"), dmem);
+        return ok;
+    }
+
+    bool load_elf(const std::string& path, const MemPort& imem, const MemPort& dmem, uint32_t dmem_base = 0) {
+        auto start = std::chrono::steady_clock::now();
+        if (!map(path)) return false;
+
+        const Elf32_Ehdr* eh = reinterpret_cast<const Elf32_Ehdr*>(m_data);
+        if (m_size < sizeof(Elf32_Ehdr) || memcmp(eh->e_ident, ELFMAG, SELFMAG) != 0)
+            return error(path, "not an ELF file");
+        if (eh->e_ident[EI_CLASS] != ELFCLASS32 || eh->e_ident[EI_DATA] != ELFDATA2LSB)
+            return error(path, "not a 32-bit little-endian ELF");
+        if (eh->e_machine != EM_RISCV)
+            return error(path, "not a RISC-V ELF");
+        if (eh->e_phoff + (uint64_t)eh->e_phnum * sizeof(Elf32_Phdr) > m_size)
+            return error(path, "truncated program headers");
+        if (eh->e_entry != 0)
+            printf("⚠️  %s: entry point 0x%08X, but the core starts at 0\n", path.c_str(), eh->e_entry);
+
+        size_t text = 0, data = 0;
+        const Elf32_Phdr* ph = reinterpret_cast<const Elf32_Phdr*>(m_data + eh->e_phoff);
+        for (unsigned i = 0; i < eh->e_phnum; i++) {
+            if (ph[i].p_type != PT_LOAD || ph[i].p_memsz == 0) continue;
+            if ((uint64_t)ph[i].p_offset + ph[i].p_filesz > m_size)
+                return error(path, "segment runs past the end of the file");
+
+            bool exec = ph[i].p_flags & PF_X;
+            const MemPort& mem = exec ? imem : dmem;
+            uint32_t addr = exec ? ph[i].p_vaddr : ph[i].p_vaddr - dmem_base;
+            if (!mem.write(addr, m_data + ph[i].p_offset, ph[i].p_filesz) ||
+                !mem.fill(addr + ph[i].p_filesz, 0, ph[i].p_memsz - ph[i].p_filesz)) {
+                char msg[96];
+                snprintf(msg, sizeof(msg), "segment at 0x%08X (%u bytes) does not fit %s",
+                         ph[i].p_vaddr, ph[i].p_memsz, exec ? "InstrMem" : "DataMem");
+                return error(path, msg);
+            }
+            (exec ? text : data) += ph[i].p_memsz;
+        }
+        unmap();
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (verbose) printf("📦 %s: %zu bytes code, %zu bytes data in %.2f ms\n", path.c_str(), text, data, ms);
+        return true;
+    }
+
+    // A $readmemh image (src/*.mem), byte for byte: swapped within each
+    // word when the image lists words MSB first.
+    bool load_memh(const std::string& path, const MemPort& mem) {
+        auto start = std::chrono::steady_clock::now();
+        size_t bytes = 0;
+        bool fits = true;
+        mem.clear();
+        bool read = readmemh(path, [&](size_t addr, uint8_t v) {
+            if (mem.sparse && addr < mem.size) mem.sparse->write_byte((uint32_t)addr, v);
+            else if (mem.data && addr < mem.size) mem.data[mem.big_endian ? addr ^ 3 : addr] = v;
+            else fits = false;
+            bytes++;
+        });
+        if (!read) return error(path, "cannot open");
+        if (!fits) return error(path, "does not fit the memory");
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (verbose) printf("📦 %s: %zu bytes in %.2f ms\n", path.c_str(), bytes, ms);
+        return true;
+    }
+
+    bool load_bin(const std::string& path, const MemPort& mem, uint32_t addr = 0) {
+        auto start = std::chrono::steady_clock::now();
+        if (!map(path)) return false;
+        if (!mem.write(addr, m_data, m_size))
+            return error(path, "does not fit the memory");
+        size_t size = m_size;
+        unmap();
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (verbose) printf("📦 %s: %zu bytes in %.2f ms\n", path.c_str(), size, ms);
+        return true;
+    }
+
+private:
+    bool map(const std::string& path) {
+        unmap();
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return error(path, "cannot open");
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            return error(path, "empty or unreadable");
+        }
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return error(path, "mmap failed");
+        m_data = static_cast<const uint8_t*>(p);
+        m_size = st.st_size;
+        return true;
+    }
+
+    void unmap() {
+        if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool error(const std::string& path, const char* what) {
+        printf("❌ %s: %s\n", path.c_str(), what);
+        unmap();
+        return false;
+    }
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
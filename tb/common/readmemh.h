@@ -0,0 +1,44 @@
+// $readmemh for C++-side memories: the byte-per-entry hex images in src/
+// (whitespace-separated bytes, // and /* */ comments, @addr jumps).
+// `write(addr, byte)` is called for every entry; it does its own bounds
+// checks.
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+template <class Write>
+bool readmemh(const std::string& path, Write&& write) {
+    FILE* fp = fopen(path.c_str(), "r");
+    if (!fp) return false;
+
+    size_t addr = 0;
+    std::string tok;
+    auto flush = [&]() {
+        if (tok.empty()) return;
+        if (tok[0] == '@') addr = strtoul(tok.c_str() + 1, nullptr, 16);
+        else write(addr++, (uint8_t)strtoul(tok.c_str(), nullptr, 16));
+        tok.clear();
+    };
+
+    int c;
+    while ((c = fgetc(fp)) != EOF) {
+        if (c == '/' && tok.empty()) {
+            c = fgetc(fp);
+            if (c == '/') {
+                while ((c = fgetc(fp)) != EOF && c != '\n') {}
+            } else if (c == '*') {
+                for (int p = 0; (c = fgetc(fp)) != EOF && !(p == '*' && c == '/'); p = c) {}
+            }
+            continue;
+        }
+        if (isspace(c)) flush();
+        else tok += (char)c;
+    }
+    flush();
+    fclose(fp);
+    return true;
+}
@@ -0,0 +1,529 @@
+// Instruction-set simulator for RV32I_Core programs: a reference model for
+// lockstep co-simulation, and a fast way to run an image without the RTL.
+//
+// Decode follows Controller.sv and ImmGen.sv rather than just the spec, so
+// the encodings the core treats specially agree:
+//   - branches with func3 010/011 fall through; FENCE is a NOP
+//   - loads/stores with func3 011/110/111 are word accesses
+//   - an R-type or shift-immediate func7 that is not RV32M, Zba, Zbb or
+//     Zbs keeps the base operation; a Zbb unary op (clz, rev8, ...) or
+//     zext.h with another rs2 field is illegal
+//   - ECALL/EBREAK (rs1 = rd = x0) retire and end the run with a0 as the
+//     exit code; other SYSTEM encodings and unknown opcodes are illegal
+//     and stop it
+//   - with set_tohost(addr), a store of (code << 1) | 1 to addr ends the
+//     run the same way (the core's TOHOST parameter)
+//   - InstrMem and DataMem read 0xDEADBEEF past their end
+//   - a misaligned DataMem access reads/writes the bytes at its address;
+//     bytes past the end read 0 and are not written
+// RV32M and Zba/Zbb/Zbs are included. RV32C is not (use a COMPRESSED=0 build).
+//
+// CSR reads depend on cycle counts the ISS does not model. They retire with
+// Commit::csr set and rd = 0; a co-simulation copies the RTL's value into
+// the register with set_reg().
+//
+// Decoded instructions are cached per InstrMem word. The core cannot write
+// InstrMem, so the cache never goes stale; load_imem() clears it. With
+// GCC/Clang every cache entry holds its handler's address (computed goto),
+// so dispatch is one indirect jump. Other compilers use a switch.
+//
+//   Rv32Iss iss(IMEM_WORDS, DMEM_WORDS);
+//   iss.load_imem("./src/RV32I_TestProg.mem");
+//   Rv32Iss::Commit c;
+//   while (iss.step(c)) { ... }     // one instruction and its effects
+//   iss.run(n);                     // up to n instructions, no record
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "readmemh.h"
+
+#if defined(__GNUC__) && !defined(RV32_ISS_SWITCH)
+#define RV32_ISS_THREADED 1
+#else
+#define RV32_ISS_THREADED 0
+#endif
+
+#define RV32_ISS_OPS(X) \
+    X(DECODE) X(ILLEGAL) X(NOP) X(CSR) X(EXIT) \
+    X(LUI) X(AUIPC) X(JAL) X(JALR) \
+    X(BEQ) X(BNE) X(BLT) X(BGE) X(BLTU) X(BGEU) \
+    X(LB) X(LH) X(LW) X(LBU) X(LHU) X(SB) X(SH) X(SW) \
+    X(ADDI) X(SLTI) X(SLTIU) X(XORI) X(ORI) X(ANDI) X(SLLI) X(SRLI) X(SRAI) \
+    X(ADD) X(SUB) X(SLL) X(SLT) X(SLTU) X(XOR) X(SRL) X(SRA) X(OR) X(AND) \
+    X(MUL) X(MULH) X(MULHSU) X(MULHU) X(DIV) X(DIVU) X(REM) X(REMU) \
+    X(SH1ADD) X(SH2ADD) X(SH3ADD) X(ANDN) X(ORN) X(XNOR) \
+    X(CLZ) X(CTZ) X(CPOP) X(MIN) X(MAX) X(MINU) X(MAXU) \
+    X(SEXTB) X(SEXTH) X(ZEXTH) X(REV8) X(ORCB) X(ROL) X(ROR) X(RORI) \
+    X(BCLR) X(BSET) X(BINV) X(BEXT) X(BCLRI) X(BSETI) X(BINVI) X(BEXTI)
+
+class Rv32Iss {
+public:
+    // Architectural effects of one retired instruction
+    struct Commit {
+        uint32_t pc = 0, instr = 0, next_pc = 0;
+        uint8_t  rd = 0;            // register written, 0 if none
+        uint32_t rd_data = 0;
+        bool     mem_wen = false;
+        uint32_t mem_addr = 0;
+        uint32_t mem_data = 0;      // masked to mem_bytes
+        uint8_t  mem_bytes = 0;
+        bool     csr = false;       // rd_data not modelled
+    };
+
+    Rv32Iss(uint32_t imem_words = 128, uint32_t dmem_words = 128, bool imem_little_endian = false)
+        : m_imem(imem_words * 4, 0), m_dmem(dmem_words * 4, 0),
+          m_imem_le(imem_little_endian), m_cache(imem_words) {
+        reset();
+    }
+
+    // $readmemh images, as the cores' IMEM_INIT / DMEM_INIT. InstrMem
+    // images list each word MSB first unless little-endian.
+    bool load_imem(const std::string& path) {
+        invalidate();
+        return readmemh(path, [this](size_t addr, uint8_t v) {
+            if (addr < m_imem.size()) m_imem[m_imem_le ? addr : addr ^ 3] = v;
+        });
+    }
+    bool load_dmem(const std::string& path) {
+        return readmemh(path, [this](size_t addr, uint8_t v) { if (addr < m_dmem.size()) m_dmem[addr] = v; });
+    }
+
+    // Backdoor access for program loaders (laid out like InstrMem/DataMem:
+    // little-endian words). Call invalidate() after writing InstrMem.
+    uint8_t* imem_data() { return m_imem.data(); }
+    size_t imem_size() const { return m_imem.size(); }
+    bool imem_big_endian() const { return !m_imem_le; }
+    uint8_t* dmem_data() { return m_dmem.data(); }
+    size_t dmem_size() const { return m_dmem.size(); }
+
+    void invalidate() {
+        m_stale = true;
+        for (auto& d : m_cache) d.op = OP_DECODE;
+    }
+
+    // Like the core's rst: registers and PC clear, memories keep their data
+    void reset() {
+        memset(m_x, 0, sizeof(m_x));
+        m_pc = 0;
+        m_halted = false;
+        m_exited = false;
+        m_exit_code = 0;
+    }
+
+    // Enable the tohost exit word at this DataMem address
+    void set_tohost(uint32_t addr) {
+        m_tohost_en = true;
+        m_tohost = addr;
+    }
+
+    // Run up to `max` instructions; stops early at an illegal instruction
+    // or a program exit. Returns the number retired.
+    uint64_t run(uint64_t max) { return execute(max, nullptr); }
+
+    // Run one instruction. False (and no commit) if it is illegal.
+    bool step(Commit& c) {
+        c = Commit();
+        return execute(1, &c) == 1;
+    }
+
+    uint32_t pc() const { return m_pc; }
+    uint32_t reg(unsigned i) const { return m_x[i & 31]; }
+    void set_reg(unsigned i, uint32_t value) { if (i & 31) m_x[i & 31] = value; }
+    bool halted() const { return m_halted; }
+    bool exited() const { return m_exited; }            // halted by ECALL/EBREAK/tohost
+    uint32_t exit_code() const { return m_exit_code; }
+    uint64_t instret() const { return m_instret; }
+
+    // InstrMem's read port: the aligned word
+    uint32_t fetch(uint32_t addr) const {
+        if (addr >= m_imem.size()) return 0xDEADBEEF;
+        const uint8_t* b = &m_imem[addr & ~3u];
+        return (uint32_t)b[3] << 24 | b[2] << 16 | b[1] << 8 | b[0];
+    }
+
+    // Bytes written by a store with this func3 (DataMem's byte_mask)
+    static uint8_t store_bytes(uint32_t func3) {
+        static const uint8_t bytes[8] = {1, 2, 4, 4, 1, 2, 4, 4};
+        return bytes[func3 & 7];
+    }
+
+private:
+    enum Op : uint8_t {
+#define RV32_ISS_ENUM(name) OP_##name,
+        RV32_ISS_OPS(RV32_ISS_ENUM)
+#undef RV32_ISS_ENUM
+    };
+
+    struct Decoded {
+        const void* handler = nullptr;
+        uint8_t  op = OP_DECODE;
+        uint8_t  rd = 0, rs1 = 0, rs2 = 0;
+        uint32_t imm = 0;
+        uint32_t instr = 0;
+    };
+
+    // ImmGen
+    static uint32_t immediate(uint32_t instr) {
+        int32_t s = (int32_t)instr;
+        switch ((instr >> 2) & 0x1F) {
+            case 0b00100:   // I-type, shifts take shamt
+                if (((instr >> 12) & 3) == 1) return (instr >> 20) & 0x1F;
+                return (uint32_t)(s >> 20);
+            case 0b11001: case 0b00000:     // JALR, loads
+                return (uint32_t)(s >> 20);
+            case 0b11000:   // B-type
+                return (uint32_t)(s >> 31 << 12) | ((instr << 4) & 0x800) |
+                       ((instr >> 20) & 0x7E0) | ((instr >> 7) & 0x1E);
+            case 0b11011:   // JAL
+                return (uint32_t)(s >> 31 << 20) | (instr & 0xFF000) |
+                       ((instr >> 9) & 0x800) | ((instr >> 20) & 0x7FE);
+            case 0b01000:   // S-type
+                return (uint32_t)(s >> 25 << 5) | ((instr >> 7) & 0x1F);
+            case 0b01101: case 0b00101:     // LUI, AUIPC
+                return instr & 0xFFFFF000;
+            default:
+                return 0;
+        }
+    }
+
+    // Controller
+    static void predecode(Decoded& d, uint32_t instr) {
+        static const uint8_t op_imm[8]   = {OP_ADDI, OP_SLLI, OP_SLTI, OP_SLTIU, OP_XORI, OP_SRLI, OP_ORI, OP_ANDI};
+        static const uint8_t op_reg[8]   = {OP_ADD, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_OR, OP_AND};
+        static const uint8_t op_br[8]    = {OP_BEQ, OP_BNE, OP_NOP, OP_NOP, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU};
+        static const uint8_t op_load[8]  = {OP_LB, OP_LH, OP_LW, OP_LW, OP_LBU, OP_LHU, OP_LW, OP_LW};
+        static const uint8_t op_store[8] = {OP_SB, OP_SH, OP_SW, OP_SW, OP_SB, OP_SH, OP_SW, OP_SW};
+
+        uint32_t func3 = (instr >> 12) & 7, func7 = instr >> 25;
+        d.instr = instr;
+        d.rd    = (instr >> 7) & 0x1F;
+        d.rs1   = (instr >> 15) & 0x1F;
+        d.rs2   = (instr >> 20) & 0x1F;
+        d.imm   = immediate(instr);
+
+        switch (instr & 0x7F) {
+            case 0x13:
+                d.op = op_imm[func3];
+                if (func3 == 5 && func7 == 0x20) d.op = OP_SRAI;
+                else d.op = decode_zb(false, func3, func7, d.rs2, d.op);
+                break;
+            case 0x33:
+                d.op = op_reg[func3];
+                if (func7 == 0x01) d.op = OP_MUL + func3;
+                else if (func7 == 0x20 && func3 == 0) d.op = OP_SUB;
+                else if (func7 == 0x20 && func3 == 5) d.op = OP_SRA;
+                else d.op = decode_zb(true, func3, func7, d.rs2, d.op);
+                break;
+            case 0x63: d.op = op_br[func3]; break;
+            case 0x03: d.op = op_load[func3]; break;
+            case 0x23: d.op = op_store[func3]; break;
+            case 0x6F: d.op = OP_JAL; break;
+            case 0x67: d.op = OP_JALR; break;
+            case 0x37: d.op = OP_LUI; break;
+            case 0x17: d.op = OP_AUIPC; break;
+            case 0x73:
+                if (func3 == 0) d.op = func7 == 0 && d.rs2 <= 1 && d.rs1 == 0 && d.rd == 0 ? OP_EXIT : OP_ILLEGAL;
+                else d.op = func3 == 4 ? OP_ILLEGAL : OP_CSR;
+                break;
+            case 0x0F: d.op = OP_NOP; break;
+            default:   d.op = OP_ILLEGAL; break;
+        }
+    }
+
+    // Zba/Zbb/Zbs on OP (reg) or OP-IMM, as Controller; `base` otherwise
+    static uint8_t decode_zb(bool reg, uint32_t func3, uint32_t func7, uint32_t rs2, uint8_t base) {
+        switch (reg << 10 | func7 << 3 | func3) {
+            case 1 << 10 | 0x10 << 3 | 2: return OP_SH1ADD;
+            case 1 << 10 | 0x10 << 3 | 4: return OP_SH2ADD;
+            case 1 << 10 | 0x10 << 3 | 6: return OP_SH3ADD;
+            case 1 << 10 | 0x20 << 3 | 7: return OP_ANDN;
+            case 1 << 10 | 0x20 << 3 | 6: return OP_ORN;
+            case 1 << 10 | 0x20 << 3 | 4: return OP_XNOR;
+            case 1 << 10 | 0x05 << 3 | 4: return OP_MIN;
+            case 1 << 10 | 0x05 << 3 | 5: return OP_MINU;
+            case 1 << 10 | 0x05 << 3 | 6: return OP_MAX;
+            case 1 << 10 | 0x05 << 3 | 7: return OP_MAXU;
+            case 1 << 10 | 0x04 << 3 | 4: return rs2 == 0 ? OP_ZEXTH : OP_ILLEGAL;
+            case 1 << 10 | 0x30 << 3 | 1: return OP_ROL;
+            case 1 << 10 | 0x30 << 3 | 5: return OP_ROR;
+            case 1 << 10 | 0x24 << 3 | 1: return OP_BCLR;
+            case 1 << 10 | 0x24 << 3 | 5: return OP_BEXT;
+            case 1 << 10 | 0x34 << 3 | 1: return OP_BINV;
+            case 1 << 10 | 0x14 << 3 | 1: return OP_BSET;
+            case 0x30 << 3 | 1:
+                switch (rs2) {
+                    case 0: return OP_CLZ;
+                    case 1: return OP_CTZ;
+                    case 2: return OP_CPOP;
+                    case 4: return OP_SEXTB;
+                    case 5: return OP_SEXTH;
+                    default: return OP_ILLEGAL;
+                }
+            case 0x24 << 3 | 1: return OP_BCLRI;
+            case 0x34 << 3 | 1: return OP_BINVI;
+            case 0x14 << 3 | 1: return OP_BSETI;
+            case 0x30 << 3 | 5: return OP_RORI;
+            case 0x24 << 3 | 5: return OP_BEXTI;
+            case 0x34 << 3 | 5: return rs2 == 0x18 ? OP_REV8 : OP_ILLEGAL;
+            case 0x14 << 3 | 5: return rs2 == 0x07 ? OP_ORCB : OP_ILLEGAL;
+            default: return base;
+        }
+    }
+
+    static uint32_t rotl(uint32_t a, uint32_t s) { s &= 31; return s ? a << s | a >> (32 - s) : a; }
+    static uint32_t rotr(uint32_t a, uint32_t s) { s &= 31; return s ? a >> s | a << (32 - s) : a; }
+    static uint32_t clz(uint32_t a) { uint32_t n = 0; while (n < 32 && !(a & 0x80000000u >> n)) n++; return n; }
+    static uint32_t ctz(uint32_t a) { uint32_t n = 0; while (n < 32 && !(a >> n & 1)) n++; return n; }
+    static uint32_t cpop(uint32_t a) { uint32_t n = 0; for (; a; a &= a - 1) n++; return n; }
+    static uint32_t orc_b(uint32_t a) {
+        uint32_t r = 0;
+        for (unsigned i = 0; i < 32; i += 8) if (a >> i & 0xFF) r |= 0xFFu << i;
+        return r;
+    }
+
+    // DataMem's ports. Bytes past the end of the array read as 0 and are
+    // not written, as in DataMem.
+    uint32_t byte_at(uint32_t addr) const { return addr < m_dmem.size() ? m_dmem[addr] : 0; }
+
+    uint32_t load(uint32_t addr, uint8_t bytes, bool sign) const {
+        if (addr >= m_dmem.size()) return 0xDEADBEEF;
+        uint32_t v = 0;
+        for (unsigned i = 0; i < bytes; i++) v |= byte_at(addr + i) << (8 * i);
+        if (sign && bytes < 4) v = (uint32_t)((int32_t)(v << (32 - 8 * bytes)) >> (32 - 8 * bytes));
+        return v;
+    }
+
+    void store(uint32_t addr, uint32_t data, uint8_t bytes, Commit* log) {
+        if (bytes < 4) data &= (1u << (8 * bytes)) - 1;
+        if (addr < m_dmem.size())
+            for (unsigned i = 0; i < bytes; i++)
+                if (addr + i < m_dmem.size()) m_dmem[addr + i] = (uint8_t)(data >> (8 * i));
+        if (log) {
+            log->mem_wen   = true;
+            log->mem_addr  = addr;
+            log->mem_data  = data;
+            log->mem_bytes = bytes;
+        }
+    }
+
+    static uint32_t divide(uint32_t a, uint32_t b, bool is_signed, bool rem) {
+        if (b == 0) return rem ? a : 0xFFFFFFFF;
+        if (is_signed) {
+            if (a == 0x80000000 && b == 0xFFFFFFFF) return rem ? 0 : 0x80000000;
+            return rem ? (uint32_t)((int32_t)a % (int32_t)b) : (uint32_t)((int32_t)a / (int32_t)b);
+        }
+        return rem ? a % b : a / b;
+    }
+
+    uint64_t execute(uint64_t max, Commit* log) {
+#if RV32_ISS_THREADED
+#define RV32_ISS_LABEL(name) &&L_##name,
+        static const void* const labels[] = { RV32_ISS_OPS(RV32_ISS_LABEL) };
+#undef RV32_ISS_LABEL
+        if (m_stale) {
+            for (auto& d : m_cache) d.handler = labels[d.op];
+            m_stale = false;
+        }
+#define ISS_OP(name) L_##name:
+#define ISS_DISPATCH() goto *d->handler
+#define ISS_SET_OP(entry, o) ((entry)->op = (o), (entry)->handler = labels[(o)])
+#else
+#define ISS_OP(name) case OP_##name:
+#define ISS_DISPATCH() goto dispatch
+#define ISS_SET_OP(entry, o) ((entry)->op = (o))
+#endif
+        // Register write (x0 stays 0) and retirement
+#define ISS_WB(value) do { uint32_t v_ = (value); \
+            if (d->rd) x[d->rd] = v_; \
+            if (log) { log->rd = d->rd; log->rd_data = v_; } } while (0)
+#define ISS_RETIRE(target) do { uint32_t t_ = (target); \
+            if (log) { log->instr = d->instr; log->next_pc = t_; } \
+            pc = t_; n++; goto next; } while (0)
+        // Retire, then stop with an exit code
+#define ISS_RETIRE_EXIT(code) do { \
+            if (log) { log->instr = d->instr; log->next_pc = pc + 4; } \
+            m_exited = m_halted = true; m_exit_code = (code); \
+            pc += 4; n++; goto done; } while (0)
+#define ISS_STORE(name, bytes) ISS_OP(name) { \
+            uint32_t a_ = x[d->rs1] + d->imm, v_ = x[d->rs2]; \
+            store(a_, v_, bytes, log); \
+            if (m_tohost_en && a_ == m_tohost && (v_ & 1)) ISS_RETIRE_EXIT(v_ >> 1); \
+            ISS_RETIRE(pc + 4); }
+#define ISS_ALU(name, expr) ISS_OP(name) ISS_WB(expr); ISS_RETIRE(pc + 4);
+#define ISS_BRANCH(name, cond) ISS_OP(name) ISS_RETIRE((cond) ? pc + d->imm : pc + 4);
+
+        uint32_t* x = m_x;
+        Decoded* cache = m_cache.data();
+        const uint32_t words = (uint32_t)m_cache.size();
+        uint32_t pc = m_pc;
+        uint64_t n = 0;
+        Decoded slow, *d;
+
+        if (m_halted) return 0;
+
+    next:
+        if (n == max) goto done;
+        if ((pc & 3) == 0 && (pc >> 2) < words) {
+            d = &cache[pc >> 2];
+        } else {
+            // Misaligned or past InstrMem: decode every time
+            d = &slow;
+            ISS_SET_OP(d, OP_DECODE);
+        }
+        if (log) log->pc = pc;
+
+#if RV32_ISS_THREADED
+        ISS_DISPATCH();
+#else
+    dispatch:
+        switch (d->op) {
+#endif
+        ISS_OP(DECODE)
+            predecode(*d, fetch(pc));
+            ISS_SET_OP(d, d->op);
+            ISS_DISPATCH();
+
+        ISS_OP(ILLEGAL)
+            m_halted = true;
+            goto done;
+
+        ISS_OP(EXIT)
+            ISS_RETIRE_EXIT(x[10]);
+
+        ISS_OP(NOP)
+            ISS_RETIRE(pc + 4);
+
+        ISS_OP(CSR)
+            if (log) log->csr = true;
+            ISS_WB(0);
+            ISS_RETIRE(pc + 4);
+
+        ISS_ALU(LUI, d->imm)
+        ISS_ALU(AUIPC, pc + d->imm)
+
+        ISS_OP(JAL)
+            ISS_WB(pc + 4);
+            ISS_RETIRE(pc + d->imm);
+
+        ISS_OP(JALR) {
+            uint32_t target = (x[d->rs1] + d->imm) & ~1u;
+            ISS_WB(pc + 4);
+            ISS_RETIRE(target);
+        }
+
+        ISS_BRANCH(BEQ,  x[d->rs1] == x[d->rs2])
+        ISS_BRANCH(BNE,  x[d->rs1] != x[d->rs2])
+        ISS_BRANCH(BLT,  (int32_t)x[d->rs1] <  (int32_t)x[d->rs2])
+        ISS_BRANCH(BGE,  (int32_t)x[d->rs1] >= (int32_t)x[d->rs2])
+        ISS_BRANCH(BLTU, x[d->rs1] <  x[d->rs2])
+        ISS_BRANCH(BGEU, x[d->rs1] >= x[d->rs2])
+
+        ISS_ALU(LB,  load(x[d->rs1] + d->imm, 1, true))
+        ISS_ALU(LH,  load(x[d->rs1] + d->imm, 2, true))
+        ISS_ALU(LW,  load(x[d->rs1] + d->imm, 4, false))
+        ISS_ALU(LBU, load(x[d->rs1] + d->imm, 1, false))
+        ISS_ALU(LHU, load(x[d->rs1] + d->imm, 2, false))
+
+        ISS_STORE(SB, 1)
+        ISS_STORE(SH, 2)
+        ISS_STORE(SW, 4)
+
+        ISS_ALU(ADDI,  x[d->rs1] + d->imm)
+        ISS_ALU(SLTI,  (int32_t)x[d->rs1] < (int32_t)d->imm)
+        ISS_ALU(SLTIU, x[d->rs1] < d->imm)
+        ISS_ALU(XORI,  x[d->rs1] ^ d->imm)
+        ISS_ALU(ORI,   x[d->rs1] | d->imm)
+        ISS_ALU(ANDI,  x[d->rs1] & d->imm)
+        ISS_ALU(SLLI,  x[d->rs1] << (d->imm & 31))
+        ISS_ALU(SRLI,  x[d->rs1] >> (d->imm & 31))
+        ISS_ALU(SRAI,  (uint32_t)((int32_t)x[d->rs1] >> (d->imm & 31)))
+
+        ISS_ALU(ADD,  x[d->rs1] + x[d->rs2])
+        ISS_ALU(SUB,  x[d->rs1] - x[d->rs2])
+        ISS_ALU(SLL,  x[d->rs1] << (x[d->rs2] & 31))
+        ISS_ALU(SLT,  (int32_t)x[d->rs1] < (int32_t)x[d->rs2])
+        ISS_ALU(SLTU, x[d->rs1] < x[d->rs2])
+        ISS_ALU(XOR,  x[d->rs1] ^ x[d->rs2])
+        ISS_ALU(SRL,  x[d->rs1] >> (x[d->rs2] & 31))
+        ISS_ALU(SRA,  (uint32_t)((int32_t)x[d->rs1] >> (x[d->rs2] & 31)))
+        ISS_ALU(OR,   x[d->rs1] | x[d->rs2])
+        ISS_ALU(AND,  x[d->rs1] & x[d->rs2])
+
+        ISS_ALU(MUL,    x[d->rs1] * x[d->rs2])
+        ISS_ALU(MULH,   (uint32_t)((uint64_t)((int64_t)(int32_t)x[d->rs1] * (int32_t)x[d->rs2]) >> 32))
+        ISS_ALU(MULHSU, (uint32_t)((uint64_t)((int64_t)(int32_t)x[d->rs1] * (int64_t)x[d->rs2]) >> 32))
+        ISS_ALU(MULHU,  (uint32_t)(((uint64_t)x[d->rs1] * x[d->rs2]) >> 32))
+        ISS_ALU(DIV,    divide(x[d->rs1], x[d->rs2], true, false))
+        ISS_ALU(DIVU,   divide(x[d->rs1], x[d->rs2], false, false))
+        ISS_ALU(REM,    divide(x[d->rs1], x[d->rs2], true, true))
+        ISS_ALU(REMU,   divide(x[d->rs1], x[d->rs2], false, true))
+
+        ISS_ALU(SH1ADD, (x[d->rs1] << 1) + x[d->rs2])
+        ISS_ALU(SH2ADD, (x[d->rs1] << 2) + x[d->rs2])
+        ISS_ALU(SH3ADD, (x[d->rs1] << 3) + x[d->rs2])
+        ISS_ALU(ANDN,   x[d->rs1] & ~x[d->rs2])
+        ISS_ALU(ORN,    x[d->rs1] | ~x[d->rs2])
+        ISS_ALU(XNOR,   ~(x[d->rs1] ^ x[d->rs2]))
+        ISS_ALU(CLZ,    clz(x[d->rs1]))
+        ISS_ALU(CTZ,    ctz(x[d->rs1]))
+        ISS_ALU(CPOP,   cpop(x[d->rs1]))
+        ISS_ALU(MIN,    (int32_t)x[d->rs1] < (int32_t)x[d->rs2] ? x[d->rs1] : x[d->rs2])
+        ISS_ALU(MAX,    (int32_t)x[d->rs1] < (int32_t)x[d->rs2] ? x[d->rs2] : x[d->rs1])
+        ISS_ALU(MINU,   x[d->rs1] < x[d->rs2] ? x[d->rs1] : x[d->rs2])
+        ISS_ALU(MAXU,   x[d->rs1] < x[d->rs2] ? x[d->rs2] : x[d->rs1])
+        ISS_ALU(SEXTB,  (uint32_t)(int32_t)(int8_t)x[d->rs1])
+        ISS_ALU(SEXTH,  (uint32_t)(int32_t)(int16_t)x[d->rs1])
+        ISS_ALU(ZEXTH,  x[d->rs1] & 0xFFFF)
+        ISS_ALU(REV8,   x[d->rs1] >> 24 | (x[d->rs1] >> 8 & 0xFF00) | (x[d->rs1] << 8 & 0xFF0000) | x[d->rs1] << 24)
+        ISS_ALU(ORCB,   orc_b(x[d->rs1]))
+        ISS_ALU(ROL,    rotl(x[d->rs1], x[d->rs2]))
+        ISS_ALU(ROR,    rotr(x[d->rs1], x[d->rs2]))
+        ISS_ALU(RORI,   rotr(x[d->rs1], d->imm))
+        ISS_ALU(BCLR,   x[d->rs1] & ~(1u << (x[d->rs2] & 31)))
+        ISS_ALU(BSET,   x[d->rs1] | 1u << (x[d->rs2] & 31))
+        ISS_ALU(BINV,   x[d->rs1] ^ 1u << (x[d->rs2] & 31))
+        ISS_ALU(BEXT,   x[d->rs1] >> (x[d->rs2] & 31) & 1)
+        ISS_ALU(BCLRI,  x[d->rs1] & ~(1u << (d->imm & 31)))
+        ISS_ALU(BSETI,  x[d->rs1] | 1u << (d->imm & 31))
+        ISS_ALU(BINVI,  x[d->rs1] ^ 1u << (d->imm & 31))
+        ISS_ALU(BEXTI,  x[d->rs1] >> (d->imm & 31) & 1)
+#if !RV32_ISS_THREADED
+        }
+#endif
+
+    done:
+        m_pc = pc;
+        m_instret += n;
+        return n;
+
+#undef ISS_OP
+#undef ISS_DISPATCH
+#undef ISS_SET_OP
+#undef ISS_WB
+#undef ISS_RETIRE
+#undef ISS_RETIRE_EXIT
+#undef ISS_STORE
+#undef ISS_ALU
+#undef ISS_BRANCH
+    }
+
+    std::vector<uint8_t> m_imem, m_dmem;
+    bool m_imem_le;
+    std::vector<Decoded> m_cache;
+    bool m_stale = true;
+
+    uint32_t m_x[32];
+    uint32_t m_pc = 0;
+    bool m_halted = false;
+    uint64_t m_instret = 0;
+
+    bool m_exited = false;
+    uint32_t m_exit_code = 0;
+    bool m_tohost_en = false;
+    uint32_t m_tohost = 0;
+};
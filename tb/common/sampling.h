@@ -0,0 +1,293 @@
+// Sampled simulation: most of a program runs in the ISS, and only sampling
+// units run on the RTL. The units' CPI extrapolates to a whole-program cycle
+// estimate with a 95% confidence interval.
+//
+// Two ways to choose the units:
+//   - periodic (SMARTS-style): one unit of U instructions at the end of
+//     every period of P instructions. The mean CPI of the units estimates
+//     the program's, with the spread between units as the error.
+//   - phases (SimPoint-style): the program is cut into intervals of P
+//     instructions, each profiled as a basic-block vector (BBV): how many
+//     instructions each basic block executed. The BBVs are randomly
+//     projected to PROJECTED_DIMS dimensions and clustered with k-means.
+//     A few intervals of each cluster are measured: the one nearest the
+//     centroid, plus random others. The stratified mean, with each cluster
+//     weighted by its share of the instructions, estimates the CPI.
+// Every unit starts from a cold pipeline and cold caches. W warm-up
+// instructions run on the RTL before the measurement starts, to fill them.
+//
+// This header has the model-independent parts: planning, BBVs, k-means and
+// the estimators. RV32I_Core_tb (+sample) moves the state between the ISS
+// and the core.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace sampling {
+
+static const unsigned PROJECTED_DIMS = 15;     // as SimPoint
+
+// One detailed measurement: `instructions` of the program from `start`,
+// in stratum `cluster` (0 for periodic sampling)
+struct Unit {
+    uint64_t start = 0, length = 0;
+    unsigned cluster = 0;
+    uint64_t instructions = 0, cycles = 0;     // measured on the RTL
+    double cpi() const { return instructions ? (double)cycles / instructions : 0; }
+};
+
+struct Estimate {
+    double cpi = 0, cpi_ci95 = 0;              // ci95 < 0: no error estimate
+    double cycles = 0, cycles_ci95 = 0;
+    size_t units = 0;
+};
+
+// Two-sided 95% Student t quantile
+inline double t95(size_t df) {
+    static const double table[] = {0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df == 0) return std::numeric_limits<double>::infinity();
+    if (df < sizeof(table) / sizeof(table[0])) return table[df];
+    return df < 60 ? 2.00 : df < 120 ? 1.98 : 1.96;
+}
+
+// Periodic plan: a unit of `unit` instructions ending every `period`,
+// for a program of `total` instructions
+inline std::vector<Unit> periodic_plan(uint64_t total, uint64_t period, uint64_t unit) {
+    std::vector<Unit> plan;
+    for (uint64_t end = period; end <= total; end += period) {
+        Unit u;
+        u.start = end - unit;
+        u.length = unit;
+        plan.push_back(u);
+    }
+    return plan;
+}
+
+// Basic-block vectors, randomly projected as they are collected
+class BbvProfiler {
+public:
+    explicit BbvProfiler(uint64_t interval) : m_interval(interval) { m_current.assign(PROJECTED_DIMS, 0.0); }
+
+    // A basic block starting at `pc` ran `instructions` instructions
+    void block(uint32_t pc, uint64_t instructions) {
+        uint64_t left = instructions;
+        while (left) {
+            uint64_t n = std::min(left, m_interval - m_count);
+            add(pc, n);
+            left -= n;
+            if (m_count == m_interval) end_interval();
+        }
+    }
+
+    // The partial last interval
+    void finish() {
+        if (m_count) end_interval();
+    }
+
+    const std::vector<std::vector<double>>& vectors() const { return m_vectors; }
+    const std::vector<uint64_t>& lengths() const { return m_lengths; }
+    uint64_t interval() const { return m_interval; }
+
+private:
+    // A fixed pseudo-random direction per block: each coordinate in [-1, 1]
+    static double project(uint32_t pc, unsigned dim) {
+        uint64_t h = ((uint64_t)pc << 8 | dim) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 32;
+        return (double)(h >> 11) / (double)(1ull << 53) * 2.0 - 1.0;
+    }
+
+    void add(uint32_t pc, uint64_t n) {
+        auto it = m_dirs.find(pc);
+        if (it == m_dirs.end()) {
+            std::vector<double> dir(PROJECTED_DIMS);
+            for (unsigned d = 0; d < PROJECTED_DIMS; d++) dir[d] = project(pc, d);
+            it = m_dirs.emplace(pc, std::move(dir)).first;
+        }
+        for (unsigned d = 0; d < PROJECTED_DIMS; d++) m_current[d] += it->second[d] * n;
+        m_count += n;
+    }
+
+    void end_interval() {
+        for (auto& v : m_current) v /= (double)m_count;     // a BBV is a distribution
+        m_vectors.push_back(m_current);
+        m_lengths.push_back(m_count);
+        m_current.assign(PROJECTED_DIMS, 0.0);
+        m_count = 0;
+    }
+
+    uint64_t m_interval, m_count = 0;
+    std::vector<double> m_current;
+    std::vector<std::vector<double>> m_vectors;
+    std::vector<uint64_t> m_lengths;
+    std::unordered_map<uint32_t, std::vector<double>> m_dirs;
+};
+
+inline double distance2(const std::vector<double>& a, const std::vector<double>& b) {
+    double d = 0;
+    for (size_t i = 0; i < a.size(); i++) d += (a[i] - b[i]) * (a[i] - b[i]);
+    return d;
+}
+
+// k-means with k-means++ seeding. Returns each vector's cluster; fills
+// `centroids`. Empty clusters are dropped, so there may be fewer than k.
+inline std::vector<unsigned> kmeans(const std::vector<std::vector<double>>& vecs, unsigned k, uint64_t seed,
+                                    std::vector<std::vector<double>>& centroids) {
+    std::mt19937_64 rng(seed);
+    size_t n = vecs.size();
+    k = (unsigned)std::min<size_t>(k, n);
+    centroids.clear();
+    if (!n || !k) return {};
+
+    centroids.push_back(vecs[rng() % n]);
+    std::vector<double> d2(n);
+    while (centroids.size() < k) {
+        double sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            d2[i] = std::numeric_limits<double>::max();
+            for (auto& c : centroids) d2[i] = std::min(d2[i], distance2(vecs[i], c));
+            sum += d2[i];
+        }
+        if (sum == 0) break;    // fewer distinct vectors than k
+        double r = std::uniform_real_distribution<double>(0, sum)(rng);
+        size_t pick = 0;
+        for (; pick + 1 < n && r >= d2[pick]; pick++) r -= d2[pick];
+        centroids.push_back(vecs[pick]);
+    }
+
+    std::vector<unsigned> assign(n, 0);
+    for (int iter = 0; iter < 100; iter++) {
+        bool changed = false;
+        for (size_t i = 0; i < n; i++) {
+            unsigned best = 0;
+            for (unsigned c = 1; c < centroids.size(); c++)
+                if (distance2(vecs[i], centroids[c]) < distance2(vecs[i], centroids[best])) best = c;
+            changed |= best != assign[i] || iter == 0;
+            assign[i] = best;
+        }
+        if (!changed) break;
+        std::vector<std::vector<double>> sums(centroids.size(), std::vector<double>(vecs[0].size(), 0.0));
+        std::vector<size_t> counts(centroids.size(), 0);
+        for (size_t i = 0; i < n; i++) {
+            counts[assign[i]]++;
+            for (size_t d = 0; d < vecs[i].size(); d++) sums[assign[i]][d] += vecs[i][d];
+        }
+        for (size_t c = 0; c < centroids.size(); c++)
+            if (counts[c])
+                for (size_t d = 0; d < sums[c].size(); d++) centroids[c][d] = sums[c][d] / counts[c];
+    }
+
+    // Renumber the clusters that kept members
+    std::vector<int> renum(centroids.size(), -1);
+    std::vector<std::vector<double>> kept;
+    for (auto& a : assign) {
+        if (renum[a] < 0) {
+            renum[a] = (int)kept.size();
+            kept.push_back(centroids[a]);
+        }
+        a = (unsigned)renum[a];
+    }
+    centroids = kept;
+    return assign;
+}
+
+// Phase plan: cluster the intervals' BBVs into at most k phases and pick
+// up to `per_cluster` whole intervals of each to measure. `weights` gets
+// each cluster's share of the program's instructions.
+inline std::vector<Unit> phase_plan(const BbvProfiler& bbv, unsigned k, unsigned per_cluster, uint64_t seed,
+                                    std::vector<double>& weights) {
+    std::vector<std::vector<double>> centroids;
+    std::vector<unsigned> assign = kmeans(bbv.vectors(), k, seed, centroids);
+    std::mt19937_64 rng(seed + 1);
+
+    uint64_t total = 0;
+    for (auto len : bbv.lengths()) total += len;
+    weights.assign(centroids.size(), 0.0);
+
+    std::vector<Unit> plan;
+    for (unsigned c = 0; c < centroids.size(); c++) {
+        std::vector<size_t> members;
+        for (size_t i = 0; i < assign.size(); i++)
+            if (assign[i] == c) {
+                members.push_back(i);
+                weights[c] += (double)bbv.lengths()[i] / total;
+            }
+        // The representative first, then a random selection of the rest
+        auto nearest = std::min_element(members.begin(), members.end(), [&](size_t a, size_t b) {
+            return distance2(bbv.vectors()[a], centroids[c]) < distance2(bbv.vectors()[b], centroids[c]);
+        });
+        std::iter_swap(members.begin(), nearest);
+        std::shuffle(members.begin() + 1, members.end(), rng);
+        members.resize(std::min<size_t>(members.size(), std::max(1u, per_cluster)));
+
+        for (size_t i : members) {
+            Unit u;
+            u.start = i * bbv.interval();
+            u.length = bbv.lengths()[i];
+            u.cluster = c;
+            plan.push_back(u);
+        }
+    }
+    std::sort(plan.begin(), plan.end(), [](const Unit& a, const Unit& b) { return a.start < b.start; });
+    return plan;
+}
+
+// Stratified estimate of the CPI: cluster c has weight weights[c] (periodic
+// sampling is one cluster of weight 1). A cluster measured only once
+// borrows the pooled within-cluster variance. Without any cluster measured
+// twice there is no error estimate (ci95 = -1).
+inline Estimate estimate(const std::vector<Unit>& units, const std::vector<double>& weights, uint64_t total) {
+    Estimate e;
+    size_t clusters = weights.size();
+    std::vector<double> sum(clusters, 0), sum2(clusters, 0);
+    std::vector<size_t> n(clusters, 0);
+    for (auto& u : units) {
+        if (!u.instructions || u.cluster >= clusters) continue;
+        double cpi = u.cpi();
+        sum[u.cluster] += cpi;
+        sum2[u.cluster] += cpi * cpi;
+        n[u.cluster]++;
+        e.units++;
+    }
+
+    double pooled = 0, weight_seen = 0;
+    size_t pooled_df = 0;
+    for (size_t c = 0; c < clusters; c++) {
+        if (!n[c]) continue;
+        double mean = sum[c] / n[c];
+        e.cpi += weights[c] * mean;
+        weight_seen += weights[c];
+        if (n[c] > 1) {
+            pooled += sum2[c] - n[c] * mean * mean;
+            pooled_df += n[c] - 1;
+        }
+    }
+    if (weight_seen > 0) e.cpi /= weight_seen;      // clusters the run did not reach
+    e.cycles = e.cpi * total;
+
+    if (!pooled_df) {
+        e.cpi_ci95 = e.cycles_ci95 = -1;
+        return e;
+    }
+    pooled /= pooled_df;
+    double var = 0;
+    for (size_t c = 0; c < clusters; c++) {
+        if (!n[c]) continue;
+        double s2 = n[c] > 1 ? (sum2[c] - sum[c] * sum[c] / n[c]) / (n[c] - 1) : pooled;
+        var += weights[c] * weights[c] * std::max(0.0, s2) / n[c];
+    }
+    e.cpi_ci95 = t95(pooled_df) * std::sqrt(var) / weight_seen;
+    e.cycles_ci95 = e.cpi_ci95 * total;
+    return e;
+}
+
+}  // namespace sampling
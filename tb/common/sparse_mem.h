@@ -0,0 +1,162 @@
+// Backing store of DataMemSparse: a byte-addressed memory over the full
+// 32-bit space, kept as a two-level page table of 4 KiB pages. A page is
+// allocated (zeroed) on its first write; reads of untouched memory return 0
+// without allocating, so a program costs memory in proportion to what it
+// writes.
+//
+// DataMemSparse reaches it over DPI (the sparse_mem_* functions below). Its
+// MEM_ID parameter picks the instance, SparseMem::instance(id). The DPI
+// functions are defined here, so include this header from the testbench's
+// one translation unit.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "readmemh.h"
+
+class SparseMem {
+public:
+    static constexpr unsigned PAGE_BITS = 12;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static constexpr unsigned DIR_BITS  = 10;    // 2^10 directories of 2^10 pages
+
+    static SparseMem& instance(int id) {
+        static std::map<int, SparseMem> mems;
+        static int last_id = -1;
+        static SparseMem* last = nullptr;
+        if (id != last_id) {
+            last = &mems[id];
+            last_id = id;
+        }
+        return *last;
+    }
+
+    // Little-endian read/write of 1, 2 or 4 bytes; wraps at 4 GiB
+    uint32_t read(uint32_t addr, unsigned bytes = 4) const {
+        uint32_t off = addr & (PAGE_SIZE - 1);
+        const uint8_t* p = page(addr);
+        uint32_t v = 0;
+        if (off <= PAGE_SIZE - bytes) {
+            if (p) memcpy(&v, p + off, bytes);
+            return v;
+        }
+        for (unsigned i = 0; i < bytes; i++) v |= (uint32_t)read_byte(addr + i) << (8 * i);
+        return v;
+    }
+
+    void write(uint32_t addr, uint32_t data, unsigned bytes = 4) {
+        uint32_t off = addr & (PAGE_SIZE - 1);
+        if (off <= PAGE_SIZE - bytes) {
+            memcpy(alloc(addr) + off, &data, bytes);
+            return;
+        }
+        for (unsigned i = 0; i < bytes; i++) write_byte(addr + i, (uint8_t)(data >> (8 * i)));
+    }
+
+    uint8_t read_byte(uint32_t addr) const {
+        const uint8_t* p = page(addr);
+        return p ? p[addr & (PAGE_SIZE - 1)] : 0;
+    }
+
+    void write_byte(uint32_t addr, uint8_t value) { alloc(addr)[addr & (PAGE_SIZE - 1)] = value; }
+
+    // Bulk copy for program loaders
+    void write_block(uint32_t addr, const uint8_t* src, size_t len) {
+        while (len) {
+            uint32_t off = addr & (PAGE_SIZE - 1);
+            size_t n = std::min<size_t>(len, PAGE_SIZE - off);
+            memcpy(alloc(addr) + off, src, n);
+            addr += n; src += n; len -= n;
+        }
+    }
+
+    void fill(uint32_t addr, uint8_t value, size_t len) {
+        while (len) {
+            uint32_t off = addr & (PAGE_SIZE - 1);
+            size_t n = std::min<size_t>(len, PAGE_SIZE - off);
+            memset(alloc(addr) + off, value, n);
+            addr += n; len -= n;
+        }
+    }
+
+    bool load(const std::string& path) {
+        return readmemh(path, [this](size_t addr, uint8_t v) { write_byte((uint32_t)addr, v); });
+    }
+
+    void clear() {
+        for (auto& dir : m_dirs) dir.reset();
+        m_pages = 0;
+        m_last_tag = ~0u;
+        m_last_page = nullptr;
+    }
+
+    size_t pages() const { return m_pages; }
+    size_t footprint() const { return m_pages * PAGE_SIZE; }
+
+    // f(base address, PAGE_SIZE bytes) for every allocated page
+    template <class F>
+    void for_each_page(F&& f) const {
+        for (size_t d = 0; d < m_dirs.size(); d++) {
+            if (!m_dirs[d]) continue;
+            for (size_t p = 0; p < m_dirs[d]->size(); p++)
+                if ((*m_dirs[d])[p])
+                    f((uint32_t)(((d << DIR_BITS) | p) << PAGE_BITS), (*m_dirs[d])[p].get());
+        }
+    }
+
+private:
+    using Page = std::unique_ptr<uint8_t[]>;
+    using Dir  = std::array<Page, 1u << DIR_BITS>;
+
+    const uint8_t* page(uint32_t addr) const {
+        uint32_t tag = addr >> PAGE_BITS;
+        if (tag == m_last_tag) return m_last_page;
+        const auto& dir = m_dirs[addr >> (PAGE_BITS + DIR_BITS)];
+        uint8_t* p = dir ? (*dir)[tag & ((1u << DIR_BITS) - 1)].get() : nullptr;
+        if (p) {
+            m_last_tag = tag;
+            m_last_page = p;
+        }
+        return p;
+    }
+
+    uint8_t* alloc(uint32_t addr) {
+        if (const uint8_t* p = page(addr)) return const_cast<uint8_t*>(p);
+        auto& dir = m_dirs[addr >> (PAGE_BITS + DIR_BITS)];
+        if (!dir) dir.reset(new Dir());
+        Page& pg = (*dir)[(addr >> PAGE_BITS) & ((1u << DIR_BITS) - 1)];
+        pg.reset(new uint8_t[PAGE_SIZE]());
+        m_pages++;
+        return pg.get();
+    }
+
+    std::array<std::unique_ptr<Dir>, 1u << (32 - PAGE_BITS - DIR_BITS)> m_dirs;
+    size_t m_pages = 0;
+
+    // Last page touched: most accesses stay on one page
+    mutable uint32_t m_last_tag = ~0u;
+    mutable uint8_t* m_last_page = nullptr;
+};
+
+// DPI imports of DataMemSparse. `version` only orders the read after
+// writes in the Verilated schedule; it is not used here.
+extern "C" int sparse_mem_read(int id, int addr, int version) {
+    (void)version;
+    return (int)SparseMem::instance(id).read((uint32_t)addr);
+}
+
+extern "C" void sparse_mem_write(int id, int addr, int data, int bytes) {
+    SparseMem::instance(id).write((uint32_t)addr, (uint32_t)data, (unsigned)bytes);
+}
+
+extern "C" void sparse_mem_load(int id, const char* path) {
+    if (!SparseMem::instance(id).load(path))
+        printf("❌ DataMemSparse %d: cannot read %s\n", id, path);
+}
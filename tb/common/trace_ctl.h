@@ -0,0 +1,259 @@
+// Runtime waveform control for the Verilator testbenches.
+//
+// With no plusargs every cycle is dumped, same as before. Otherwise:
+//   +trace+start_pc+<addr>    start dumping when the PC matches (0x.. for hex)
+//   +trace+stop_pc+<addr>     stop dumping when the PC matches
+//   +trace+start_cycle+<n>    start dumping at cycle n
+//   +trace+stop_cycle+<n>     stop dumping at cycle n
+//   +trace+illegal            start dumping when illegal_op is raised
+//   +trace+assert             start dumping when a check fails (fail()) or
+//                             an assert() fires; the failing cycle is dumped
+//   +trace+stop_assert        stop dumping there
+//   +trace+scope+<a,b,...>    only dump these scopes (e.g. u_alu,u_regFile)
+//   +trace+ring+<n>           flight recorder: keep the last ~n cycles in
+//                             memory, write them to disk only if a check fails
+//
+// An assert() aborts the testbench; the trace is closed on the way out, so
+// the dump up to the failure is complete.
+//
+// FST output is a build option: ./Verilatte.sh {DUT} fst
+#pragma once
+
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <verilated.h>
+
+#if VM_TRACE && defined(VM_TRACE_FST) && VM_TRACE_FST
+#include <verilated_fst_c.h>
+typedef VerilatedFstC TraceFile;
+#define TRACE_EXT ".fst"
+#define TRACE_RING 0
+#elif VM_TRACE
+#include <verilated_vcd_c.h>
+typedef VerilatedVcdC TraceFile;
+#define TRACE_EXT ".vcd"
+#define TRACE_RING 1
+
+// VCD sink that keeps the last few segments in memory instead of on disk.
+// Each segment after the first starts with a full dump (openNext), so with
+// the saved header every segment is a self-contained VCD.
+class RingVcdFile : public VerilatedVcdFile {
+public:
+    explicit RingVcdFile(size_t keep) : m_keep(keep) {}
+
+    bool open(const std::string&) override {
+        if (m_header.empty() && !m_segments.empty()) {
+            const char* marker = "$enddefinitions $end\n";
+            size_t pos = m_segments.back().find(marker);
+            if (pos != std::string::npos)
+                m_header = m_segments.back().substr(0, pos + strlen(marker));
+        }
+        m_segments.emplace_back();
+        if (m_segments.size() > m_keep) {
+            m_segments.pop_front();
+            m_dropped++;
+        }
+        return true;
+    }
+    void close() override {}
+    ssize_t write(const char* bufp, ssize_t len) override {
+        m_segments.back().append(bufp, len);
+        return len;
+    }
+
+    // Write every retained segment to <base>_ring<N>.vcd
+    void flush(const std::string& base) const {
+        for (size_t i = 0; i < m_segments.size(); i++) {
+            std::string name = base + "_ring" + std::to_string(i) + ".vcd";
+            FILE* fp = fopen(name.c_str(), "w");
+            if (!fp) continue;
+            if (m_dropped + i > 0) fwrite(m_header.data(), 1, m_header.size(), fp);
+            fwrite(m_segments[i].data(), 1, m_segments[i].size(), fp);
+            fclose(fp);
+            printf("💾 Flight recorder segment written to %s\n", name.c_str());
+        }
+    }
+
+private:
+    size_t m_keep;
+    size_t m_dropped = 0;
+    std::string m_header;
+    std::deque<std::string> m_segments;
+};
+#else
+#define TRACE_RING 0
+#endif
+
+class TraceCtl {
+public:
+    ~TraceCtl() { close(); }
+
+    // Parse the plusargs, attach the model and open <base>.vcd / <base>.fst.
+    // Call after Verilated::commandArgs(). `top` is the top module name,
+    // used to expand bare scope names.
+    template <class Model>
+    void open(Model* dut, const std::string& top, const std::string& base) {
+        m_start_pc_set = plusarg_u64("trace+start_pc+", m_start_pc);
+        m_stop_pc_set = plusarg_u64("trace+stop_pc+", m_stop_pc);
+        plusarg_u64("trace+start_cycle+", m_start_cycle);
+        plusarg_u64("trace+stop_cycle+", m_stop_cycle);
+        plusarg_u64("trace+ring+", m_ring_cycles);
+        m_on_illegal = Verilated::commandArgsPlusMatch("trace+illegal")[0] != '\0';
+        m_start_assert = Verilated::commandArgsPlusMatch("trace+assert")[0] != '\0';
+        m_stop_assert = Verilated::commandArgsPlusMatch("trace+stop_assert")[0] != '\0';
+        const char* scopes = Verilated::commandArgsPlusMatch("trace+scope+");
+        if (scopes[0]) m_scopes = scopes + strlen("+trace+scope+");
+
+        m_active = !(m_start_pc_set || m_on_illegal || m_start_assert || m_start_cycle > 0);
+#if VM_TRACE
+        m_base = base;
+        Verilated::traceEverOn(true);
+        instance() = this;
+        std::signal(SIGABRT, on_abort);
+#if TRACE_RING
+        if (m_ring_cycles) {
+            m_ring = new RingVcdFile(3);
+            m_tfp = new TraceFile(m_ring);
+        }
+#else
+        if (m_ring_cycles)
+            printf("⚠️  +trace+ring is VCD only; tracing to %s%s\n", base.c_str(), TRACE_EXT);
+        m_ring_cycles = 0;
+#endif
+        if (!m_tfp) m_tfp = new TraceFile;
+
+        std::stringstream ss(m_scopes);
+        std::string scope;
+        while (std::getline(ss, scope, ','))
+            if (!scope.empty())
+                m_tfp->dumpvars(99, scope.find('.') == std::string::npos ? top + "." + scope : scope);
+
+        dut->trace(m_tfp, 5);
+        m_tfp->open((base + TRACE_EXT).c_str());
+#else
+        (void)dut; (void)top; (void)base;
+#endif
+    }
+
+    // Evaluate triggers once per cycle, before that cycle's dumps.
+    void sample(uint64_t cycle, uint32_t pc, bool illegal_op) {
+        if (!m_active && !m_stopped) {
+            if ((m_start_pc_set && pc == m_start_pc) || (m_on_illegal && illegal_op) ||
+                (m_start_cycle > 0 && cycle >= m_start_cycle))
+                m_active = true;
+        }
+        if (m_active && ((m_stop_pc_set && pc == m_stop_pc) || cycle >= m_stop_cycle)) {
+            m_active = false;
+            m_stopped = true;
+        }
+#if TRACE_RING
+        // Roll the flight recorder over every half window; three segments
+        // are kept, so at least the last m_ring_cycles cycles survive.
+        if (m_active && m_ring_cycles && ++m_seg_cycles >= (m_ring_cycles + 1) / 2) {
+            m_tfp->openNext(true);
+            m_seg_cycles = 0;
+        }
+#endif
+    }
+
+    void dump(uint64_t time) {
+#if VM_TRACE
+        m_last_time = time;
+        if (m_active && m_tfp) m_tfp->dump(time);
+#else
+        (void)time;
+#endif
+    }
+
+    // A check failed: apply +trace+assert / +trace+stop_assert and write
+    // out the flight recorder, if any.
+    void fail() {
+        if (m_start_assert && !m_active && !m_stopped) {
+            m_active = true;
+#if VM_TRACE
+            // The model still holds the failing cycle's values
+            if (m_tfp) m_tfp->dump(m_last_time);
+#endif
+        }
+        if (m_stop_assert && m_active) {
+            m_active = false;
+            m_stopped = true;
+        }
+#if TRACE_RING
+        if (m_ring && !m_flushed) {
+            m_flushed = true;
+            m_ring->flush(m_base);
+        }
+#endif
+    }
+
+    void close() {
+#if VM_TRACE
+        if (m_tfp) {
+            m_tfp->close();
+            delete m_tfp;
+            m_tfp = nullptr;
+        }
+#endif
+#if VM_TRACE
+        if (instance() == this) instance() = nullptr;
+#endif
+#if TRACE_RING
+        delete m_ring;
+        m_ring = nullptr;
+#endif
+    }
+
+    bool active() const { return m_active; }
+
+private:
+    static bool plusarg_u64(const char* name, uint64_t& value) {
+        const char* arg = Verilated::commandArgsPlusMatch(name);
+        if (!arg[0]) return false;
+        value = strtoull(arg + strlen(name) + 1, nullptr, 0);
+        return true;
+    }
+
+    uint64_t m_start_pc = 0, m_stop_pc = 0;
+    bool m_start_pc_set = false, m_stop_pc_set = false;
+    uint64_t m_start_cycle = 0, m_stop_cycle = UINT64_MAX;
+    bool m_on_illegal = false;
+    bool m_start_assert = false, m_stop_assert = false;
+    uint64_t m_ring_cycles = 0;
+    std::string m_scopes;
+
+    bool m_active = true;
+    bool m_stopped = false;
+
+#if VM_TRACE
+    std::string m_base;
+    TraceFile* m_tfp = nullptr;
+    uint64_t m_seg_cycles = 0;
+    uint64_t m_last_time = 0;
+
+    // assert() aborts the testbench: treat it as a failed check, then close
+    // the trace so its buffered tail reaches the file
+    static TraceCtl*& instance() {
+        static TraceCtl* s_instance = nullptr;
+        return s_instance;
+    }
+    static void on_abort(int sig) {
+        if (TraceCtl* t = instance()) {
+            t->fail();
+            t->close();
+        }
+        std::signal(sig, SIG_DFL);
+        std::raise(sig);
+    }
+#endif
+#if TRACE_RING
+    RingVcdFile* m_ring = nullptr;
+    bool m_flushed = false;
+#endif
+};
@@ -0,0 +1,29 @@
+// Commit log -> Spike --log-commits text (see tb/common/commit_log.h)
+//   commitlog2spike <log[.gz]> [out.txt]     (default: stdout)
+// Built and run by ./CommitLog.sh.
+#include <cstdio>
+#include "../common/commit_log.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <commit log> [out.txt]\n", argv[0]);
+        return 1;
+    }
+    CommitLogReader log;
+    if (!log.open(argv[1])) {
+        fprintf(stderr, "❌ %s is not a commit log\n", argv[1]);
+        return 1;
+    }
+    FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "❌ Cannot write %s\n", argv[2]);
+        return 1;
+    }
+    static char buf[1 << 20];
+    setvbuf(out, buf, _IOFBF, sizeof(buf));
+
+    CommitRecord r;
+    while (log.next(r)) CommitLogReader::print_spike(out, r);
+    if (out != stdout) fclose(out);
+    return 0;
+}
@@ -16,3 +16,6 @@
 --x-initial unique
 
 --timing
+
+// zlib for the gzip commit log (tb/common/commit_log.h)
+-LDFLAGS -lz
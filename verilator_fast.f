@@ -0,0 +1,19 @@
+// Strict warnings
+-Wall
+// Don't exit on warnings
+-Wno-fatal
+// Multithreading
+-j 0
+// Compile C exe
+-cc --exe
+
+// High-throughput profile: no --trace, no --timing scheduler.
+// Thread count (--threads N) is passed by Verilatte.sh.
+-O3
+
+// Xs become fixed constants; no per-run randomisation
+--x-assign fast
+--x-initial fast
+
+// zlib for the gzip commit log (tb/common/commit_log.h)
+-LDFLAGS -lz